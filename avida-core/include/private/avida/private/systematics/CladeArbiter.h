@@ -92,6 +92,7 @@ namespace Avida {
       void UpdateProvidedValues(Update current_update);
       Data::PackagePtr GetProvidedValue(const Data::DataID& data_id) const;
       Apto::String DescribeProvidedValue(const Data::DataID& data_id) const;
+      bool IsThreadSafe() const;
 
     private:
       // Methods called by Clade
@@ -28,6 +28,8 @@
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Unit.h"
 
+#include "avida/private/systematics/HistoricGenotypeStore.h"
+
 #include "apto/stat/Accumulator.h"
 
 #include "cCountTracker.h"
@@ -103,6 +105,13 @@ namespace Avida {
       
       mutable PropertyMap* m_prop_map;
       
+      // Packed record of a compacted historic genotype, held in memory or spilled to the arbiter's historic store
+      bool m_compact;
+      int m_record_delta_depth;
+      int m_record_length;
+      long long m_record_offset;
+      HistoricGenotypeStore::Record m_record;
+      
       
     public:
       ~Genotype();
@@ -147,7 +156,7 @@ namespace Avida {
       void NotifyNewUnit(UnitPtr u);
       void UpdateReset();
 
-      inline const Genome& GroupGenome() const { return m_genome; }
+      const Genome& GroupGenome() const;
       inline const Apto::Array<GenotypePtr> Parents() const { return m_parents; }
       
       inline void SetName(const Apto::String& name) { m_name = name; }
@@ -162,8 +171,19 @@ namespace Avida {
       
       inline void Deactivate(int update) { m_active = false; m_update_deactivated = update; }
       inline void Reactivate() { m_active = true; m_update_deactivated = -1; }
+      
+      inline bool IsCompact() const { return m_compact; }
+      int HistoricFootprint() const;
+      void Compact(HistoricGenotypeStore* store);
+      void Expand();
             
     private:
+      void expandRecord();  // caller holds the arbiter's historic mutex
+      bool readRecord(HistoricGenotypeStore::Record& record) const;
+      void releaseRecord();
+      bool historicSequence(InstructionSequence& seq) const;
+      bool unpackRecord(Genome& genome, Apto::String& name, Apto::String& src_args) const;
+      
       void setupPropertyMap() const;
       inline GenotypePtr thisPtr();
     };
@@ -30,6 +30,7 @@
 #include "avida/systematics/Arbiter.h"
 
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/HistoricGenotypeStore.h"
 
 
 namespace Avida {
@@ -53,11 +54,15 @@ namespace Avida {
       // Config Settings
       int m_threshold;
       bool m_disable_class;
+      int m_historic_memory;
       
       // Internal Data Structures
       Apto::List<GenotypePtr, Apto::SparseVector> m_active_hash[HASH_SIZE];
       Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_sz;
       Apto::List<GenotypePtr, Apto::SparseVector> m_historic;
+      HistoricGenotypeStore* m_historic_store;
+      mutable Apto::Mutex m_historic_mutex;  // Guards compacting, expanding and reading back historic genotypes
+      int m_historic_reexpanded;             // Compacted genotypes expanded since the last compaction pass
       GenotypePtr m_coalescent;
       int m_best;
       int m_next_id;
@@ -118,7 +123,8 @@ namespace Avida {
       
       
     public:
-      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false);
+      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false, int historic_memory = 0,
+                      const Apto::String& historic_store_path = "");
       ~GenotypeArbiter();
       
       // Arbiter Interface Methods
@@ -162,6 +168,8 @@ namespace Avida {
       
       void removeGenotype(GenotypePtr genotype);
       void updateCoalescent();
+      void compactHistoric();
+      inline bool compactsHistoric() const { return m_historic_memory > 0; }
       
       inline void resizeActiveList(int size);
       inline GenotypePtr getBest();
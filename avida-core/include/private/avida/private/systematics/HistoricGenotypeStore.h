@@ -0,0 +1,84 @@
+/*
+ *  private/systematics/HistoricGenotypeStore.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaSystematicsHistoricGenotypeStore_h
+#define AvidaSystematicsHistoricGenotypeStore_h
+
+#include "apto/platform.h"
+#include "apto/core.h"
+
+#include <cstdio>
+
+
+namespace Avida {
+  namespace Systematics {
+    
+    // HistoricGenotypeStore - spill file for compacted historic genotype records
+    // --------------------------------------------------------------------------------------------------------------
+    
+    class HistoricGenotypeStore
+    {
+    public:
+      typedef Apto::Array<unsigned char> Record;
+      
+    private:
+      struct Extent
+      {
+        long long offset;
+        long long length;
+      };
+      
+      Apto::String m_path;
+      FILE* m_file;
+      long long m_size;
+      long long m_live_bytes;
+      int m_live_records;
+      Apto::Array<Extent> m_free;  // Released space, sorted by offset and coalesced
+      
+    public:
+      LIB_LOCAL explicit HistoricGenotypeStore(const Apto::String& path);
+      LIB_LOCAL ~HistoricGenotypeStore();
+      
+      LIB_LOCAL inline bool IsOpen() const { return (m_file != NULL); }
+      
+      // Returns the offset of the stored record, or -1 if it could not be written. Released space is reused first.
+      LIB_LOCAL long long Append(const Record& record);
+      LIB_LOCAL bool Read(long long offset, Record& record) const;
+      
+      LIB_LOCAL void Release(long long offset, int length);
+      
+      LIB_LOCAL inline long long GetFileSize() const { return m_size; }
+      LIB_LOCAL inline long long GetFreeBytes() const { return m_size - m_live_bytes; }
+      LIB_LOCAL inline long long GetLiveBytes() const { return m_live_bytes; }
+      LIB_LOCAL inline int GetNumLiveRecords() const { return m_live_records; }
+      
+    private:
+      HistoricGenotypeStore(); // @not_implemented
+      HistoricGenotypeStore(const HistoricGenotypeStore&); // @not_implemented
+      HistoricGenotypeStore& operator=(const HistoricGenotypeStore&); // @not_implemented
+      
+      void freeExtent(long long offset, long long length);
+    };
+    
+  };
+};
+
+#endif
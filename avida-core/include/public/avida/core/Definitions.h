@@ -166,7 +166,8 @@ enum eDEME_TRIGGERS {
 
 enum eSELECTION_TYPE {
   SELECTION_TYPE_PROPORTIONAL = 0,
-  SELECTION_TYPE_TOURNAMENT
+  SELECTION_TYPE_TOURNAMENT,
+  SELECTION_TYPE_UNIVERSAL
 };
 
 enum eMP_SCHEDULING {
@@ -114,17 +114,22 @@ namespace Avida {
       LIB_LOCAL InstSetPropertyMap();
       LIB_LOCAL ~InstSetPropertyMap();
       
+      using PropertyMap::SetValue;
+      
       LIB_LOCAL int GetSize() const;
       
       LIB_LOCAL bool operator==(const PropertyMap& p) const;
       
       LIB_LOCAL bool Has(const PropertyID& p_id) const;
+      LIB_LOCAL bool Has(const PropertyKey& p_key) const;
       
       LIB_LOCAL const Property& Get(const PropertyID& p_id) const;
+      LIB_LOCAL const Property& Get(const PropertyKey& p_key) const;
       
       LIB_LOCAL bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
       LIB_LOCAL bool SetValue(const PropertyID& p_id, const int prop_value);
       LIB_LOCAL bool SetValue(const PropertyID& p_id, const double prop_value);
+      LIB_LOCAL bool SetValue(const PropertyKey& p_key, const Apto::String& prop_value);
       
       
       LIB_LOCAL void Define(PropertyPtr p);
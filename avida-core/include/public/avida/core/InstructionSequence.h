@@ -68,13 +68,25 @@ namespace Avida {
   class InstructionSequence : public GeneticRepresentation
   {
   protected:
-    Apto::Array<Instruction> m_seq;
+    // SiteBuffer - reference counted site storage, shared by copies of a sequence until one of them is modified
+    class SiteBuffer : public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+    public:
+      Apto::Array<Instruction> sites;
+      
+      LIB_EXPORT inline SiteBuffer() { ; }
+      LIB_EXPORT inline explicit SiteBuffer(int size) : sites(size) { ; }
+      LIB_EXPORT inline SiteBuffer(const SiteBuffer& buf) : Apto::RefCountObject<Apto::ThreadSafe>(buf), sites(buf.sites) { ; }
+    };
+    typedef Apto::SmartPtr<SiteBuffer, Apto::InternalRCObject> SiteBufferPtr;
+    
+    SiteBufferPtr m_buf;
     int m_active_size;
     
   public:
-    LIB_EXPORT inline InstructionSequence() : m_active_size(0) { ; }
+    LIB_EXPORT inline InstructionSequence() : m_buf(new SiteBuffer), m_active_size(0) { ; }
     LIB_EXPORT InstructionSequence(const InstructionSequence& seq);
-    LIB_EXPORT inline explicit InstructionSequence(int size) : m_seq(size), m_active_size(size) { ; }
+    LIB_EXPORT inline explicit InstructionSequence(int size) : m_buf(new SiteBuffer(size)), m_active_size(size) { ; }
     LIB_EXPORT explicit InstructionSequence(const Apto::String& str);
     LIB_EXPORT virtual ~InstructionSequence();
     
@@ -82,8 +94,10 @@ namespace Avida {
     // Accessors
     LIB_EXPORT inline int GetSize() const { return m_active_size; }
     
-    LIB_EXPORT inline Instruction& operator[](int idx) { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
-    LIB_EXPORT inline const Instruction& operator[](int idx) const { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
+    // Note: the non-const accessor gives this sequence its own copy of any shared sites.  References it returns
+    //       must not be held across a copy of the sequence, as the copy will share the same storage again.
+    LIB_EXPORT inline Instruction& operator[](int idx) { assert(idx >= 0 && idx < m_active_size);  return sites()[idx]; }
+    LIB_EXPORT inline const Instruction& operator[](int idx) const { assert(idx >= 0 && idx < m_active_size);  return m_buf->sites[idx]; }
 
 
     // GeneticRepresentation Interface
@@ -135,10 +149,21 @@ namespace Avida {
     static int FindHammingDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int offset = 0);
     static int FindBestOffset(const InstructionSequence& seq1, const InstructionSequence& seq2);
     static int FindSlidingDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
-    static int FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
+    // A non-negative max_dist lets the edit distance stop early, reporting max_dist + 1 for anything beyond it
+    static int FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist = -1);
+    
+    // One against many; distances is resized to match others
+    static void FindHammingDistances(const InstructionSequence& seq, const Apto::Array<const InstructionSequence*>& others,
+                                     Apto::Array<int>& distances);
+    static void FindEditDistances(const InstructionSequence& seq, const Apto::Array<const InstructionSequence*>& others,
+                                  Apto::Array<int>& distances, int max_dist = -1);
     
     
   protected:
+    LIB_EXPORT inline const Apto::Array<Instruction>& sites() const { return m_buf->sites; }
+    LIB_EXPORT inline Apto::Array<Instruction>& sites() { if (m_buf->RefCount() != 1) detachSites(); return m_buf->sites; }
+    LIB_EXPORT void detachSites();
+    
     LIB_EXPORT virtual void adjustCapacity(int new_size);
     LIB_EXPORT virtual void prepareInsert(int pos, int num_sites);
   };
@@ -34,6 +34,27 @@
 
 namespace Avida {
   
+  // PropertyKey
+  // --------------------------------------------------------------------------------------------------------------  
+  
+  class PropertyKey
+  {
+  private:
+    int m_slot;
+    Apto::BasicString<Apto::ThreadSafe> m_id;
+    
+  public:
+    LIB_EXPORT inline explicit PropertyKey(const PropertyID& p_id) : m_slot(Intern(p_id)), m_id((const char*)p_id) { ; }
+    
+    LIB_EXPORT inline int Slot() const { return m_slot; }
+    LIB_EXPORT inline const Apto::BasicString<Apto::ThreadSafe>& ID() const { return m_id; }
+    
+    // Interned slots are small, dense and never reused, so maps with a fixed schema can index them directly
+    LIB_EXPORT static int Intern(const PropertyID& p_id);
+    LIB_EXPORT static int Lookup(const PropertyID& p_id); // -1 if the ID has never been interned
+  };
+  
+  
   // Property
   // --------------------------------------------------------------------------------------------------------------  
   
@@ -319,13 +340,19 @@ namespace Avida {
     LIB_EXPORT inline bool operator!=(const PropertyMap& p) const { return !operator==(p); }
     
     LIB_EXPORT virtual bool Has(const PropertyID& p_id) const = 0;
+    LIB_EXPORT virtual bool Has(const PropertyKey& p_key) const;
     
     LIB_EXPORT virtual const Property& Get(const PropertyID& p_id) const = 0;
+    LIB_EXPORT virtual const Property& Get(const PropertyKey& p_key) const;
     LIB_EXPORT inline const Property& operator[](const PropertyID& p_id) const { return Get(p_id); }
+    LIB_EXPORT inline const Property& operator[](const PropertyKey& p_key) const { return Get(p_key); }
     
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const Apto::String& prop_value) = 0;
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const int prop_value) = 0;
     LIB_EXPORT virtual bool SetValue(const PropertyID& p_id, const double prop_value) = 0;
+    LIB_EXPORT virtual bool SetValue(const PropertyKey& p_key, const Apto::String& prop_value);
+    LIB_EXPORT virtual bool SetValue(const PropertyKey& p_key, const int prop_value);
+    LIB_EXPORT virtual bool SetValue(const PropertyKey& p_key, const double prop_value);
     
     
     LIB_EXPORT virtual void Define(PropertyPtr p) = 0;
@@ -357,6 +384,10 @@ namespace Avida {
     LIB_EXPORT inline HashPropertyMap() { ; }
     LIB_EXPORT ~HashPropertyMap();
     
+    using PropertyMap::Has;
+    using PropertyMap::Get;
+    using PropertyMap::SetValue;
+    
     LIB_EXPORT int GetSize() const;
     
     LIB_EXPORT bool operator==(const PropertyMap& p) const;
@@ -378,6 +409,56 @@ namespace Avida {
     LIB_EXPORT bool Serialize(ArchivePtr ar) const;    
   };
 
+  
+  // SlotPropertyMap
+  // --------------------------------------------------------------------------------------------------------------
+  
+  class SlotPropertyMap : public PropertyMap
+  {
+    template <class K, class V> class IDIndexStorage
+    : public Apto::HashStaticTableLinkedList<K, V, 31, Apto::HashKey, SmallObjectMalloc> { ; };
+    
+  private:
+    Apto::Array<int> m_keys;          // PropertyKey slots of the defined properties, ascending
+    Apto::Array<PropertyPtr> m_props; // parallel to m_keys
+    Apto::Map<PropertyID, int, IDIndexStorage> m_id_slots; // slot of each defined property, for lookups by string ID
+    
+  public:
+    LIB_EXPORT inline SlotPropertyMap() { ; }
+    LIB_EXPORT ~SlotPropertyMap();
+    
+    LIB_EXPORT int GetSize() const;
+    
+    LIB_EXPORT bool operator==(const PropertyMap& p) const;
+    
+    LIB_EXPORT bool Has(const PropertyID& p_id) const;
+    LIB_EXPORT bool Has(const PropertyKey& p_key) const;
+    
+    LIB_EXPORT const Property& Get(const PropertyID& p_id) const;
+    LIB_EXPORT const Property& Get(const PropertyKey& p_key) const;
+    
+    LIB_EXPORT bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
+    LIB_EXPORT bool SetValue(const PropertyID& p_id, const int prop_value);
+    LIB_EXPORT bool SetValue(const PropertyID& p_id, const double prop_value);
+    LIB_EXPORT bool SetValue(const PropertyKey& p_key, const Apto::String& prop_value);
+    LIB_EXPORT bool SetValue(const PropertyKey& p_key, const int prop_value);
+    LIB_EXPORT bool SetValue(const PropertyKey& p_key, const double prop_value);
+    
+    
+    LIB_EXPORT void Define(PropertyPtr p);
+    LIB_EXPORT void Define(const PropertyKey& p_key, PropertyPtr p);
+    LIB_EXPORT bool Remove(const PropertyID& p_id);
+    
+    LIB_EXPORT ConstPropertyIDSetPtr PropertyIDs() const;
+    
+    LIB_EXPORT bool Serialize(ArchivePtr ar) const;
+    
+  private:
+    LIB_LOCAL int findSlot(int slot_id) const; // index into m_props, -1 if not defined
+    LIB_LOCAL int findID(const PropertyID& p_id) const;
+    LIB_LOCAL void define(int slot_id, PropertyPtr p);
+  };
+
 };
 
 #endif
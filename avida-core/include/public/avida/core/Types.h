@@ -44,6 +44,7 @@ namespace Avida {
   class Instruction;
   class InstructionSequence;
   class Property;
+  class PropertyKey;
   class PropertyMap;
   template <typename T> struct PropertyTraits;
   template <typename T> class ReferenceProperty;
@@ -31,6 +31,21 @@
 
 namespace Avida {
   
+  // WorldUpdateObserver
+  // --------------------------------------------------------------------------------------------------------------
+  //
+  // Optional callbacks issued around each facet's PerformUpdate, allowing drivers to time individual facets.
+  
+  class WorldUpdateObserver
+  {
+  public:
+    LIB_EXPORT virtual ~WorldUpdateObserver() { ; }
+    
+    LIB_EXPORT virtual void FacetUpdateStarting(WorldFacetPtr facet) = 0;
+    LIB_EXPORT virtual void FacetUpdateFinished(WorldFacetPtr facet) = 0;
+  };
+  
+  
   // World
   // --------------------------------------------------------------------------------------------------------------
   //
@@ -68,7 +83,7 @@ namespace Avida {
     LIB_EXPORT inline WorldFacetPtr Systematics() const { return m_systematics; }
     
     // Actions
-    LIB_EXPORT void PerformUpdate(Context& ctx, Update current_update);
+    LIB_EXPORT void PerformUpdate(Context& ctx, Update current_update, WorldUpdateObserver* observer = NULL);
     
     LIB_EXPORT bool Serialize(ArchivePtr ar) const;
   };
@@ -32,6 +32,8 @@
 
 
 namespace Avida {
+  namespace Util { class ThreadPool; };
+  
   namespace Data {
     
     // Data::Manager - Manages available and active data providers for a given world
@@ -63,11 +65,17 @@ namespace Avida {
       
       mutable Apto::Mutex m_current_value_mutex;
       mutable Apto::Map<DataID, PackagePtr> m_current_values;
+      mutable Apto::Mutex m_provider_mutex;  // Serializes value retrieval from providers that are not thread safe
+      
+      Util::ThreadPool* m_update_pool;  // NULL when updates are performed serially
+      
+      class ProviderUpdateJob;
+      class RecorderNotifyJob;
       
       static bool s_registered_with_facet_factory;
       
     public:
-      LIB_EXPORT Manager();
+      LIB_EXPORT Manager(int num_update_threads = 1);
       LIB_EXPORT ~Manager();
       
       LIB_EXPORT ConstDataSetPtr GetAvailable() const;
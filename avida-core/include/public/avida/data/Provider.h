@@ -48,6 +48,10 @@ namespace Avida {
       LIB_EXPORT virtual Apto::String DescribeProvidedValue(const DataID& data_id) const = 0;
       
       LIB_EXPORT virtual bool SupportsConcurrentUpdate() const;
+      
+      // True when UpdateProvidedValues and GetProvidedValue touch nothing but the provider's own state, so that the
+      // data manager may run them alongside other providers and call GetProvidedValue from several threads at once
+      LIB_EXPORT virtual bool IsThreadSafe() const;
     };
     
     
@@ -44,6 +44,9 @@ namespace Avida {
       LIB_EXPORT virtual ConstDataSetPtr RequestedData() const = 0;
       
       LIB_EXPORT virtual void NotifyData(Update current_update, DataRetrievalFunctor retrieve_data) = 0; 
+      
+      // Recorders that return true may be notified concurrently with other such recorders
+      LIB_EXPORT virtual bool SupportsConcurrentNotify() const;
     };
     
   };
@@ -0,0 +1,218 @@
+/*
+ *  output/Columnar.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputColumnar_h
+#define AvidaOutputColumnar_h
+
+#include "apto/platform.h"
+#include "avida/output/Types.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Columnar data files
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Binary alternative to the whitespace separated text data files.  Rows are grouped into blocks of up to
+    // COLUMNAR_BLOCK_ROWS rows; within a block each column is stored contiguously and compressed according to its
+    // type (zigzag delta varints for integers, XOR with the previous value for doubles).  The file is a sequence of
+    // tagged records:
+    //
+    //   magic "AVDCOL01"
+    //   HEAD  - file type, format string, header comment text and the column definitions
+    //   BLCK  - one block of rows, with its first and last update
+    //   INDX  - block offsets and update ranges
+    //   TAIL  - offset of the preceding INDX record
+    //
+    // Each record is a four character tag and a payload length followed by the payload.  Flushing writes the
+    // buffered rows as a BLCK record; the single INDX/TAIL pair is written when the file is closed.  A file that was
+    // not closed cleanly can still be read; without a trailing TAIL the reader falls back to scanning the records.
+    // Files whose path ends in COLUMNAR_FILE_EXTENSION are written in this format.  Only column oriented output
+    // (Write/WriteAnonymous/Endl) can be stored this way; block and raw writes to a columnar file are rejected with
+    // an error.
+
+    const char* const COLUMNAR_FILE_EXTENSION = ".cdat";
+    const int COLUMNAR_BLOCK_ROWS = 4096;
+
+    enum ColumnType {
+      COLUMN_INT = 1,
+      COLUMN_DOUBLE = 2,
+      COLUMN_STRING = 3
+    };
+
+
+    // Output::ColumnarEncoder - Accumulates rows and writes encoded records to an output stream
+    // --------------------------------------------------------------------------------------------------------------
+
+    class ColumnarEncoder
+    {
+    private:
+      struct Column;
+      struct BlockIndex
+      {
+        long long offset;
+        long long first_row;
+        long long first_update;
+        long long last_update;
+      };
+
+      std::ostream& m_out;
+      long long m_offset;
+
+      Apto::Array<Column*> m_columns;
+      int m_update_col;
+      bool m_columns_fixed;
+      int m_cur_col;
+      int m_block_rows;
+      long long m_total_rows;
+
+      Apto::String m_filetype;
+      Apto::String m_format;
+      Apto::String m_comments;
+      bool m_header_written;
+
+      Apto::Array<BlockIndex> m_index;
+
+
+    public:
+      LIB_EXPORT ColumnarEncoder(std::ostream& out);
+      LIB_EXPORT ~ColumnarEncoder();
+
+      // Values are assigned to columns in order; the first row defines the columns and their types
+      LIB_EXPORT void Int(long long value);
+      LIB_EXPORT void Double(double value);
+      LIB_EXPORT void String(const char* value);
+
+      // Describe the most recently defined column
+      LIB_EXPORT void DescribeColumn(const char* descr, const char* format);
+
+      LIB_EXPORT void SetHeader(const Apto::String& filetype, const Apto::String& format, const Apto::String& comments);
+
+      LIB_EXPORT void EndRow();
+
+      // Writes any buffered rows as a block
+      LIB_EXPORT void Flush();
+      
+      // Writes any buffered rows, followed by the index record and trailer.  Nothing may be written afterwards.
+      LIB_EXPORT void Close();
+
+    private:
+      LIB_LOCAL Column* nextColumn(ColumnType type);
+      LIB_LOCAL void writeHeader();
+      LIB_LOCAL void writeBlock();
+      LIB_LOCAL void writeIndex();
+      LIB_LOCAL void writeRecord(unsigned int tag, const std::vector<unsigned char>& payload);
+
+      ColumnarEncoder(const ColumnarEncoder&); // @not_implemented
+      ColumnarEncoder& operator=(const ColumnarEncoder&); // @not_implemented
+    };
+
+
+    // Output::ColumnarReader - Random access reader for columnar data files
+    // --------------------------------------------------------------------------------------------------------------
+
+    class ColumnarReader
+    {
+    private:
+      struct ColumnInfo
+      {
+        ColumnType type;
+        Apto::String descr;
+        Apto::String format;
+      };
+      struct BlockInfo
+      {
+        long long offset;
+        long long first_row;
+        long long first_update;
+        long long last_update;
+      };
+
+      std::ifstream m_in;
+      long long m_file_size;
+
+      Apto::String m_filetype;
+      Apto::String m_format;
+      Apto::String m_comments;
+      Apto::Array<ColumnInfo> m_columns;
+      int m_update_col;
+      Apto::Array<BlockInfo> m_blocks;
+      long long m_num_rows;
+
+      // Decoded contents of the current block
+      int m_cur_block;
+      int m_block_rows;
+      int m_cur_row;
+      Apto::Array<Apto::Array<long long> > m_ints;
+      Apto::Array<Apto::Array<double> > m_doubles;
+      Apto::Array<Apto::Array<Apto::String> > m_strings;
+
+
+    public:
+      LIB_EXPORT ColumnarReader();
+
+      LIB_EXPORT bool Open(const Apto::String& path);
+
+      LIB_EXPORT inline const Apto::String& FileType() const { return m_filetype; }
+      LIB_EXPORT inline const Apto::String& Format() const { return m_format; }
+      LIB_EXPORT inline const Apto::String& Comments() const { return m_comments; }
+
+      LIB_EXPORT inline int NumColumns() const { return m_columns.GetSize(); }
+      LIB_EXPORT inline ColumnType TypeOfColumn(int col) const { return m_columns[col].type; }
+      LIB_EXPORT inline const Apto::String& ColumnDescription(int col) const { return m_columns[col].descr; }
+
+      LIB_EXPORT inline long long NumRows() const { return m_num_rows; }
+      LIB_EXPORT inline int NumBlocks() const { return m_blocks.GetSize(); }
+
+      // Row iteration.  Rewind/SeekUpdate position before a row; NextRow advances onto it.
+      LIB_EXPORT void Rewind();
+      LIB_EXPORT bool SeekUpdate(long long update);
+      LIB_EXPORT bool NextRow();
+
+      LIB_EXPORT long long IntValue(int col) const;
+      LIB_EXPORT double DoubleValue(int col) const;
+      LIB_EXPORT Apto::String StringValue(int col) const;
+
+      // Writes the file in the legacy text data file format, starting with the first row at or after first_update
+      LIB_EXPORT bool WriteText(std::ostream& out, long long first_update = -1);
+
+    private:
+      LIB_LOCAL bool readIndex();
+      LIB_LOCAL bool scanRecords();
+      LIB_LOCAL bool parseHeader(const std::vector<unsigned char>& payload);
+      LIB_LOCAL bool loadBlock(int block_id);
+      LIB_LOCAL long long rowUpdate(int row) const;
+      LIB_LOCAL bool readRecord(long long offset, unsigned int& tag, std::vector<unsigned char>& payload);
+
+      ColumnarReader(const ColumnarReader&); // @not_implemented
+      ColumnarReader& operator=(const ColumnarReader&); // @not_implemented
+    };
+
+  };
+};
+
+#endif
@@ -26,6 +26,7 @@
 #define AvidaOutputFile_h
 
 #include "avida/output/Socket.h"
+#include "avida/output/Writer.h"
 
 #include <fstream>
 #include <sstream>
@@ -48,7 +49,10 @@ namespace Avida {
       
       int m_num_cols;
       
-      std::ofstream m_fp;
+      FileBuffer m_buf;
+      std::ofstream m_fp;   // Formatting front end, attached to m_buf rather than its own file buffer
+      ColumnarEncoder* m_columnar;  // Non-NULL when writing a columnar (binary) data file
+      bool m_reported_text_only;    // A text-only write was rejected for this columnar file
 
       
     public:
@@ -72,11 +76,14 @@ namespace Avida {
       
       LIB_EXPORT inline bool Fail() const { return m_fp.fail(); }
       LIB_EXPORT inline bool Good() const { return m_fp.good(); }
+      LIB_EXPORT inline bool IsOpen() const { return m_buf.IsOpen(); }
       LIB_EXPORT inline bool HeaderDone() { return m_descr_written; }
+      LIB_EXPORT inline bool IsColumnar() const { return m_columnar != NULL; }
       
       LIB_EXPORT inline bool SetFileType(const Apto::String& ft);
 
       
+      // Direct stream access bypasses the columnar encoder; only valid for text data files
       LIB_EXPORT inline std::ofstream& OFStream() { return m_fp; }
       
       
@@ -94,12 +101,12 @@ namespace Avida {
       
       // The following methods output a value into the data file anonymously (no column descriptor).
       //  first argument (x, i, data_str, etc.) - the value to write (as double, int, const char *, etc.)
-      LIB_EXPORT inline void WriteAnonymous(double x) { m_fp << x << " "; }
-      LIB_EXPORT inline void WriteAnonymous(int i) { m_fp << i << " "; }
-      LIB_EXPORT inline void WriteAnonymous(long i) { m_fp << i << " "; }
-      LIB_EXPORT inline void WriteAnonymous(const char* data_str) { m_fp << data_str << " "; }
+      LIB_EXPORT void WriteAnonymous(double x);
+      LIB_EXPORT void WriteAnonymous(int i);
+      LIB_EXPORT void WriteAnonymous(long i);
+      LIB_EXPORT void WriteAnonymous(const char* data_str);
       
-      // The following methods are useful for outputting tables of values with row size x
+      // The following methods are useful for outputting tables of values with row size x (text data files only)
       LIB_EXPORT void WriteBlockElement(double x, int element, int x_size);
       LIB_EXPORT void WriteBlockElement(int i, int element, int x_size);
       
@@ -111,20 +118,22 @@ namespace Avida {
       LIB_EXPORT void WriteRawComment(const char* comment); // Writes a raw string to the data file header section
 
       LIB_EXPORT void WriteTimeStamp(); // Writes the current time into the data file comments.
-      LIB_EXPORT void WriteRaw(const char* str); // Writes raw string to the file immediately
+      LIB_EXPORT void WriteRaw(const char* str); // Writes raw string to the file immediately (text data files only)
       
       LIB_EXPORT void FlushComments(); // Forces writing of accumulated comments
       
       LIB_EXPORT void Endl(); // Write all data to disk and start a new line.
       
       
-      LIB_EXPORT void Flush();
+      LIB_EXPORT void Flush(); // Writes all data buffered for this file; does not wait on other files' pending writes
       
       
     private:
       LIB_EXPORT static FilePtr createWithPath(World* world, Apto::String path, bool append, Feedback* feedback);
 
       LIB_LOCAL File(World* world, const OutputID& output_id, bool append = false);
+      
+      LIB_LOCAL void rejectTextOnly(const char* method);
     };
     
 
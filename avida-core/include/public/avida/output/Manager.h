@@ -48,11 +48,15 @@ namespace Avida {
       Apto::Map<OutputID, SocketWeakRef> m_sockets;
       Apto::Map<OutputID, SocketPtr> m_static_sockets;
       
+      WriterPtr m_writer;
+      
     public:
-      LIB_EXPORT Manager(const Apto::String& output_path);
+      // A non-zero async_buffer_size enables background writing of files, holding at most that many bytes pending
+      LIB_EXPORT Manager(const Apto::String& output_path, int async_buffer_size = 0);
       LIB_EXPORT ~Manager();
       
       LIB_EXPORT inline const Apto::String& OutputPath() const { return m_output_path; }
+      LIB_EXPORT inline WriterPtr OutputWriter() const { return m_writer; }
       
       LIB_EXPORT OutputID OutputIDFromPath(Apto::String path) const;
 
@@ -33,9 +33,12 @@ namespace Avida {
     // Class Declarations
     // --------------------------------------------------------------------------------------------------------------
     
+    class ColumnarEncoder;
+    class ColumnarReader;
     class File;
     class Manager;
     class Socket;
+    class Writer;
     
     
     // Type Declarations
@@ -46,6 +49,7 @@ namespace Avida {
     typedef Apto::SmartPtr<File, Apto::InternalRCObject> FilePtr;
     typedef Apto::SmartPtr<Manager, Apto::InternalRCObject> ManagerPtr;
     typedef Apto::SmartPtr<Socket, Apto::InternalRCObject> SocketPtr;
+    typedef Apto::SmartPtr<Writer, Apto::InternalRCObject> WriterPtr;
   };
 };
 
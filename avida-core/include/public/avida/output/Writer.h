@@ -0,0 +1,142 @@
+/*
+ *  output/Writer.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputWriter_h
+#define AvidaOutputWriter_h
+
+#include "apto/core/Thread.h"
+#include "apto/platform.h"
+#include "avida/output/Types.h"
+
+#include <cstdio>
+#include <streambuf>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::Writer - Background thread that performs file writes on behalf of buffered output sockets
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Sockets fill fixed size blocks on the simulation thread and submit them whole.  The writer bounds the total
+    // memory held in submitted-but-unwritten blocks; a submit that would exceed the bound blocks until the writer
+    // catches up.  Blocks are recycled once written.
+
+    class Writer : public Apto::Thread, public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+    private:
+      struct Block
+      {
+        std::FILE* fp;
+        char* data;
+        size_t size;
+        bool close;
+        Block* next;
+      };
+
+      const size_t m_block_size;
+      const int m_max_pending;
+
+      Apto::Mutex m_mutex;
+      Apto::ConditionVariable m_work_cond;    // Signaled when blocks are queued or shutdown is requested
+      Apto::ConditionVariable m_drain_cond;   // Signaled as queued blocks are completed
+
+      Block* m_head;
+      Block* m_tail;
+      Apto::Array<char*> m_free_data;
+      int m_pending;
+      std::FILE* m_busy_fp;   // File of the block currently being written, NULL when idle
+      bool m_shutdown;
+
+
+    public:
+      LIB_EXPORT Writer(size_t block_size, size_t max_pending_bytes);
+      LIB_EXPORT ~Writer();
+
+      LIB_EXPORT inline size_t BlockSize() const { return m_block_size; }
+
+      // Returns an empty data block of BlockSize() bytes, reusing one already written when possible
+      LIB_EXPORT char* AcquireBlock();
+
+      // Queues size bytes of data (obtained from AcquireBlock) for writing to fp; ownership of data passes to the writer
+      LIB_EXPORT void Submit(std::FILE* fp, char* data, size_t size);
+
+      // Queues fp to be closed once all previously submitted data for it has been written
+      LIB_EXPORT void Close(std::FILE* fp);
+
+      // Waits until all submitted blocks have been written
+      LIB_EXPORT void Drain();
+
+      // Waits until all blocks submitted for fp have been written
+      LIB_EXPORT void Drain(std::FILE* fp);
+
+      // Drains all pending writes and stops the writer thread
+      LIB_EXPORT void Shutdown();
+
+    private:
+      LIB_LOCAL void Run();
+      LIB_LOCAL void enqueue(std::FILE* fp, char* data, size_t size, bool close);
+      LIB_LOCAL void releaseData(char* data);
+      LIB_LOCAL bool hasPending(std::FILE* fp) const;
+    };
+
+
+    // Output::FileBuffer - Stream buffer that batches formatted output into large blocks
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // When attached to a writer, full blocks are handed off to the writer thread and stream syncs (std::endl, flush)
+    // do not touch the file system.  Without a writer, blocks are written directly and syncs flush as usual.
+
+    class FileBuffer : public std::streambuf
+    {
+    private:
+      WriterPtr m_writer;
+      std::FILE* m_fp;
+      char* m_block;
+      size_t m_block_size;
+
+
+    public:
+      LIB_EXPORT FileBuffer() : m_fp(NULL), m_block(NULL), m_block_size(0) { ; }
+      LIB_EXPORT ~FileBuffer();
+
+      LIB_EXPORT bool Open(const char* path, bool append, WriterPtr writer, bool binary = false);
+      LIB_EXPORT inline bool IsOpen() const { return m_fp != NULL; }
+      LIB_EXPORT void Close();
+
+      // Writes all buffered data; when asynchronous, waits for the writer thread to complete this file's blocks
+      LIB_EXPORT void Flush();
+
+    protected:
+      LIB_EXPORT int_type overflow(int_type c);
+      LIB_EXPORT int sync();
+
+    private:
+      LIB_LOCAL void submitBlock();
+
+      FileBuffer(const FileBuffer&); // @not_implemented
+      FileBuffer& operator=(const FileBuffer&); // @not_implemented
+    };
+
+  };
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ *  util/ThreadPool.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaUtilThreadPool_h
+#define AvidaUtilThreadPool_h
+
+#include "apto/core.h"
+#include "apto/core/Thread.h"
+#include "apto/platform.h"
+
+
+namespace Avida {
+  namespace Util {
+    
+    // Util::ThreadPool - Fixed set of worker threads that execute indexed batches of work
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Execute() distributes the indices [0, count) of a job across the workers and the calling thread, returning once
+    // every index has completed.  Index 0 always runs on the calling thread.  Only one batch runs at a time.  A pool
+    // created with exactly one thread starts no workers and runs every batch directly on the calling thread; zero or
+    // less sizes the pool to the available CPUs.
+    
+    class ThreadPool
+    {
+    public:
+      class Job
+      {
+      public:
+        LIB_EXPORT virtual ~Job() { ; }
+        LIB_EXPORT virtual void Execute(int idx) = 0;
+      };
+      
+    private:
+      class Worker;
+      
+      Apto::Array<Worker*> m_workers;
+      
+      Apto::Mutex m_mutex;
+      Apto::ConditionVariable m_work_cond;
+      Apto::ConditionVariable m_done_cond;
+      
+      Job* m_job;
+      int m_count;
+      int m_next;
+      int m_completed;
+      bool m_shutdown;
+      
+      
+    public:
+      // num_threads includes the calling thread; zero or less uses all available CPUs
+      LIB_EXPORT ThreadPool(int num_threads);
+      LIB_EXPORT ~ThreadPool();
+      
+      LIB_EXPORT inline int NumThreads() const { return m_workers.GetSize() + 1; }
+      
+      LIB_EXPORT void Execute(Job& job, int count);
+      
+    private:
+      LIB_LOCAL void workerLoop();
+      LIB_LOCAL bool executeNext();
+      
+      ThreadPool(const ThreadPool&); // @not_implemented
+      ThreadPool& operator=(const ThreadPool&); // @not_implemented
+    };
+    
+  };
+};
+
+#endif
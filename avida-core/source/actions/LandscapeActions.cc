@@ -49,6 +49,9 @@
 
 using namespace Avida;
 
+static const PropertyKey s_prop_id_threshold("threshold");
+static const PropertyKey s_prop_id_name("name");
+
 
 class cActionAnalyzeLandscape : public cAction  // @parallelized
 {
@@ -923,7 +926,7 @@ public:
         assert(seq);
         
         cString name;
-        if ((bool)Apto::StrAs(genotype->Properties().Get("threshold"))) name = genotype->Properties().Get("name").StringValue();
+        if ((bool)Apto::StrAs(genotype->Properties().Get(s_prop_id_threshold))) name = genotype->Properties().Get(s_prop_id_name).StringValue();
         else name.Set("%03d-no_name-u%i-c%i", seq->GetSize(), update, orgdata->GetCellID());
 
         
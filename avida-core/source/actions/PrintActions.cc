@@ -40,8 +40,11 @@
 #include "cActionLibrary.h"
 #include "cAnalyze.h"
 #include "cAnalyzeGenotype.h"
+#include "cArgContainer.h"
+#include "cArgSchema.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cGridDump.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHistogram.h"
@@ -53,6 +56,7 @@
 #include "cPlasticPhenotype.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cProfiler.h"
 #include "cReaction.h"
 #include "cReactionLib.h"
 #include "cStats.h"
@@ -71,6 +75,26 @@ class cBioGroup;
 
 using namespace Avida;
 
+static const PropertyKey s_prop_id_src_transmission_type("src_transmission_type");
+static const PropertyKey s_prop_id_name("name");
+static const PropertyKey s_prop_id_genome("genome");
+static const PropertyKey s_prop_id_threshold("threshold");
+static const PropertyKey s_prop_id_last_group_id("last_group_id");
+static const PropertyKey s_prop_id_last_birth_cell("last_birth_cell");
+static const PropertyKey s_prop_id_last_forager_type("last_forager_type");
+static const PropertyKey s_prop_id_parents("parents");
+static const PropertyKey s_prop_id_fitness("fitness");
+static const PropertyKey s_prop_id_ave_metabolic_rate("ave_metabolic_rate");
+static const PropertyKey s_prop_id_ave_gestation_time("ave_gestation_time");
+static const PropertyKey s_prop_id_ave_fitness("ave_fitness");
+static const PropertyKey s_prop_id_ave_repro_rate("ave_repro_rate");
+static const PropertyKey s_prop_id_ave_copy_size("ave_copy_size");
+static const PropertyKey s_prop_id_ave_exe_size("ave_exe_size");
+static const PropertyKey s_prop_id_last_births("last_births");
+static const PropertyKey s_prop_id_last_breed_true("last_breed_true");
+static const PropertyKey s_prop_id_last_breed_in("last_breed_in");
+static const PropertyKey s_prop_id_max_fitness("max_fitness");
+
 
 #define STATS_OUT_FILE(METHOD, DEFAULT)                                                   /*  1 */ \
 class cAction ## METHOD : public cAction {                                                /*  2 */ \
@@ -451,6 +475,8 @@ public:
     m_data = retrieve_data(m_data_id);
   }
   
+  bool SupportsConcurrentNotify() const { return true; }
+  
   void Process(cAvidaContext&)
   {
     const cInstSet& is = m_world->GetHardwareManager().GetInstSet(m_inst_set);
@@ -515,6 +541,8 @@ public:
     m_data = retrieve_data(m_data_id);
   }
   
+  bool SupportsConcurrentNotify() const { return true; }
+  
   void Process(cAvidaContext&)
   {
     const cInstSet& is = m_world->GetHardwareManager().GetInstSet(m_inst_set);
@@ -536,6 +564,38 @@ public:
 };
 
 
+class cActionPrintInstructionProfile : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionPrintInstructionProfile(cWorld* world, const cString& args, Feedback& feedback)
+  : cAction(world, args), m_filename("instruction_profile.dat")
+  {
+    cArgSchema schema(':','=');
+    
+    // String Entries
+    schema.AddEntry("filename", 0, "instruction_profile.dat");
+    
+    cArgContainer* argc = cArgContainer::Load(args, schema, feedback);
+    
+    if (argc) {
+      m_filename = argc->GetString(0);
+    }
+    
+    delete argc;
+    
+    if (!m_world->GetProfiler().ProfilesInstructions())
+      feedback.Warning("PrintInstructionProfile requires PROFILE_LEVEL 2, no instructions will be recorded");
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string filename='instruction_profile.dat']"; }
+  
+  void Process(cAvidaContext&) { m_world->GetProfiler().PrintInstructionProfile(m_filename); }
+};
+
+
 class cActionPrintPreyInstructionData : public cAction
 {
 private:
@@ -955,7 +1015,7 @@ public:
     
     while (it->Next()) {
       Systematics::GroupPtr bg = it->Get();
-      int transmission_type = Apto::StrAs(bg->Properties().Get("src_transmission_type"));
+      int transmission_type = Apto::StrAs(bg->Properties().Get(s_prop_id_src_transmission_type));
       if(transmission_type == Systematics::HORIZONTAL || transmission_type == Systematics::VERTICAL)
       {
         if (bg->Depth() < min) min = bg->Depth();
@@ -976,7 +1036,7 @@ public:
     it = classmgr->ArbiterForRole("genotype")->Begin();
     while (it->Next()) {
       Systematics::GroupPtr bg = it->Get();
-      int transmission_type = Apto::StrAs(bg->Properties().Get("src_transmission_type"));
+      int transmission_type = Apto::StrAs(bg->Properties().Get(s_prop_id_src_transmission_type));
       if(transmission_type == Systematics::HORIZONTAL || transmission_type == Systematics::VERTICAL)
       {
         n[bg->Depth() - min] += bg->NumUnits();
@@ -1020,7 +1080,7 @@ public:
     
     while (it->Next()) {
       Systematics::GroupPtr bg = it->Get();
-      int transmission_type = Apto::StrAs(bg->Properties().Get("src_transmission_type"));
+      int transmission_type = Apto::StrAs(bg->Properties().Get(s_prop_id_src_transmission_type));
       if(transmission_type == Systematics::HORIZONTAL || transmission_type == Systematics::VERTICAL)
       {
         if (bg->Depth() < min) min = bg->Depth();
@@ -1038,7 +1098,7 @@ public:
     it = classmgr->ArbiterForRole("genotype")->Begin();
     while (it->Next()) {
       Systematics::GroupPtr bg = it->Get();
-      int transmission_type = Apto::StrAs(bg->Properties().Get("src_transmission_type"));
+      int transmission_type = Apto::StrAs(bg->Properties().Get(s_prop_id_src_transmission_type));
       if(transmission_type == Systematics::HORIZONTAL || transmission_type == Systematics::VERTICAL)
       {
         n[bg->Depth() - min] += bg->NumUnits();
@@ -1201,9 +1261,9 @@ public:
     Systematics::GroupPtr bg = it->Next();
     if (bg) {
       cString filename(m_filename);
-      if (filename == "") filename.Set("archive/%s.org", (const char*)bg->Properties().Get("name").StringValue());
+      if (filename == "") filename.Set("archive/%s.org", (const char*)bg->Properties().Get(s_prop_id_name).StringValue());
       cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-      testcpu->PrintGenome(ctx, Genome(bg->Properties().Get("genome")), filename, m_world->GetStats().GetUpdate());
+      testcpu->PrintGenome(ctx, Genome(bg->Properties().Get(s_prop_id_genome)), filename, m_world->GetStats().GetUpdate());
       delete testcpu;
     }
   }
@@ -1243,10 +1303,10 @@ public:
       
       if (!bg) break;
       
-      if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || i == 0)) {
-        int last_birth_group_id = Apto::StrAs(bg->Properties().Get("last_group_id")); 
-        int last_birth_cell = Apto::StrAs(bg->Properties().Get("last_birth_cell"));
-        int last_birth_forager_type = Apto::StrAs(bg->Properties().Get("last_forager_type")); 
+      if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)) || i == 0)) {
+        int last_birth_group_id = Apto::StrAs(bg->Properties().Get(s_prop_id_last_group_id)); 
+        int last_birth_cell = Apto::StrAs(bg->Properties().Get(s_prop_id_last_birth_cell));
+        int last_birth_forager_type = Apto::StrAs(bg->Properties().Get(s_prop_id_last_forager_type)); 
         if (i != 0) {
           for (int j = 0; j < birth_groups_checked.GetSize(); j++) {
             if (last_birth_group_id == birth_groups_checked[j]) {
@@ -1260,14 +1320,14 @@ public:
         if (already_used) continue;
         
         cString filename(m_filename);
-        if (filename == "") filename.Set("archive/grp%d_ft%d_%s.org", last_birth_group_id, last_birth_forager_type, (const char*)bg->Properties().Get("name").StringValue());
+        if (filename == "") filename.Set("archive/grp%d_ft%d_%s.org", last_birth_group_id, last_birth_forager_type, (const char*)bg->Properties().Get(s_prop_id_name).StringValue());
         else filename = filename.Set(filename + "grp%d_ft%d", last_birth_group_id, last_birth_forager_type); 
         
         // need a random number generator to pass to testcpu that does not affect any other random number pulls (since this is just for printing the genome)
         Apto::RNG::AvidaRNG rng(0);
         cAvidaContext ctx2(&m_world->GetDriver(), rng);
         cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx2);
-        testcpu->PrintGenome(ctx2, Genome(bg->Properties().Get("genome")), filename, m_world->GetStats().GetUpdate(), true, last_birth_cell, last_birth_group_id, last_birth_forager_type);
+        testcpu->PrintGenome(ctx2, Genome(bg->Properties().Get(s_prop_id_genome)), filename, m_world->GetStats().GetUpdate(), true, last_birth_cell, last_birth_group_id, last_birth_forager_type);
         delete testcpu;
       }
     }
@@ -1307,10 +1367,10 @@ public:
       
       if (!bg) break;
       
-      if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || i == 0)) {
-        int last_birth_group_id = Apto::StrAs(bg->Properties().Get("last_group_id")); 
-        int last_birth_cell = Apto::StrAs(bg->Properties().Get("last_birth_cell"));
-        int last_birth_forager_type = Apto::StrAs(bg->Properties().Get("last_forager_type")); 
+      if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)) || i == 0)) {
+        int last_birth_group_id = Apto::StrAs(bg->Properties().Get(s_prop_id_last_group_id)); 
+        int last_birth_cell = Apto::StrAs(bg->Properties().Get(s_prop_id_last_birth_cell));
+        int last_birth_forager_type = Apto::StrAs(bg->Properties().Get(s_prop_id_last_forager_type)); 
         if (i != 0) {
           for (int j = 0; j < birth_forage_types_checked.GetSize(); j++) {
             if (last_birth_forager_type == birth_forage_types_checked[j]) { 
@@ -1325,14 +1385,14 @@ public:
         
         
         cString filename(m_filename);
-        if (filename == "") filename.Set("archive/ft%d_grp%d_%s.org", last_birth_forager_type, last_birth_group_id, (const char*)bg->Properties().Get("name").StringValue());
+        if (filename == "") filename.Set("archive/ft%d_grp%d_%s.org", last_birth_forager_type, last_birth_group_id, (const char*)bg->Properties().Get(s_prop_id_name).StringValue());
         else filename = filename.Set(filename + ".ft%d_grp%d", last_birth_forager_type, last_birth_group_id); 
         
         // need a random number generator to pass to testcpu that does not affect any other random number pulls (since this is just for printing the genome)
         Apto::RNG::AvidaRNG rng(0);
         cAvidaContext ctx2(&m_world->GetDriver(), rng);
         cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx2);
-        testcpu->PrintGenome(ctx2, Genome(bg->Properties().Get("genome")), filename, m_world->GetStats().GetUpdate(), true, last_birth_cell, last_birth_group_id, last_birth_forager_type);
+        testcpu->PrintGenome(ctx2, Genome(bg->Properties().Get(s_prop_id_genome)), filename, m_world->GetStats().GetUpdate(), true, last_birth_cell, last_birth_group_id, last_birth_forager_type);
         delete testcpu;
       }
     }
@@ -1424,7 +1484,7 @@ public:
       Systematics::GroupPtr genotype = organism->SystematicsGroup("genotype");
       
       cCPUTestInfo test_info;
-      testcpu->TestGenome(ctx, test_info, Genome(genotype->Properties().Get("genome")));
+      testcpu->TestGenome(ctx, test_info, Genome(genotype->Properties().Get(s_prop_id_genome)));
       // We calculate the fitness based on the current merit,
       // but with the true gestation time. Also, we set the fitness
       // to zero if the creature is not viable.
@@ -1459,11 +1519,11 @@ public:
     
     // determine the name of the maximum fitness genotype
     cString max_f_name;
-    if ((bool)Apto::StrAs(max_f_genotype->Properties().Get("threshold")))
-      max_f_name = max_f_genotype->Properties().Get("name").StringValue();
+    if ((bool)Apto::StrAs(max_f_genotype->Properties().Get(s_prop_id_threshold)))
+      max_f_name = max_f_genotype->Properties().Get(s_prop_id_name).StringValue();
     else {
       // we put the current update into the name, so that it becomes unique.
-      Genome gen(max_f_genotype->Properties().Get("genome"));
+      Genome gen(max_f_genotype->Properties().Get(s_prop_id_genome));
       InstructionSequencePtr seq;
       seq.DynamicCastFrom(gen.Representation());
       max_f_name.Set("%03d-no_name-u%i", seq->GetSize(), update);
@@ -1482,7 +1542,7 @@ public:
     if (m_save_max) {
       cString filename;
       filename.Set("archive/%s", static_cast<const char*>(max_f_name));
-      testcpu->PrintGenome(ctx, Genome(max_f_genotype->Properties().Get("genome")), filename);
+      testcpu->PrintGenome(ctx, Genome(max_f_genotype->Properties().Get(s_prop_id_genome)), filename);
     }
     
     delete testcpu;
@@ -1578,7 +1638,7 @@ public:
     
     Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
-    if (!fp.is_open()) {
+    if (!df->IsOpen()) {
       ctx.Driver().Feedback().Error("PrintCCladeCount: Unable to open output file.");
       ctx.Driver().Abort(Avida::IO_ERROR);
     }
@@ -1700,7 +1760,7 @@ public:
       double fitness = 0.0;
       if (mode == "TEST_CPU" || mode == "ACTUAL"){
         test_info.UseManualInputs(orgs[i]->GetOrgInterface().GetInputs());
-        testcpu->TestGenome(ctx, test_info, Genome(gens[i]->Properties().Get("genome")));
+        testcpu->TestGenome(ctx, test_info, Genome(gens[i]->Properties().Get(s_prop_id_genome)));
       }
       
       if (mode == "TEST_CPU"){
@@ -1874,16 +1934,16 @@ public:
       cCPUTestInfo test_info;
       double fitness = 0.0;
       double parent_fitness = 1.0;
-      if (gens[i]->Properties().Get("parents").StringValue() != "") {
-        cStringList parents((const char*)gens[i]->Properties().Get("parents").StringValue(), ',');
+      if (gens[i]->Properties().Get(s_prop_id_parents).StringValue() != "") {
+        cStringList parents((const char*)gens[i]->Properties().Get(s_prop_id_parents).StringValue(), ',');
         
         Systematics::GroupPtr pbg = Systematics::Manager::Of(world->GetNewWorld())->ArbiterForRole("genotype")->Group(parents.Pop().AsInt());
-        parent_fitness = Apto::StrAs(pbg->Properties().Get("fitness"));
+        parent_fitness = Apto::StrAs(pbg->Properties().Get(s_prop_id_fitness));
       }
       
       if (mode == "TEST_CPU" || mode == "ACTUAL"){
         test_info.UseManualInputs( orgs[i]->GetOrgInterface().GetInputs() );
-        testcpu->TestGenome(ctx, test_info, Genome(gens[i]->Properties().Get("genome")));
+        testcpu->TestGenome(ctx, test_info, Genome(gens[i]->Properties().Get(s_prop_id_genome)));
       }
       
       if (mode == "TEST_CPU"){
@@ -1902,7 +1962,7 @@ public:
       
       //Update the histogram
       if (parent_fitness <= 0.0) {
-        ctx.Driver().Feedback().Error(cString("PrintRelativeFitness::MakeHistogram reports a parent fitness is zero.") + gens[i]->Properties().Get("parents").StringValue());
+        ctx.Driver().Feedback().Error(cString("PrintRelativeFitness::MakeHistogram reports a parent fitness is zero.") + gens[i]->Properties().Get(s_prop_id_parents).StringValue());
         ctx.Driver().Abort(Avida::INTERNAL_ERROR);
       }
       
@@ -2060,7 +2120,7 @@ public:
     //Create and print the histograms; this calls a static method in another action
     Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
     ofstream& fp = df->OFStream();
-    if (!fp.is_open()) {
+    if (!df->IsOpen()) {
       ctx.Driver().Feedback().Error("PrintCCladeFitnessHistogram: Unable to open output file.");
       ctx.Driver().Abort(Avida::IO_ERROR);
     }
@@ -2189,7 +2249,7 @@ public:
     //Create and print the histograms; this calls a static method in another action
     Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
     ofstream& fp = df->OFStream();
-    if (!fp.is_open()) {
+    if (!df->IsOpen()) {
       ctx.Driver().Feedback().Error("PrintCCladeRelativeFitnessHistogram: Unable to open output file.");
       ctx.Driver().Abort(Avida::IO_ERROR);      
     }
@@ -2438,8 +2498,8 @@ public:
       Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
       while (it->Next()) {
         Systematics::GroupPtr bg = it->Get();
-        Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(Genome(bg->Properties().Get("genome")), m_num_trials, test_info, m_world, ctx));
-        PrintPPG(fot, ppgen, bg->ID(), (const char*)bg->Properties().Get("parents").StringValue());
+        Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(Genome(bg->Properties().Get(s_prop_id_genome)), m_num_trials, test_info, m_world, ctx));
+        PrintPPG(fot, ppgen, bg->ID(), (const char*)bg->Properties().Get(s_prop_id_parents).StringValue());
       }
     }
   }
@@ -2733,7 +2793,7 @@ public:
     Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
     Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
     it->Next();
-    Genome best_genome(it->Get()->Properties().Get("genome"));
+    Genome best_genome(it->Get()->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr best_seq;
     best_seq.DynamicCastFrom(best_genome.Representation());
     dom_dist = InstructionSequence::FindHammingDistance(*m_r_seq, *best_seq);
@@ -2742,7 +2802,7 @@ public:
     count += it->Get()->NumUnits();
     // now cycle over the remaining genotypes
     while ((it->Next())) {
-      Genome cur_gen(it->Get()->Properties().Get("genome"));
+      Genome cur_gen(it->Get()->Properties().Get(s_prop_id_genome));
       InstructionSequencePtr cur_seq;
       cur_seq.DynamicCastFrom(cur_gen.Representation());
       int dist = InstructionSequence::FindHammingDistance(*m_r_seq, *cur_seq);
@@ -2820,18 +2880,18 @@ public:
     Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
     while ((it->Next())) {
       Systematics::GroupPtr bg = it->Get();
-      const Genome genome(bg->Properties().Get("genome"));
+      const Genome genome(bg->Properties().Get(s_prop_id_genome));
       ConstInstructionSequencePtr seq;
       seq.DynamicCastFrom(genome.Representation());
       const int num_orgs = bg->NumUnits();
       
       // now output
       
-      sum_fitness += (double)Apto::StrAs(bg->Properties().Get("fitness")) * num_orgs;
+      sum_fitness += (double)Apto::StrAs(bg->Properties().Get(s_prop_id_fitness)) * num_orgs;
       sum_num_organisms += num_orgs;
       
-      df->Write(bg->Properties().Get("name").StringValue(), "Genotype Name");
-      df->Write((double)Apto::StrAs(bg->Properties().Get("fitness")), "Fitness");
+      df->Write(bg->Properties().Get(s_prop_id_name).StringValue(), "Genotype Name");
+      df->Write((double)Apto::StrAs(bg->Properties().Get(s_prop_id_fitness)), "Fitness");
       df->Write(num_orgs, "Abundance");
       df->Write(InstructionSequence::FindHammingDistance(*r_seq, *seq), "Hamming distance to reference");
       df->Write(InstructionSequence::FindEditDistance(*r_seq, *seq), "Levenstein distance to reference");
@@ -2840,7 +2900,7 @@ public:
       // save into archive
       if (m_save_genotypes) {
         cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-        testcpu->PrintGenome(ctx, genome, cStringUtil::Stringf("archive/%s.org", (const char*)(bg->Properties().Get("name").StringValue())));
+        testcpu->PrintGenome(ctx, genome, cStringUtil::Stringf("archive/%s.org", (const char*)(bg->Properties().Get(s_prop_id_name).StringValue())));
         delete testcpu;
       }
       
@@ -2869,7 +2929,7 @@ public:
     Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
     Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
     Systematics::GroupPtr bg = it->Next();
-    Genome genome(bg->Properties().Get("genome"));
+    Genome genome(bg->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(genome.Representation());
     
@@ -2990,11 +3050,8 @@ public:
       if (pop.GetCell(i).IsOccupied() == false) continue;
       
       cPhenotype& phenotype = pop.GetCell(i).GetOrganism()->GetPhenotype();
-      int num_tasks = m_world->GetEnvironment().GetNumTasks();
       
-      int sum_tasks = 0;
-      for (int j = 0; j < num_tasks; j++)
-        sum_tasks += ( phenotype.GetLastTaskCount()[j] == 0 ) ? 0 : 1;
+      int sum_tasks = phenotype.GetLastTaskSet().CountBits2();
       if (sum_tasks>0) {
         ave_tot_tasks += sum_tasks;
         num_task_orgs++;
@@ -3095,7 +3152,7 @@ public:
     while ((it->Next())) {
       Systematics::GroupPtr bg = it->Get();
       const int num_organisms = bg->NumUnits();
-      const Genome genome(bg->Properties().Get("genome"));
+      const Genome genome(bg->Properties().Get(s_prop_id_genome));
       ConstInstructionSequencePtr seq;
       seq.DynamicCastFrom(genome.Representation());
       const int length = seq->GetSize();
@@ -3167,7 +3224,7 @@ public:
     cDoubleSum distance_sum;
     while ((it->Next())) {
       const int num_organisms = it->Get()->NumUnits();
-      Genome cur_gen(it->Get()->Properties().Get("genome"));
+      Genome cur_gen(it->Get()->Properties().Get(s_prop_id_genome));
       InstructionSequencePtr cur_seq;
       cur_seq.DynamicCastFrom(cur_gen.Representation());
       const int cur_dist = InstructionSequence::FindEditDistance(con_genome, *cur_seq);
@@ -3179,7 +3236,7 @@ public:
     //    cGenotype* con_genotype = classmgr.FindGenotype(con_genome, -1);
     
     it = classmgr->ArbiterForRole("genotype")->Begin();
-    Genome best_genome(it->Next()->Properties().Get("genome"));
+    Genome best_genome(it->Next()->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr best_seq;
     best_seq.DynamicCastFrom(best_genome.Representation());
     const int best_dist = InstructionSequence::FindEditDistance(con_genome, *best_seq);
@@ -3327,6 +3384,15 @@ private:
 class cActionDumpEnergyGrid : public cAction
 {
 private:
+  class cEnergySource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetStoredEnergy() : 0.0;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3343,20 +3409,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
-      for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
-        double cell_energy = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetStoredEnergy() : 0.0;
-        fp << cell_energy << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cEnergySource());
   }
 };
 
 class cActionDumpExecutionRatioGrid : public cAction
 {
 private:
+  class cExecutionRatioSource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetEnergyUsageRatio() : 1.0;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3373,20 +3441,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
-      for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
-        double cell_executionRatio = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetEnergyUsageRatio() : 1.0;
-        fp << cell_executionRatio << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cExecutionRatioSource());
   }
 };
 
 class cActionDumpCellDataGrid : public cAction
 {
 private:
+  class cCellDataSource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return cell.GetCellData();
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3403,20 +3473,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
-      for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
-        double cell_data = cell.GetCellData();
-        fp << cell_data << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cCellDataSource());
   }
 };
 
 class cActionDumpFitnessGrid : public cAction
 {
 private:
+  class cFitnessSource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetFitness() : 0.0;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3433,14 +3505,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        double fitness = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetFitness() : 0.0;
-        fp << fitness << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cFitnessSource());
   }
 };
 
@@ -3448,6 +3513,21 @@ public:
 class cActionDumpClassificationIDGrid : public cAction
 {
 private:
+  class cClassificationIDSource : public cGridDump::cIntSource
+  {
+  private:
+    const cString& m_role;
+  public:
+    cClassificationIDSource(const cString& role) : m_role(role) { ; }
+    int Value(cPopulationCell& cell) const
+    {
+      if (!cell.IsOccupied()) return -1;
+      Systematics::GroupPtr group = cell.GetOrganism()->SystematicsGroup((const char*)m_role);
+      return (group) ? group->ID() : -1;
+    }
+    bool IsThreadSafe() const { return false; }
+  };
+
   cString m_filename;
   cString m_role;
   
@@ -3467,14 +3547,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int id = (cell.IsOccupied() && cell.GetOrganism()->SystematicsGroup((const char*)m_role)) ? cell.GetOrganism()->SystematicsGroup((const char*)m_role)->ID() : -1;
-        fp << id << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cClassificationIDSource(m_role));
   }
 };
 
@@ -3534,7 +3607,7 @@ public:
         if (bg) {
           int color = 0;
           for (; color < m_num_colors; color++) if (m_genotype_chart[color] == bg->ID()) break;
-          if (color == m_num_colors && (bool)Apto::StrAs(bg->Properties().Get("threshold"))) color++;
+          if (color == m_num_colors && (bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold))) color++;
           fp << color << " ";
         } else {
           fp << "-1 ";
@@ -3571,6 +3644,15 @@ private:
 class cActionDumpPhenotypeIDGrid : public cAction
 {
 private:
+  class cPhenotypeIDSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().CalcID() : -1;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3587,20 +3669,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int id = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().CalcID() : -1;
-        fp << id << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cPhenotypeIDSource());
   }
 };
 
 class cActionDumpIDGrid : public cAction
 {
 private:
+  class cIDSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetID() : -1;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3617,20 +3701,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int id = (cell.IsOccupied()) ? cell.GetOrganism()->GetID() : -1;
-        fp << id << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cIDSource());
   }
 };
 
 class cActionDumpVitalityGrid : public cAction
 {
 private:
+  class cVitalitySource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetVitality() : -1;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3647,20 +3733,35 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        double id = (cell.IsOccupied()) ? cell.GetOrganism()->GetVitality() : -1;
-        fp << id << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cVitalitySource());
   }
 };
 
 class cActionDumpTargetGrid : public cAction
 {
 private:
+  class cTargetSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetForageTarget() : -99;
+    }
+  };
+
+  // Picks a random avatar from each cell, so must be gathered in cell order
+  class cAvatarTargetSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      if (!cell.HasAV()) return -99;
+      if (cell.HasPredAV()) return cell.GetRandPredAV()->GetForageTarget();
+      return cell.GetRandPreyAV()->GetForageTarget();
+    }
+    bool IsThreadSafe() const { return false; }
+  };
+
   cString m_filename;
   
 public:
@@ -3672,7 +3773,6 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='']"; }
   void Process(cAvidaContext&)
   {
-    const int worldx = m_world->GetPopulation().GetWorldX();
     cString filename(m_filename);
     
     if (m_world->GetConfig().USE_AVATARS.Get()) {
@@ -3680,18 +3780,7 @@ public:
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
       ofstream& fp = df->OFStream();
       
-      for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-        for (int i = 0; i < worldx; i++) {
-          cPopulationCell& cell = m_world->GetPopulation().GetCell(j * worldx + i);
-          int target = -99;
-          if (cell.HasAV()) {
-            if (cell.HasPredAV()) target = cell.GetRandPredAV()->GetForageTarget();
-            else target = cell.GetRandPreyAV()->GetForageTarget();
-          } 
-          fp << target << " ";
-        }
-        fp << endl;
-      }
+      cGridDump(m_world).Write(fp, cAvatarTargetSource());
     }    
     
     else {
@@ -3699,15 +3788,7 @@ public:
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
       ofstream& fp = df->OFStream();
       
-      for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-        for (int i = 0; i < worldx; i++) {
-          cPopulationCell& cell = m_world->GetPopulation().GetCell(j * worldx + i);
-          int target = -99;
-          if (cell.IsOccupied()) target = cell.GetOrganism()->GetForageTarget();
-          fp << target << " ";
-        }
-        fp << endl;
-      }
+      cGridDump(m_world).Write(fp, cTargetSource());
     }
   }
 };
@@ -3765,6 +3846,15 @@ public:
 class cActionDumpSleepGrid : public cAction
 {
 private:
+  class cSleepSource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->IsSleeping() : 0.0;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -3781,14 +3871,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int i = 0; i < m_world->GetPopulation().GetWorldY(); i++) {
-      for (int j = 0; j < m_world->GetPopulation().GetWorldX(); j++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(i * m_world->GetPopulation().GetWorldX() + j);
-        double cell_energy = (cell.IsOccupied()) ? cell.GetOrganism()->IsSleeping() : 0.0;
-        fp << cell_energy << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cSleepSource());
   }
 };
 
@@ -3796,6 +3879,20 @@ public:
 class cActionDumpGenomeLengthGrid : public cAction
 {
 private:
+  // Casting the genome's representation takes a reference to it, so these are gathered on the calling thread
+  class cGenomeLengthSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      if (!cell.IsOccupied()) return -1;
+      ConstInstructionSequencePtr seq;
+      seq.DynamicCastFrom(cell.GetOrganism()->GetGenome().Representation());
+      return seq->GetSize();
+    }
+    bool IsThreadSafe() const { return false; }
+  };
+
   cString m_filename;
   
 public:
@@ -3812,24 +3909,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    cPopulation* pop = &m_world->GetPopulation();
-    
-    for (int j = 0; j < pop->GetWorldY(); j++) {
-      for (int i = 0; i < pop->GetWorldX(); i++) {
-        int genome_length = 0;
-        int cell_num = j * pop->GetWorldX() + i;
-        if (pop->GetCell(cell_num).IsOccupied() == true)
-        {
-          cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          ConstInstructionSequencePtr seq;
-          seq.DynamicCastFrom(organism->GetGenome().Representation());
-          genome_length = seq->GetSize();
-        }
-        else { genome_length = -1; }
-        fp << genome_length << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cGenomeLengthSource());
   }
 };
 
@@ -3856,8 +3936,6 @@ public:
     cPopulation* pop = &m_world->GetPopulation();
     cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
     
-    const int num_tasks = m_world->GetEnvironment().GetNumTasks();
-    
     for (int i = 0; i < pop->GetWorldY(); i++) {
       for (int j = 0; j < pop->GetWorldX(); j++) {
         int task_sum = -1;
@@ -3867,9 +3945,9 @@ public:
           cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
           cCPUTestInfo test_info;
           testcpu->TestGenome(ctx, test_info, organism->GetGenome());
-          cPhenotype& test_phenotype = test_info.GetTestPhenotype();
-          for (int k = 0; k < num_tasks; k++) {
-            if (test_phenotype.GetLastTaskCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
+          const cBitArray& task_set = test_info.GetTestPhenotype().GetLastTaskSet();
+          for (int k = task_set.FindBit1(); k >= 0; k = task_set.FindBit1(k + 1)) {
+            task_sum += static_cast<int>(pow(2.0, k));
           }
         }
         fp << task_sum << " ";
@@ -4121,6 +4199,20 @@ public:
 class cActionDumpParasiteVirulenceGrid : public cAction
 {
 private:
+  // Copies the host's parasite references, so these are gathered on the calling thread
+  class cVirulenceSource : public cGridDump::cDoubleSource
+  {
+  public:
+    double Value(cPopulationCell& cell) const
+    {
+      if (!cell.IsOccupied() || cell.GetOrganism()->GetNumParasites() == 0) return -1;
+      Apto::SmartPtr<cParasite, Apto::InternalRCObject> parasite;
+      parasite.DynamicCastFrom(cell.GetOrganism()->GetParasites()[0]);
+      return parasite->GetVirulence();
+    }
+    bool IsThreadSafe() const { return false; }
+  };
+
   cString m_filename;
   
 public:
@@ -4137,28 +4229,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    cPopulation* pop = &m_world->GetPopulation();
-    
-    for (int j = 0; j < pop->GetWorldY(); j++) {
-      for (int i = 0; i < pop->GetWorldX(); i++) {
-        double virulence = 0;
-        int cell_num = j * pop->GetWorldX() + i;
-        if (pop->GetCell(cell_num).IsOccupied() == true) {
-          cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          if(organism->GetNumParasites() > 0)
-          {
-            Apto::Array<Systematics::UnitPtr> parasites = organism->GetParasites();
-            Apto::SmartPtr<cParasite, Apto::InternalRCObject> parasite;
-            parasite.DynamicCastFrom(parasites[0]);
-            virulence = parasite->GetVirulence();
-          }
-          else { virulence = -1; }
-        }
-        else { virulence = -1; }
-        fp << virulence << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cVirulenceSource());
   }
 };
 
@@ -4237,6 +4308,24 @@ public:
 class cActionDumpReactionGrid : public cAction
 {
 private:
+  class cReactionSource : public cGridDump::cIntSource
+  {
+  private:
+    const int m_num_tasks;
+  public:
+    cReactionSource(int num_tasks) : m_num_tasks(num_tasks) { ; }
+    int Value(cPopulationCell& cell) const
+    {
+      if (!cell.IsOccupied()) return -1;
+      const Apto::Array<int>& reaction_count = cell.GetOrganism()->GetPhenotype().GetLastReactionCount();
+      int task_sum = 0;
+      for (int k = 0; k < m_num_tasks; k++) {
+        if (reaction_count[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
+      }
+      return task_sum;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -4253,27 +4342,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    cPopulation* pop = &m_world->GetPopulation();
-    
-    const int num_tasks = m_world->GetEnvironment().GetNumTasks();
-    
-    for (int j = 0; j < pop->GetWorldY(); j++) {
-      for (int i = 0; i < pop->GetWorldX(); i++) {
-        int task_sum = 0;
-        int cell_num = j * pop->GetWorldX() + i;
-        if (pop->GetCell(cell_num).IsOccupied() == true) {
-          cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          
-          cPhenotype& test_phenotype = organism->GetPhenotype();
-          for (int k = 0; k < num_tasks; k++) {
-            if (test_phenotype.GetLastReactionCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
-          }
-        }
-        else {task_sum = -1;}
-        fp << task_sum << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cReactionSource(m_world->GetEnvironment().GetNumTasks()));
   }
 };
 
@@ -4475,7 +4544,7 @@ public:
         if (pop->GetCell(cell_num).IsOccupied() == true)
         {
           cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          Genome host_genome(organism->Properties().Get("genome"));
+          Genome host_genome(organism->Properties().Get(s_prop_id_genome));
           ConstInstructionSequencePtr seq;
           seq.DynamicCastFrom(host_genome.Representation());
           genome_seq = seq->AsString();
@@ -4578,6 +4647,15 @@ public:
 class cActionDumpDonorGrid : public cAction
 {
 private:
+  class cDonorSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsDonorLast() : -1;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -4594,20 +4672,22 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int donor = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsDonorLast() : -1;
-        fp << donor << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cDonorSource());
   }
 };
 
 class cActionDumpReceiverGrid : public cAction
 {
 private:
+  class cReceiverSource : public cGridDump::cIntSource
+  {
+  public:
+    int Value(cPopulationCell& cell) const
+    {
+      return (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsReceiver() : -1;
+    }
+  };
+
   cString m_filename;
   
 public:
@@ -4624,14 +4704,7 @@ public:
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int recv = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().IsReceiver() : -1;
-        fp << recv << " ";
-      }
-      fp << endl;
-    }
+    cGridDump(m_world).Write(fp, cReceiverSource());
   }
 };
 
@@ -5416,25 +5489,25 @@ public:
     Systematics::GroupPtr bg = it->Next();
     if (!bg) return;
     
-    df->Write(bg->Properties().Get("ave_metabolic_rate").DoubleValue(),       "Average Merit of the Dominant Genotype");
-    df->Write(bg->Properties().Get("ave_gestation_time").DoubleValue(),   "Average Gestation Time of the Dominant Genotype");
-    df->Write(bg->Properties().Get("ave_fitness").DoubleValue(),     "Average Fitness of the Dominant Genotype");
-    df->Write(bg->Properties().Get("ave_repro_rate").DoubleValue(),  "Repro Rate?");
+    df->Write(bg->Properties().Get(s_prop_id_ave_metabolic_rate).DoubleValue(),       "Average Merit of the Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_ave_gestation_time).DoubleValue(),   "Average Gestation Time of the Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_ave_fitness).DoubleValue(),     "Average Fitness of the Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_ave_repro_rate).DoubleValue(),  "Repro Rate?");
     
-    Genome gen(bg->Properties().Get("genome"));
+    Genome gen(bg->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(gen.Representation());
     df->Write(seq->GetSize(),        "Size of Dominant Genotype");
-    df->Write(bg->Properties().Get("ave_copy_size").DoubleValue(), "Copied Size of Dominant Genotype");
-    df->Write(bg->Properties().Get("ave_exe_size").DoubleValue(), "Executed Size of Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_ave_copy_size).DoubleValue(), "Copied Size of Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_ave_exe_size).DoubleValue(), "Executed Size of Dominant Genotype");
     df->Write(bg->NumUnits(),   "Abundance of Dominant Genotype");
-    df->Write(bg->Properties().Get("last_births").IntValue(),      "Number of Births");
-    df->Write(bg->Properties().Get("last_breed_true").IntValue(),  "Number of Dominant Breed True?");
+    df->Write(bg->Properties().Get(s_prop_id_last_births).IntValue(),      "Number of Births");
+    df->Write(bg->Properties().Get(s_prop_id_last_breed_true).IntValue(),  "Number of Dominant Breed True?");
     df->Write(bg->Depth(),  "Dominant Gene Depth");
-    df->Write(bg->Properties().Get("last_breed_in").IntValue(),    "Dominant Breed In");
-    df->Write(bg->Properties().Get("max_fitness").DoubleValue(),     "Max Fitness?");
+    df->Write(bg->Properties().Get(s_prop_id_last_breed_in).IntValue(),    "Dominant Breed In");
+    df->Write(bg->Properties().Get(s_prop_id_max_fitness).DoubleValue(),     "Max Fitness?");
     df->Write(bg->ID(), "Genotype ID of Dominant Genotype");
-    df->Write(bg->Properties().Get("name").StringValue(),        "Name of the Dominant Genotype");
+    df->Write(bg->Properties().Get(s_prop_id_name).StringValue(),        "Name of the Dominant Genotype");
     df->Endl();    
   }
 };
@@ -5616,6 +5689,7 @@ void RegisterPrintActions(cActionLibrary* action_lib)
   
   action_lib->Register<cActionPrintMultiProcessData>("PrintMultiProcessData");
   action_lib->Register<cActionPrintProfilingData>("PrintProfilingData");
+  action_lib->Register<cActionPrintInstructionProfile>("PrintInstructionProfile");
   action_lib->Register<cActionPrintOrganismLocation>("PrintOrganismLocation");
   action_lib->Register<cActionPrintOrgLocData>("PrintOrgLocData");
   action_lib->Register<cActionPrintPreyFlockingData>("PrintPreyFlockingData");
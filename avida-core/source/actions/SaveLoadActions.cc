@@ -281,12 +281,119 @@ public:
   }
 };
 
+/*
+ Saves the state of the population (organism hardware and phenotypes, resources, cell state, stats and the event
+ schedule) in a binary checkpoint for LoadCheckpoint.  Saving does not disturb the run.  A checkpoint does not support
+ an exact resume: the random number generator's state is not captured, genotypes are reloaded with new IDs, and
+ historic (extinct) genotypes are not saved.  Worlds with more than one deme, runs with sexual or waiting births, and
+ hardware types without checkpoint support are refused.
+
+ Parameters:
+   filename (string) default: checkpoint
+     The base name of the file; the current update and a .ckp extension are appended.
+   background (int) default: 1
+     Write the file on a background thread, so that the run continues while the data is flushed.
+ */
+class cActionSaveCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  bool m_background;
+  
+public:
+  cActionSaveCheckpoint(cWorld* world, const cString& args, Feedback& feedback)
+    : cAction(world, args), m_filename(""), m_background(true)
+  {
+    cArgSchema schema(':','=');
+    
+    // String Entries
+    schema.AddEntry("filename", 0, "checkpoint");
+    
+    // Integer Entries
+    schema.AddEntry("background", 0, 0, 1, 1);
+    
+    cArgContainer* argc = cArgContainer::Load(args, schema, feedback);
+    
+    if (argc) {
+      m_filename = argc->GetString(0);
+      m_background = argc->GetInt(0);
+    }
+    
+    delete argc;
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string filename='checkpoint'] [boolean background=1]"; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    int update = m_world->GetStats().GetUpdate();
+    cString filename = cStringUtil::Stringf("%s-%d.ckp", (const char*)m_filename, update);
+    if (!m_world->GetPopulation().SaveCheckpoint(filename, ctx, m_background)) {
+      m_world->GetDriver().Feedback().Warning("failed to write checkpoint '%s'", (const char*)filename);
+    }
+  }
+};
+
+
+/*
+ Restores the population from a checkpoint written by SaveCheckpoint.  The world dimensions and environment must
+ match those of the run that wrote the checkpoint.  The resumed run is not an exact continuation of the saving run
+ (see SaveCheckpoint), so loading fails with an error unless the inexact resume is explicitly accepted.
+
+ Parameters:
+   filename (string)
+     The name of the checkpoint file to load.
+   inexact (int) default: 0
+     Accept a resume that does not repeat the saving run: the random sequence restarts, and genotype IDs and
+     historic genotypes are not restored.
+ */
+class cActionLoadCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  bool m_inexact;
+  
+public:
+  cActionLoadCheckpoint(cWorld* world, const cString& args, Feedback& feedback)
+    : cAction(world, args), m_filename(""), m_inexact(false)
+  {
+    cArgSchema schema(':','=');
+    
+    // String Entries
+    schema.AddEntry("filename", 0, cArgSchema::SCHEMA_STRING);
+    
+    // Integer Entries
+    schema.AddEntry("inexact", 0, 0, 1, 0);
+    
+    cArgContainer* argc = cArgContainer::Load(args, schema, feedback);
+    
+    if (argc) {
+      m_filename = argc->GetString(0);
+      m_inexact = argc->GetInt(0);
+    }
+    
+    delete argc;
+  }
+  
+  static const cString GetDescription() { return "Arguments: <string filename> [boolean inexact=0]"; }
+  
+  void Process(cAvidaContext& ctx)
+  {
+    if (!m_world->GetPopulation().LoadCheckpoint(m_filename, ctx, m_inexact)) {
+      m_world->GetDriver().Feedback().Error("failed to load checkpoint");
+      m_world->GetDriver().Abort(Avida::IO_ERROR);
+    }
+  }
+};
+
 void RegisterSaveLoadActions(cActionLibrary* action_lib)
 {
   action_lib->Register<cActionLoadParasiteGenotypeList>("LoadParasiteGenotypeList");
   action_lib->Register<cActionLoadHostGenotypeList>("LoadHostGenotypeList");
   action_lib->Register<cActionLoadPopulation>("LoadPopulation");
   action_lib->Register<cActionSavePopulation>("SavePopulation");
+  action_lib->Register<cActionLoadCheckpoint>("LoadCheckpoint");
+  action_lib->Register<cActionSaveCheckpoint>("SaveCheckpoint");
   action_lib->Register<cActionLoadStructuredSystematicsGroup>("LoadStructuredSystematicsGroup");
   action_lib->Register<cActionSaveStructuredSystematicsGroup>("SaveStructuredSystematicsGroup");
   action_lib->Register<cActionSaveFlameData>("SaveFlameData");
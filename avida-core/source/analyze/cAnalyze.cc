@@ -48,13 +48,16 @@
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cGenotypeLoadBlock.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
 #include "cLandscape.h"
+#include "cMappedTextFile.h"
 #include "cModularityAnalysis.h"
+#include "cPairwiseDistanceAnalysis.h"
 #include "cPhenotype.h"
 #include "cPhenPlastGenotype.h"
 #include "cPlasticPhenotype.h"
@@ -775,7 +778,7 @@ void cAnalyze::LoadFile(cString cur_string)
   
   cout << "Loading: " << filename << endl;
   
-  cInitFile input_file(filename, m_world->GetWorkingDir());
+  cMappedTextFile input_file(filename, m_world->GetWorkingDir(), m_world->GetConfig().MAX_CONCURRENCY.Get());
   if (!input_file.WasOpened()) {
     const cUserFeedback& feedback = input_file.GetFeedback();
     for (int i = 0; i < feedback.GetNumMessages(); i++) {
@@ -825,32 +828,29 @@ void cAnalyze::LoadFile(cString cur_string)
   HashPropertyMap props;
   cHardwareManager::SetupPropertyMap(props, (const char*)is.GetInstSetName());
   Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
-  int load_count = 0;
   
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
-    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
-    
-    output_it.Reset();
-    tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
-    while ((data_command = output_it.Next()) != NULL) {
-      data_command->SetValue(genotype, cur_line.PopWord());
-    }
-    
-    // Give this genotype a name.  Base it on the ID if possible.
-    if (id_inc == false) {
-      cString name = cStringUtil::Stringf("org-%d", load_count++);
-      genotype->SetName(name);
-    }
-    else {
-      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
-      genotype->SetName(name);
-    }
-    
-    // Add this genotype to the proper batch.
-    batch[cur_batch].List().PushRear(genotype);
+  Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*> commands;
+  tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
+  while ((data_command = output_it.Next()) != NULL) commands.Push(data_command);
+  
+  // Build the genotypes a block of lines at a time on the job queue...
+  const int num_lines = input_file.GetNumLines();
+  Apto::Array<cAnalyzeGenotype*> genotypes(num_lines);
+  tList<cGenotypeLoadBlock> block_list;
+  tAnalyzeJobBatch<cGenotypeLoadBlock> jobbatch(m_jobqueue);
+  for (int line_id = 0; line_id < num_lines; line_id += cGenotypeLoadBlock::BLOCK_SIZE) {
+    const int line_end = Apto::Min<int>(line_id + cGenotypeLoadBlock::BLOCK_SIZE, num_lines);
+    cGenotypeLoadBlock* block = new cGenotypeLoadBlock(m_world, input_file, commands, default_genome, id_inc,
+                                                       genotypes, line_id, line_end);
+    block_list.Push(block);
+    jobbatch.AddJob(block, &cGenotypeLoadBlock::Load);
   }
+  jobbatch.RunBatch();
+  cGenotypeLoadBlock* block = NULL;
+  while ((block = block_list.Pop())) delete block;
+  
+  // ...then add them to the proper batch in file order.
+  for (int line_id = 0; line_id < num_lines; line_id++) batch[cur_batch].List().PushRear(genotypes[line_id]);
   
   // Adjust the flags on this batch
   batch[cur_batch].SetLineage(false);
@@ -3221,57 +3221,76 @@ void cAnalyze::CommandPrintDistances(cString cur_string)
   fout << "# 5: Frac distances above threshold (" << dist_threshold << ")" << endl;
   fout << endl;
   
-  // Loop through all pairs of organisms.
-  int dist_total = 0;
-  int dist_max = 0;
-  int pair_count = 0;
-  int threshold_pair_count = 0;
+  // Visitor that folds each finished tile of distances into the totals, weighted by organism counts
+  class cDistanceTotals : public cPairwiseDistanceAnalysis::cVisitor
+  {
+  public:
+    const Apto::Array<int>& counts;
+    const int dist_threshold;
+    int dist_total;
+    int dist_max;
+    int pair_count;
+    int threshold_pair_count;
+    int watermark;
+    
+    cDistanceTotals(const Apto::Array<int>& in_counts, int in_threshold)
+      : counts(in_counts), dist_threshold(in_threshold), dist_total(0), dist_max(0), pair_count(0), threshold_pair_count(0)
+      , watermark(0) { ; }
+    
+    void VisitTile(const cPairwiseDistanceAnalysis::cTile& tile)
+    {
+      for (int i = tile.GetRowBegin(); i < tile.GetRowEnd(); i++) {
+        for (int j = tile.GetColBegin(); j < tile.GetColEnd(); j++) {
+          if (!tile.HasPair(i, j)) continue;
+          
+          const int cur_pairs = counts[i] * counts[j];
+          const int cur_dist = tile.GetDistance(i, j);
+          dist_total += cur_pairs * cur_dist;
+          if (cur_dist > dist_max) dist_max = cur_dist;
+          pair_count += cur_pairs;
+          if (cur_dist >= dist_threshold) threshold_pair_count += cur_pairs;
+          
+          if (pair_count > watermark) {
+            cout << watermark << endl;
+            watermark += 100000;
+          }
+        }
+      }
+    }
+  };
+  
+  // Collect the genotypes once; each distinct pair is calculated once, in parallel tiles.
 	double count = 0;
-	
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  tListIterator<cAnalyzeGenotype> batch_it1(batch[cur_batch].List());
-
-  int watermark = 0;
+  Apto::Array<int> counts;
+  Apto::Array<ConstInstructionSequencePtr> seq_ptrs;
+  Apto::Array<const InstructionSequence*> seqs;
+  cDistanceTotals totals(counts, dist_threshold);
   
-  while ((genotype1 = batch_it1.Next()) != NULL) {
+  cAnalyzeGenotype * genotype = NULL;
+  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+  while ((genotype = batch_it.Next()) != NULL) {
 		count ++;
-    const int gen1_count = genotype1->GetNumCPUs();
-
+    const int gen_count = genotype->GetNumCPUs();
+    
     // Pair this genotype with itself for a distance of 0.
-    pair_count += gen1_count * (gen1_count - 1) / 2;
-
-    // Loop through the other genotypes this one can be paired with.
-    tListIterator<cAnalyzeGenotype> batch_it2(batch_it1);
-    while ((genotype2 = batch_it2.Next()) != NULL) {
-      const int gen2_count = genotype2->GetNumCPUs();
-      const int cur_pairs = gen1_count * gen2_count;
-      
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int cur_dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      dist_total += cur_pairs * cur_dist;
-      if (cur_dist > dist_max) dist_max = cur_dist;
-      pair_count += cur_pairs;
-      if (cur_dist >= dist_threshold) threshold_pair_count += cur_pairs;
-
-      if (pair_count > watermark) {
-	cout << watermark << endl;
-	watermark += 100000;
-      }
-    }
+    totals.pair_count += gen_count * (gen_count - 1) / 2;
+    
+    ConstInstructionSequencePtr seq_p;
+    ConstGeneticRepresentationPtr rep_p = genotype->GetGenome().Representation();
+    seq_p.DynamicCastFrom(rep_p);
+    counts.Push(gen_count);
+    seq_ptrs.Push(seq_p);
+    seqs.Push(&(*seq_p));
   }
   
+  cPairwiseDistanceAnalysis distances(m_jobqueue, seqs, cPairwiseDistanceAnalysis::EDIT_DISTANCE);
+  distances.Run(totals);
+  
+  const int dist_total = totals.dist_total;
+  const int dist_max = totals.dist_max;
+  const int pair_count = totals.pair_count;
+  const int threshold_pair_count = totals.threshold_pair_count;
+  
 	count = (count * (count-1) ) /2;
   fout << pair_count << " "
 	     << ((double) dist_total) / count << " " 
@@ -7338,9 +7357,33 @@ void cAnalyze::CommandHamming(cString cur_string)
   tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
   tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
   
+  // Collect the second batch once so each genotype in the first is measured against all of it in one pass
+  Apto::Array<cAnalyzeGenotype*> genotypes2;
+  Apto::Array<ConstInstructionSequencePtr> genotype2_seq_ptrs;
+  Apto::Array<const InstructionSequence*> genotype2_seqs;
+  while ((genotype2 = list2_it.Next()) != NULL) {
+    ConstInstructionSequencePtr genotype2_seq_p;
+    ConstGeneticRepresentationPtr genotype2_rep_p = genotype2->GetGenome().Representation();
+    genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
+    genotypes2.Push(genotype2);
+    genotype2_seq_ptrs.Push(genotype2_seq_p);
+    genotype2_seqs.Push(&(*genotype2_seq_p));
+  }
+  Apto::Array<int> dists;
+  
+  // Loop through all of the genotypes in each batch...
   while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
+    const Genome& genotype1_genome = genotype1->GetGenome();
+    ConstInstructionSequencePtr genotype1_seq_p;
+    ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
+    genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
+    const InstructionSequence& genotype1_seq = *genotype1_seq_p;
+    
+    InstructionSequence::FindHammingDistances(genotype1_seq, genotype2_seqs, dists);
+    
+    for (int i = 0; i < genotypes2.GetSize(); i++) {
+      genotype2 = genotypes2[i];
+      
       // Determine the counts...
       const int count1 = genotype1->GetNumCPUs();
       const int count2 = genotype2->GetNumCPUs();
@@ -7348,20 +7391,7 @@ void cAnalyze::CommandHamming(cString cur_string)
         ((count1 - 1) * (count2 - 1)) : (count1 * count2);
       if (num_pairs == 0) continue;
       
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindHammingDistance(genotype1_seq, genotype2_seq);
+      const int dist = dists[i];
       total_dist += dist * num_pairs;
       total_count += num_pairs;
     }
@@ -7415,10 +7445,33 @@ void cAnalyze::CommandLevenstein(cString cur_string)
   tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
   tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
   
+  // Collect the second batch once so each genotype in the first is measured against all of it in one pass
+  Apto::Array<cAnalyzeGenotype*> genotypes2;
+  Apto::Array<ConstInstructionSequencePtr> genotype2_seq_ptrs;
+  Apto::Array<const InstructionSequence*> genotype2_seqs;
+  while ((genotype2 = list2_it.Next()) != NULL) {
+    ConstInstructionSequencePtr genotype2_seq_p;
+    ConstGeneticRepresentationPtr genotype2_rep_p = genotype2->GetGenome().Representation();
+    genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
+    genotypes2.Push(genotype2);
+    genotype2_seq_ptrs.Push(genotype2_seq_p);
+    genotype2_seqs.Push(&(*genotype2_seq_p));
+  }
+  Apto::Array<int> dists;
+  
   // Loop through all of the genotypes in each batch...
   while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
+    const Genome& genotype1_genome = genotype1->GetGenome();
+    ConstInstructionSequencePtr genotype1_seq_p;
+    ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
+    genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
+    const InstructionSequence& genotype1_seq = *genotype1_seq_p;
+    
+    InstructionSequence::FindEditDistances(genotype1_seq, genotype2_seqs, dists);
+    
+    for (int i = 0; i < genotypes2.GetSize(); i++) {
+      genotype2 = genotypes2[i];
+      
       // Determine the counts...
       const int count1 = genotype1->GetNumCPUs();
       const int count2 = genotype2->GetNumCPUs();
@@ -7426,20 +7479,7 @@ void cAnalyze::CommandLevenstein(cString cur_string)
         ((count1 - 1) * (count2 - 1)) : (count1 * count2);
       if (num_pairs == 0) continue;
       
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
+      const int dist = dists[i];
       total_dist += dist * num_pairs;
       total_count += num_pairs;
     }
@@ -7862,8 +7902,9 @@ void cAnalyze::CommandAlign(cString cur_string)
     // Compare each string to the previous.
     cStringUtil::EditDistance(sequences[i], sequences[i-1], diff_info, '_');
     
-    while (diff_info.GetSize() != 0) {
-      cString cur_mut = diff_info.Pop(',');
+    cStringTokenizer muts(diff_info, ',');
+    while (!muts.AtEnd()) {
+      cString cur_mut = muts.Next();
       const char mut_type = cur_mut[0];
       cur_mut.ClipFront(1); cur_mut.ClipEnd(1);
       int position = cur_mut.AsInt();
@@ -33,6 +33,7 @@
 #include "cPhenotype.h"
 #include "cPhenPlastGenotype.h"
 #include "cPlasticPhenotype.h"
+#include "cStringIterator.h"
 #include "cTestCPU.h"
 #include "cEnvironment.h"
 #include "cHardwareManager.h"
@@ -870,11 +871,11 @@ cString cAnalyzeGenotype::GetHTMLSequence() const
   cString text_genome = (const char *)genome_seq.AsString();
   cString html_code("<tt>");
   
-  cString diff_info = parent_muts;
+  cStringTokenizer diff_info(parent_muts, ',');
   char mut_type = 'N';
   int mut_pos = -1;
   
-  cString cur_mut = diff_info.Pop(',');
+  cString cur_mut = diff_info.Next();
   if (cur_mut != "") {
     mut_type = cur_mut[0];
     cur_mut.ClipFront(1); cur_mut.ClipEnd(1);
@@ -900,7 +901,7 @@ cString cAnalyzeGenotype::GetHTMLSequence() const
       }
       
       // Move on to the next mutation...
-      cur_mut = diff_info.Pop(',');
+      cur_mut = diff_info.Next();
       if (cur_mut != "") {
         mut_type = cur_mut[0];
         cur_mut.ClipFront(1); cur_mut.ClipEnd(1);
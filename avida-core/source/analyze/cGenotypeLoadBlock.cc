@@ -0,0 +1,50 @@
+/*
+ *  cGenotypeLoadBlock.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGenotypeLoadBlock.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cMappedTextFile.h"
+#include "cStringUtil.h"
+#include "tDataEntryCommand.h"
+
+
+void cGenotypeLoadBlock::Load(cAvidaContext&)
+{
+  const int num_commands = m_commands.GetSize();
+  Apto::Array<cMappedTextFile::sField> fields(num_commands);
+
+  for (int line_id = m_line_begin; line_id < m_line_end; line_id++) {
+    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, m_default_genome);
+
+    // Missing trailing columns read as empty, as PopWord on an exhausted line would give
+    const int num_fields = (num_commands) ? m_file.GetFields(line_id, &fields[0], num_commands) : 0;
+    for (int i = 0; i < num_commands; i++) {
+      if (i < num_fields) m_commands[i]->SetValue(genotype, cString(fields[i].begin, fields[i].size));
+      else m_commands[i]->SetValue(genotype, "");
+    }
+
+    // Give this genotype a name.  Base it on the ID if possible.
+    const int name_id = (m_id_inc) ? genotype->GetID() : line_id;
+    genotype->SetName(cStringUtil::Stringf("org-%d", name_id));
+
+    m_genotypes[line_id] = genotype;
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ *  cGenotypeLoadBlock.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGenotypeLoadBlock_h
+#define cGenotypeLoadBlock_h
+
+#include "apto/core.h"
+
+#include "avida/core/Genome.h"
+
+class cAnalyzeGenotype;
+class cAvidaContext;
+class cMappedTextFile;
+class cWorld;
+template <class T> class tDataEntryCommand;
+
+using namespace Avida;
+
+
+// cGenotypeLoadBlock - builds the genotypes for a contiguous block of lines of a loaded genotype file
+
+class cGenotypeLoadBlock
+{
+public:
+  enum { BLOCK_SIZE = 256 };
+
+private:
+  cWorld* m_world;
+  const cMappedTextFile& m_file;
+  const Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*>& m_commands;
+  const Genome& m_default_genome;
+  bool m_id_inc;
+  Apto::Array<cAnalyzeGenotype*>& m_genotypes;
+  int m_line_begin;
+  int m_line_end;
+
+public:
+  cGenotypeLoadBlock(cWorld* world, const cMappedTextFile& file,
+                     const Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*>& commands, const Genome& default_genome,
+                     bool id_inc, Apto::Array<cAnalyzeGenotype*>& genotypes, int line_begin, int line_end)
+    : m_world(world), m_file(file), m_commands(commands), m_default_genome(default_genome), m_id_inc(id_inc)
+    , m_genotypes(genotypes), m_line_begin(line_begin), m_line_end(line_end) { ; }
+
+  // Fills genotypes[line] for each line of the block
+  void Load(cAvidaContext& ctx);
+};
+
+#endif
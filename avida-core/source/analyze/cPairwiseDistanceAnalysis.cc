@@ -0,0 +1,99 @@
+/*
+ *  cPairwiseDistanceAnalysis.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cPairwiseDistanceAnalysis.h"
+
+#include "cAnalyzeJobQueue.h"
+#include "tAnalyzeJobBatch.h"
+
+
+cPairwiseDistanceAnalysis::cPairwiseDistanceAnalysis(cAnalyzeJobQueue& queue, const Apto::Array<const InstructionSequence*>& seqs,
+                                                     eMetric metric, int max_dist, int tile_size)
+  : m_queue(queue), m_seqs(seqs), m_metric(metric), m_max_dist(max_dist), m_tile_size(tile_size), m_visitor(NULL)
+{
+  assert(m_tile_size > 0);
+}
+
+
+void cPairwiseDistanceAnalysis::Run(cVisitor& visitor)
+{
+  const int num_seqs = m_seqs.GetSize();
+  if (num_seqs < 2) return;
+
+  m_visitor = &visitor;
+
+  // Queue the tiles on and above the diagonal; diagonal tiles only fill their upper half
+  Apto::Array<cTile*> tiles;
+  tAnalyzeJobBatch<cTile> jobbatch(m_queue);
+  for (int row = 0; row < num_seqs; row += m_tile_size) {
+    const int row_end = Apto::Min(row + m_tile_size, num_seqs);
+    for (int col = row; col < num_seqs; col += m_tile_size) {
+      cTile* tile = new cTile(this, row, row_end, col, Apto::Min(col + m_tile_size, num_seqs));
+      tiles.Push(tile);
+      jobbatch.AddJob(tile, &cTile::Calculate);
+    }
+  }
+  jobbatch.RunBatch();
+
+  for (int i = 0; i < tiles.GetSize(); i++) delete tiles[i];
+  m_visitor = NULL;
+}
+
+
+void cPairwiseDistanceAnalysis::visitTile(cTile& tile)
+{
+  Apto::MutexAutoLock lock(m_visit_mutex);
+  m_visitor->VisitTile(tile);
+}
+
+
+void cPairwiseDistanceAnalysis::cTile::Calculate(cAvidaContext&)
+{
+  const Apto::Array<const InstructionSequence*>& seqs = m_analysis->m_seqs;
+  const int num_cols = m_col_end - m_col_begin;
+
+  m_dists.ResizeClear((m_row_end - m_row_begin) * num_cols);
+  m_dists.SetAll(0);
+
+  Apto::Array<const InstructionSequence*> cols;
+  Apto::Array<int> row_dists;
+  for (int row = m_row_begin; row < m_row_end; row++) {
+    // Only columns past the row are needed; on diagonal tiles that is a shrinking suffix
+    const int first_col = Apto::Max(m_col_begin, row + 1);
+    if (first_col >= m_col_end) continue;
+
+    cols.Resize(0);
+    for (int col = first_col; col < m_col_end; col++) cols.Push(seqs[col]);
+
+    if (m_analysis->m_metric == HAMMING_DISTANCE) {
+      InstructionSequence::FindHammingDistances(*seqs[row], cols, row_dists);
+    } else {
+      InstructionSequence::FindEditDistances(*seqs[row], cols, row_dists, m_analysis->m_max_dist);
+    }
+
+    int* out = &m_dists[(row - m_row_begin) * num_cols + (first_col - m_col_begin)];
+    for (int i = 0; i < row_dists.GetSize(); i++) out[i] = row_dists[i];
+  }
+
+  m_analysis->visitTile(*this);
+
+  // The visitor is done with these, so don't hold every tile's distances until the batch finishes
+  m_dists.Resize(0);
+}
@@ -0,0 +1,113 @@
+/*
+ *  cPairwiseDistanceAnalysis.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cPairwiseDistanceAnalysis_h
+#define cPairwiseDistanceAnalysis_h
+
+#include "apto/core.h"
+#include "apto/platform.h"
+
+#include "avida/core/InstructionSequence.h"
+
+class cAnalyzeJobQueue;
+class cAvidaContext;
+
+using namespace Avida;
+
+
+// cPairwiseDistanceAnalysis - all-pairs genetic distance over the analyze job queue
+//
+//   The upper triangle of the distance matrix is cut into square tiles, each of which is one job.  Every row of a
+//   tile builds its edit distance pattern once and runs it against all of the tile's columns.  Finished tiles are
+//   handed to a visitor one at a time, so visitors need no locking of their own and the full matrix is never held.
+
+class cPairwiseDistanceAnalysis
+{
+public:
+  enum eMetric { HAMMING_DISTANCE, EDIT_DISTANCE };
+
+  class cTile;
+
+  class cVisitor
+  {
+  public:
+    virtual ~cVisitor() { ; }
+
+    // Called once for each tile, never concurrently with another call
+    virtual void VisitTile(const cTile& tile) = 0;
+  };
+
+  class cTile
+  {
+    friend class cPairwiseDistanceAnalysis;
+  private:
+    cPairwiseDistanceAnalysis* m_analysis;
+    int m_row_begin;
+    int m_row_end;
+    int m_col_begin;
+    int m_col_end;
+    Apto::Array<int> m_dists;
+
+    cTile(cPairwiseDistanceAnalysis* analysis, int row_begin, int row_end, int col_begin, int col_end)
+      : m_analysis(analysis), m_row_begin(row_begin), m_row_end(row_end), m_col_begin(col_begin), m_col_end(col_end) { ; }
+
+  public:
+    void Calculate(cAvidaContext& ctx);
+
+    inline int GetRowBegin() const { return m_row_begin; }
+    inline int GetRowEnd() const { return m_row_end; }
+    inline int GetColBegin() const { return m_col_begin; }
+    inline int GetColEnd() const { return m_col_end; }
+
+    // Only pairs with row < col are calculated
+    inline bool HasPair(int row, int col) const { return row < col; }
+    inline int GetDistance(int row, int col) const
+    {
+      assert(row >= m_row_begin && row < m_row_end && col >= m_col_begin && col < m_col_end && row < col);
+      return m_dists[(row - m_row_begin) * (m_col_end - m_col_begin) + (col - m_col_begin)];
+    }
+  };
+
+private:
+  cAnalyzeJobQueue& m_queue;
+  const Apto::Array<const InstructionSequence*>& m_seqs;
+  eMetric m_metric;
+  int m_max_dist;
+  int m_tile_size;
+
+  cVisitor* m_visitor;
+  Apto::Mutex m_visit_mutex;
+
+
+  void visitTile(cTile& tile);
+
+  cPairwiseDistanceAnalysis(); // @not_implemented
+  cPairwiseDistanceAnalysis(const cPairwiseDistanceAnalysis&); // @not_implemented
+  cPairwiseDistanceAnalysis& operator=(const cPairwiseDistanceAnalysis&); // @not_implemented
+
+public:
+  // A non-negative max_dist turns edit distances into threshold queries; any pair beyond it reports max_dist + 1
+  cPairwiseDistanceAnalysis(cAnalyzeJobQueue& queue, const Apto::Array<const InstructionSequence*>& seqs,
+                            eMetric metric = EDIT_DISTANCE, int max_dist = -1, int tile_size = 64);
+
+  void Run(cVisitor& visitor);
+};
+
+#endif
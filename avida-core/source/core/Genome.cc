@@ -35,17 +35,17 @@
 #include "cInitFile.h"
 #include "cStringUtil.h"
 
-static Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
+static const PropertyKey s_prop_id_instset("instset");
 static PropertyDescriptionMap s_prop_desc_map;
 
 void cHardwareManager::Initialize()
 {
-  s_prop_desc_map.Set(s_prop_id_instset, "Instruction Set");
+  s_prop_desc_map.Set(s_prop_id_instset.ID(), "Instruction Set");
 }
 
 void cHardwareManager::SetupPropertyMap(PropertyMap& props, const Apto::String& instset)
 {
-  props.Define(PropertyPtr(new StringProperty(s_prop_id_instset, s_prop_desc_map, instset)));
+  props.Define(PropertyPtr(new StringProperty(s_prop_id_instset.ID(), s_prop_desc_map, instset)));
 }
 
 
@@ -133,24 +133,40 @@ bool Avida::Genome::LegacySave(void* dfp) const
 
 
 
-Avida::Genome::InstSetPropertyMap::InstSetPropertyMap() : m_inst_set(s_prop_id_instset, s_prop_desc_map, Apto::String("")) { ; }
+Avida::Genome::InstSetPropertyMap::InstSetPropertyMap() : m_inst_set(s_prop_id_instset.ID(), s_prop_desc_map, Apto::String("")) { ; }
 Avida::Genome::InstSetPropertyMap::~InstSetPropertyMap() { ; }
 
 int Avida::Genome::InstSetPropertyMap::GetSize() const { return 1; }
-bool Avida::Genome::InstSetPropertyMap::Has(const PropertyID& p_id) const { return (p_id == s_prop_id_instset); }
+bool Avida::Genome::InstSetPropertyMap::Has(const PropertyID& p_id) const { return (p_id == s_prop_id_instset.ID()); }
+bool Avida::Genome::InstSetPropertyMap::Has(const PropertyKey& p_key) const { return (p_key.Slot() == s_prop_id_instset.Slot()); }
 
 const Avida::Property& Avida::Genome::InstSetPropertyMap::Get(const PropertyID& p_id) const
 {
   assert(p_id.GetSize() == 7);
-  if (p_id == s_prop_id_instset) return m_inst_set;
+  if (p_id == s_prop_id_instset.ID()) return m_inst_set;
 
   return *s_default_prop;
 }
 
+const Avida::Property& Avida::Genome::InstSetPropertyMap::Get(const PropertyKey& p_key) const
+{
+  if (p_key.Slot() == s_prop_id_instset.Slot()) return m_inst_set;
+  
+  return *s_default_prop;
+}
+
 
 bool Avida::Genome::InstSetPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value)
 {
-  if (p_id == s_prop_id_instset) {
+  if (p_id == s_prop_id_instset.ID()) {
+    return m_inst_set.SetValue(prop_value);
+  }
+  return false;
+}
+
+bool Avida::Genome::InstSetPropertyMap::SetValue(const PropertyKey& p_key, const Apto::String& prop_value)
+{
+  if (p_key.Slot() == s_prop_id_instset.Slot()) {
     return m_inst_set.SetValue(prop_value);
   }
   return false;
@@ -173,7 +189,7 @@ bool Avida::Genome::InstSetPropertyMap::Remove(const PropertyID& p_id) { return
 Avida::ConstPropertyIDSetPtr Avida::Genome::InstSetPropertyMap::PropertyIDs() const
 {
   PropertyIDSetPtr pidset(new PropertyIDSet);
-  pidset->Insert(s_prop_id_instset);
+  pidset->Insert(s_prop_id_instset.ID());
   return pidset;
 }
 
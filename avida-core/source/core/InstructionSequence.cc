@@ -26,6 +26,8 @@
 
 #include "AvidaTools.h"
 
+#include <cstring>
+
 using namespace AvidaTools;
 
 
@@ -34,15 +36,179 @@ const double MEMORY_INCREASE_FACTOR = 1.5;
 const double MEMORY_SHRINK_TEST_FACTOR = 4.0;
 
 
+namespace {
+  typedef unsigned long long SiteWord;
+  
+  const int SITE_WORD_BITS = 64;
+  const SiteWord SITE_WORD_HIGH_BIT = 1ULL << (SITE_WORD_BITS - 1);
+  const SiteWord SITE_BYTE_LOW_BITS = 0x7F7F7F7F7F7F7F7FULL;
+  const SiteWord SITE_BYTE_HIGH_BITS = 0x8080808080808080ULL;
+  const int NUM_SYMBOLS = 256;
+  const int LOCAL_PATTERN_WORDS = 256;
+  
+  inline int countWordBits(SiteWord x)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+  
+  // Count differing sites between two runs of n instructions, eight sites per word compare
+  int countSiteMismatches(const Avida::Instruction* seq1, const Avida::Instruction* seq2, int n)
+  {
+    int mismatches = 0;
+    int i = 0;
+    
+    if (sizeof(Avida::Instruction) == 1) {
+      const unsigned char* bytes1 = reinterpret_cast<const unsigned char*>(seq1);
+      const unsigned char* bytes2 = reinterpret_cast<const unsigned char*>(seq2);
+      for (; i + 8 <= n; i += 8) {
+        SiteWord word1, word2;
+        memcpy(&word1, bytes1 + i, sizeof(SiteWord));
+        memcpy(&word2, bytes2 + i, sizeof(SiteWord));
+        
+        // Set the high bit of every byte that differs, then count them
+        SiteWord diff = word1 ^ word2;
+        diff = (((diff & SITE_BYTE_LOW_BITS) + SITE_BYTE_LOW_BITS) | diff) & SITE_BYTE_HIGH_BITS;
+        mismatches += countWordBits(diff);
+      }
+    }
+    
+    for (; i < n; i++) if (seq1[i] != seq2[i]) mismatches++;
+    
+    return mismatches;
+  }
+  
+  
+  // EditPattern - bit-parallel (Myers/Hyyro) Levenshtein distance from a fixed pattern to any number of texts.
+  //   Each pattern site is a bit in a run of 64 bit blocks, with one match mask per distinct instruction in the
+  //   pattern.  Instructions absent from the pattern all share a single empty mask.
+  class EditPattern
+  {
+  private:
+    int m_size;
+    int m_blocks;
+    int m_sym_row[NUM_SYMBOLS];
+    SiteWord* m_masks;
+    SiteWord* m_pos_v;  // vertical deltas of +1 in the current column
+    SiteWord* m_neg_v;  // vertical deltas of -1 in the current column
+    
+    SiteWord m_local_words[LOCAL_PATTERN_WORDS];
+    Apto::Array<SiteWord> m_heap_words;
+    
+    EditPattern(); // @not_implemented
+    EditPattern(const EditPattern&); // @not_implemented
+    EditPattern& operator=(const EditPattern&); // @not_implemented
+    
+  public:
+    EditPattern(const Avida::Instruction* sites, int size);
+    
+    // A non-negative max_dist stops as soon as the distance must exceed it, returning max_dist + 1
+    int Distance(const Avida::Instruction* text, int text_size, int max_dist = -1);
+  };
+  
+  EditPattern::EditPattern(const Avida::Instruction* sites, int size)
+    : m_size(size), m_blocks((size + SITE_WORD_BITS - 1) / SITE_WORD_BITS)
+  {
+    assert(size > 0);
+    
+    // Row zero is the empty mask, every other row belongs to an instruction present in the pattern
+    for (int i = 0; i < NUM_SYMBOLS; i++) m_sym_row[i] = 0;
+    int num_rows = 1;
+    for (int i = 0; i < size; i++) {
+      const int op = sites[i].GetOp();
+      if (m_sym_row[op] == 0) m_sym_row[op] = num_rows++;
+    }
+    
+    const int num_words = (num_rows + 2) * m_blocks;
+    if (num_words <= LOCAL_PATTERN_WORDS) {
+      m_masks = m_local_words;
+    } else {
+      m_heap_words.ResizeClear(num_words);
+      m_masks = &m_heap_words[0];
+    }
+    m_pos_v = m_masks + num_rows * m_blocks;
+    m_neg_v = m_pos_v + m_blocks;
+    
+    for (int i = 0; i < num_rows * m_blocks; i++) m_masks[i] = 0;
+    for (int i = 0; i < size; i++) {
+      m_masks[m_sym_row[sites[i].GetOp()] * m_blocks + i / SITE_WORD_BITS] |= 1ULL << (i % SITE_WORD_BITS);
+    }
+  }
+  
+  int EditPattern::Distance(const Avida::Instruction* text, int text_size, int max_dist)
+  {
+    if (max_dist >= 0 && abs(m_size - text_size) > max_dist) return max_dist + 1;
+    
+    // Column zero is the distance from nothing, increasing by one down every row
+    for (int b = 0; b < m_blocks; b++) {
+      m_pos_v[b] = ~0ULL;
+      m_neg_v[b] = 0;
+    }
+    
+    const int last_block = m_blocks - 1;
+    const SiteWord last_bit = 1ULL << ((m_size - 1) % SITE_WORD_BITS);
+    int score = m_size;
+    
+    for (int j = 0; j < text_size; j++) {
+      const SiteWord* eq_row = m_masks + m_sym_row[text[j].GetOp()] * m_blocks;
+      
+      // The top row always grows by one per column; each block hands its bottom horizontal delta to the next
+      int h_in = 1;
+      for (int b = 0; b < m_blocks; b++) {
+        const SiteWord pv = m_pos_v[b];
+        const SiteWord mv = m_neg_v[b];
+        const SiteWord h_in_neg = (h_in < 0) ? 1 : 0;
+        SiteWord eq = eq_row[b];
+        
+        const SiteWord xv = eq | mv;
+        eq |= h_in_neg;
+        const SiteWord xh = (((eq & pv) + pv) ^ pv) | eq;
+        SiteWord ph = mv | ~(xh | pv);
+        SiteWord mh = pv & xh;
+        
+        const SiteWord out_bit = (b == last_block) ? last_bit : SITE_WORD_HIGH_BIT;
+        int h_out = 0;
+        if (ph & out_bit) h_out = 1;
+        else if (mh & out_bit) h_out = -1;
+        
+        ph <<= 1;
+        mh <<= 1;
+        mh |= h_in_neg;
+        if (h_in > 0) ph |= 1;
+        
+        m_pos_v[b] = mh | ~(xv | ph);
+        m_neg_v[b] = ph & xv;
+        h_in = h_out;
+      }
+      
+      // h_in now holds the change along the bottom row, which is the running distance
+      score += h_in;
+      
+      // Each remaining column can lower the bottom row by at most one
+      if (max_dist >= 0 && score - (text_size - j - 1) > max_dist) return max_dist + 1;
+    }
+    
+    return score;
+  }
+}
+
+
 Avida::InstructionSequence::InstructionSequence(const InstructionSequence& seq)
-: GeneticRepresentation(seq), m_seq(seq.GetSize()), m_active_size(seq.GetSize())
+: GeneticRepresentation(seq), m_buf(seq.m_buf), m_active_size(seq.GetSize())
 {
-  for (int i = 0; i < m_active_size; i++)  m_seq[i] = seq[i];
+  // Sites are shared with seq until either side is modified
 }
 
-Avida::InstructionSequence::InstructionSequence(const Apto::String& str)
+Avida::InstructionSequence::InstructionSequence(const Apto::String& str) : m_buf(new SiteBuffer)
 {
-  m_seq.ResizeClear(str.GetSize());
+  Apto::Array<Instruction>& cur_sites = m_buf->sites;
+  cur_sites.ResizeClear(str.GetSize());
   int size = 0;
   for (int i = 0; i < str.GetSize(); i++) {
     if (str[i] == '_') continue;
@@ -51,16 +217,16 @@ Avida::InstructionSequence::InstructionSequence(const Apto::String& str)
       case '-':
       case '~':
       case '?':
-        if (!m_seq[size].SetSymbol(str.Substring(i, 2))) continue;
+        if (!cur_sites[size].SetSymbol(str.Substring(i, 2))) continue;
         i++;
         break;
       default:
-        if (!m_seq[size].SetSymbol(str.Substring(i, 1))) continue;
+        if (!cur_sites[size].SetSymbol(str.Substring(i, 1))) continue;
     }
     size++;
   }
   m_active_size = size;
-  m_seq.Resize(size);
+  cur_sites.Resize(size);
 }
 
 Avida::InstructionSequence::~InstructionSequence() { ; }
@@ -149,6 +315,11 @@ bool Avida::Instruction::SetSymbol(const Apto::String& symbol)
 
 
 
+void Avida::InstructionSequence::detachSites()
+{
+  m_buf = SiteBufferPtr(new SiteBuffer(*m_buf));
+}
+
 void Avida::InstructionSequence::adjustCapacity(int new_size)
 {
   assert(new_size > 0);
@@ -156,14 +327,14 @@ void Avida::InstructionSequence::adjustCapacity(int new_size)
   // Make sure we're really changing the size...
   if (new_size == m_active_size) return;
   
-  const int array_size = m_seq.GetSize();
+  const int array_size = m_buf->sites.GetSize();
   
   // Determine if we need to adjust the allocated array sizes...
   if (new_size > array_size || new_size * MEMORY_SHRINK_TEST_FACTOR < array_size) {
     int new_array_size = (int) (new_size * MEMORY_INCREASE_FACTOR);
     const int new_array_min = new_size + MEMORY_INCREASE_MINIMUM;
 		if (new_array_min > new_array_size) new_array_size = new_array_min;
-    m_seq.Resize(new_array_size);
+    sites().Resize(new_array_size);
   }
   
   // And just change the m_active_size once we're sure it will be in range.
@@ -181,7 +352,8 @@ void Avida::InstructionSequence::prepareInsert(int pos, int num_sites)
   adjustCapacity(new_size);
   
   // Shift any sites needed...
-  for (int i = old_size - 1; i >= pos; i--) m_seq[i + num_sites] = m_seq[i];
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = old_size - 1; i >= pos; i--) cur_sites[i + num_sites] = cur_sites[i];
 }
 
 
@@ -189,7 +361,8 @@ void Avida::InstructionSequence::Copy(int to, int from)
 {
   assert(to   >= 0   && to   < m_active_size);
   assert(from >= 0   && from < m_active_size);
-  m_seq[to] = m_seq[from];
+  Apto::Array<Instruction>& cur_sites = sites();
+  cur_sites[to] = cur_sites[from];
 }
  
 
@@ -197,7 +370,7 @@ void Avida::InstructionSequence::Copy(int to, int from)
 Apto::String Avida::InstructionSequence::AsString() const
 {
   Apto::StringBuffer out_string;
-  for (int i = 0; i < m_active_size; i++) out_string += m_seq[i].GetSymbol();
+  for (int i = 0; i < m_active_size; i++) out_string += m_buf->sites[i].GetSymbol();
 
   return Apto::String(out_string);
 }
@@ -223,25 +396,27 @@ void Avida::InstructionSequence::Resize(int new_size)
   const int old_size = m_active_size;
   adjustCapacity(new_size);
   
-  for (int i = old_size; i < new_size; i++) m_seq[i].SetOp(0);
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = old_size; i < new_size; i++) cur_sites[i].SetOp(0);
 }
 
 void Avida::InstructionSequence::Insert(int pos, const Instruction& inst)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
   
   prepareInsert(pos, 1);
-  m_seq[pos] = inst;
+  sites()[pos] = inst;
 }
 
 void Avida::InstructionSequence::Insert(int pos, const InstructionSequence& seq)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
   
   prepareInsert(pos, seq.GetSize());
-  for (int i = 0; i < seq.GetSize(); i++) m_seq[i + pos] = seq[i];
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = 0; i < seq.GetSize(); i++) cur_sites[i + pos] = seq[i];
 }
 
 void Avida::InstructionSequence::Remove(int pos, int num_sites)
@@ -251,7 +426,8 @@ void Avida::InstructionSequence::Remove(int pos, int num_sites)
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of sequence
   
   const int new_size = m_active_size - num_sites;
-  for (int i = pos; i < new_size; i++) m_seq[i] = m_seq[i + num_sites];
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = pos; i < new_size; i++) cur_sites[i] = cur_sites[i + num_sites];
   adjustCapacity(new_size);
 }
 
@@ -268,7 +444,8 @@ void Avida::InstructionSequence::Replace(int pos, int num_sites, const Instructi
   else if (size_change < 0) Remove(pos, -size_change);
   
   // Now just copy everything over!
-  for (int i = 0; i < seq.GetSize(); i++) m_seq[i + pos] = seq[i];
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = 0; i < seq.GetSize(); i++) cur_sites[i + pos] = seq[i];
 }
 
 
@@ -345,11 +522,9 @@ void Avida::InstructionSequence::Rotate(int n)
 
 void Avida::InstructionSequence::operator=(const InstructionSequence& other_seq)
 {
+  // Share the other sequence's sites; whichever side is modified first takes its own copy
+  m_buf = other_seq.m_buf;
   m_active_size = other_seq.m_active_size;
-  m_seq.ResizeClear(m_active_size);
-  
-  // Now that both code arrays are the same size, copy the other one over
-  for (int i = 0; i < m_active_size; i++) m_seq[i] = other_seq[i];
 }
 
 
@@ -363,7 +538,7 @@ bool Avida::InstructionSequence::operator==(const GeneticRepresentation& other_s
   
   // Then go through line by line.
   for (int i = 0; i < m_active_size; i++)
-    if (m_seq[i] != (*seq)[i]) return false;
+    if (m_buf->sites[i] != (*seq)[i]) return false;
   
   return true;
 }
@@ -373,7 +548,7 @@ int Avida::InstructionSequence::FindInst(const Instruction& inst, int start_inde
 {
   assert(start_index < m_active_size);  // Starting search after sequence end.
   
-  for(int i = start_index; i < m_active_size; i++) if (m_seq[i] == inst) return i;
+  for(int i = start_index; i < m_active_size; i++) if (m_buf->sites[i] == inst) return i;
   
   // Search failed
   return -1;  
@@ -383,7 +558,7 @@ int Avida::InstructionSequence::FindInst(const Instruction& inst, int start_inde
 int Avida::InstructionSequence::CountInst(const Instruction& inst) const
 {
   int count = 0;
-  for (int i = 0; i < m_active_size; i++) if (m_seq[i] == inst) count++;
+  for (int i = 0; i < m_active_size; i++) if (m_buf->sites[i] == inst) count++;
   return count;  
 }
 
@@ -436,7 +611,7 @@ Avida::InstructionSequence Avida::InstructionSequence::Crop(int start, int end)
   
   const int out_length = end - start;
   InstructionSequence out_seq(out_length);
-  for (int i = 0; i < out_length; i++) out_seq[i] = m_seq[i+start];
+  for (int i = 0; i < out_length; i++) out_seq[i] = m_buf->sites[i+start];
   
   return out_seq;
 }
@@ -454,8 +629,8 @@ Avida::InstructionSequence Avida::InstructionSequence::Cut(int start, int end) c
   assert(out_length > 0);             // Can't cut everything!
   
   InstructionSequence out_seq(out_length);
-  for (int i = 0; i < start; i++) out_seq[i] = m_seq[i];
-  for (int i = start; i < out_length; i++) out_seq[i] = m_seq[i + cut_length];
+  for (int i = 0; i < start; i++) out_seq[i] = m_buf->sites[i];
+  for (int i = start; i < out_length; i++) out_seq[i] = m_buf->sites[i + cut_length];
   
   return out_seq;
 }  
@@ -495,15 +670,21 @@ int Avida::InstructionSequence::FindHammingDistance(const InstructionSequence& s
   
   int hamming_distance = seq1.GetSize() + seq2.GetSize() - 2 * overlap;
   
-  // Cycle through the overlap adding all differences to the distance.
-  for (int i = 0; i < overlap; i++) {
-    if (seq1[start1 + i] != seq2[start2 + i])  hamming_distance++;
-  }
+  // Add all differences within the overlap to the distance.
+  if (overlap > 0) hamming_distance += countSiteMismatches(&seq1[start1], &seq2[start2], overlap);
   
   return hamming_distance;
 }
 
 
+void Avida::InstructionSequence::FindHammingDistances(const InstructionSequence& seq, const Apto::Array<const InstructionSequence*>& others,
+                                                      Apto::Array<int>& distances)
+{
+  distances.ResizeClear(others.GetSize());
+  for (int i = 0; i < others.GetSize(); i++) distances[i] = FindHammingDistance(seq, *others[i]);
+}
+
+
 int Avida::InstructionSequence::FindBestOffset(const InstructionSequence& seq1, const InstructionSequence& seq2)
 {
   const int size1 = seq1.GetSize();
@@ -544,14 +725,17 @@ int Avida::InstructionSequence::FindSlidingDistance(const InstructionSequence& s
 }
 
 
-int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
+int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist)
 {
   const int size1 = seq1.GetSize();
   const int size2 = seq2.GetSize();
   const int min_size = (size1 < size2) ? size1 : size2;
   
   // If either size is zero, return the other one!
-  if (!min_size) return (size1 > size2) ? size1 : size2;
+  if (!min_size) {
+    const int dist = (size1 > size2) ? size1 : size2;
+    return (max_dist >= 0 && dist > max_dist) ? max_dist + 1 : dist;
+  }
   
   // Count how many direct matches we have at the front and end.
   int match_front = 0, match_end = 0;
@@ -562,52 +746,38 @@ int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1
   const int test_size1 = size1 - match_front - match_end;
   const int test_size2 = size2 - match_front - match_end;
   
-  if (test_size1 <= 0 || test_size2 <=0) return abs(test_size1 - test_size2);
+  if (test_size1 <= 0 || test_size2 <=0) {
+    const int dist = abs(test_size1 - test_size2);
+    return (max_dist >= 0 && dist > max_dist) ? max_dist + 1 : dist;
+  }
   
   // Now match everything else...
-  int* cur_row  = new int[test_size1];  // The row we are calculating
-  int* prev_row = new int[test_size1];  // The last row we calculated
-  
-  // Initialize the previous row to record the differece from nothing.
-  for (int i = 0; i < test_size1; i++)  prev_row[i] = i + 1;
+  EditPattern pattern(&seq1[match_front], test_size1);
+  return pattern.Distance(&seq2[match_front], test_size2, max_dist);
+}
+
+
+void Avida::InstructionSequence::FindEditDistances(const InstructionSequence& seq, const Apto::Array<const InstructionSequence*>& others,
+                                                   Apto::Array<int>& distances, int max_dist)
+{
+  distances.ResizeClear(others.GetSize());
   
-  // Loop through each subsequent character in the test code
-  for (int i = 0; i < test_size2; i++) {
-    // Initialize the first entry in cur_row.
-    if (seq1[match_front] == seq2[match_front + i]) cur_row[0] = i;
-    else cur_row[0] = (i < prev_row[0]) ? (i+1) : (prev_row[0] + 1);
-    
-    // Move down the cur_row and fill it out.
-    for (int j = 1; j < test_size1; j++) {
-      // If the values are equal, keep the value in the upper left.
-      if (seq1[match_front + j] == seq2[match_front + i]) {
-        cur_row[j] = prev_row[j-1];
-      }
-      
-      // Otherwise, set the current position the the minimal of the three
-      // numbers above (insertion), to the left (deletion), or upper left
-      // (mutation) in the chart, plus one.
-      else {
-        cur_row[j] = (prev_row[j] < prev_row[j-1]) ? prev_row[j] : prev_row[j-1];
-        if (cur_row[j-1] < cur_row[j]) cur_row[j] = cur_row[j-1];
-        cur_row[j]++;
-      }
+  if (seq.GetSize() == 0) {
+    for (int i = 0; i < others.GetSize(); i++) {
+      const int dist = others[i]->GetSize();
+      distances[i] = (max_dist >= 0 && dist > max_dist) ? max_dist + 1 : dist;
     }
-    
-    // Swap cur_row and prev_row. (we only really need to move the cur row
-    // over to prev, but this saves us from having to keep re-allocating
-    // new rows.  We recycle!
-    int* temp_row = cur_row;
-    cur_row = prev_row;
-    prev_row = temp_row;
+    return;
   }
   
-  // Now that we are done, return the bottom-right corner of the chart.
-  
-  const int value = prev_row[test_size1 - 1];
-  
-  delete [] cur_row;
-  delete [] prev_row;
-  
-  return value;
+  // Build the pattern masks once and stream every other sequence through them
+  EditPattern pattern(&seq[0], seq.GetSize());
+  for (int i = 0; i < others.GetSize(); i++) {
+    const InstructionSequence& other = *others[i];
+    if (other.GetSize()) {
+      distances[i] = pattern.Distance(&other[0], other.GetSize(), max_dist);
+    } else {
+      distances[i] = (max_dist >= 0 && seq.GetSize() > max_dist) ? max_dist + 1 : seq.GetSize();
+    }
+  }
 }
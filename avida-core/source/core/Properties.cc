@@ -27,6 +27,49 @@
 
 Avida::PropertyTypeID Avida::Property::Null = "null";
 
+
+// PropertyKey
+// --------------------------------------------------------------------------------------------------------------  
+
+namespace {
+  struct PropertyKeyRegistry
+  {
+    Apto::Mutex mutex;
+    Apto::Map<Apto::String, int> slots;
+  };
+  
+  // Constructed on first use, since keys are commonly interned during static initialization
+  PropertyKeyRegistry& propertyKeyRegistry()
+  {
+    static PropertyKeyRegistry s_registry;
+    return s_registry;
+  }
+};
+
+int Avida::PropertyKey::Intern(const PropertyID& p_id)
+{
+  PropertyKeyRegistry& registry = propertyKeyRegistry();
+  Apto::MutexAutoLock lock(registry.mutex);
+  
+  int slot_id = -1;
+  if (!registry.slots.Get(p_id, slot_id)) {
+    slot_id = registry.slots.GetSize();
+    registry.slots.Set(Apto::String((const char*)p_id), slot_id);
+  }
+  return slot_id;
+}
+
+int Avida::PropertyKey::Lookup(const PropertyID& p_id)
+{
+  PropertyKeyRegistry& registry = propertyKeyRegistry();
+  Apto::MutexAutoLock lock(registry.mutex);
+  
+  int slot_id = -1;
+  if (!registry.slots.Get(p_id, slot_id)) return -1;
+  return slot_id;
+}
+
+
 Avida::Property::~Property() { ; }
 
 
@@ -92,6 +135,24 @@ Avida::PropertyPtr Avida::PropertyMap::s_default_prop(new StringProperty("", Pro
 
 Avida::PropertyMap::~PropertyMap() { ; }
 
+bool Avida::PropertyMap::Has(const PropertyKey& p_key) const { return Has(PropertyID(p_key.ID())); }
+const Avida::Property& Avida::PropertyMap::Get(const PropertyKey& p_key) const { return Get(PropertyID(p_key.ID())); }
+
+bool Avida::PropertyMap::SetValue(const PropertyKey& p_key, const Apto::String& prop_value)
+{
+  return SetValue(PropertyID(p_key.ID()), prop_value);
+}
+
+bool Avida::PropertyMap::SetValue(const PropertyKey& p_key, const int prop_value)
+{
+  return SetValue(PropertyID(p_key.ID()), prop_value);
+}
+
+bool Avida::PropertyMap::SetValue(const PropertyKey& p_key, const double prop_value)
+{
+  return SetValue(PropertyID(p_key.ID()), prop_value);
+}
+
 
 // HashPropertyMap
 // --------------------------------------------------------------------------------------------------------------
@@ -181,3 +242,158 @@ bool Avida::HashPropertyMap::Serialize(ArchivePtr) const
   assert(false);
   return false;
 }
+
+
+
+// SlotPropertyMap
+// --------------------------------------------------------------------------------------------------------------
+
+Avida::SlotPropertyMap::~SlotPropertyMap() { ; }
+
+int Avida::SlotPropertyMap::GetSize() const { return m_keys.GetSize(); }
+
+bool Avida::SlotPropertyMap::Has(const PropertyID& p_id) const { return (findID(p_id) >= 0); }
+bool Avida::SlotPropertyMap::Has(const PropertyKey& p_key) const { return (findSlot(p_key.Slot()) >= 0); }
+
+const Avida::Property& Avida::SlotPropertyMap::Get(const PropertyID& p_id) const
+{
+  const int idx = findID(p_id);
+  return (idx >= 0) ? *m_props[idx] : *s_default_prop;
+}
+
+const Avida::Property& Avida::SlotPropertyMap::Get(const PropertyKey& p_key) const
+{
+  const int idx = findSlot(p_key.Slot());
+  return (idx >= 0) ? *m_props[idx] : *s_default_prop;
+}
+
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value)
+{
+  const int idx = findID(p_id);
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyID& p_id, const int prop_value)
+{
+  const int idx = findID(p_id);
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyID& p_id, const double prop_value)
+{
+  const int idx = findID(p_id);
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyKey& p_key, const Apto::String& prop_value)
+{
+  const int idx = findSlot(p_key.Slot());
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyKey& p_key, const int prop_value)
+{
+  const int idx = findSlot(p_key.Slot());
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+bool Avida::SlotPropertyMap::SetValue(const PropertyKey& p_key, const double prop_value)
+{
+  const int idx = findSlot(p_key.Slot());
+  return (idx >= 0) ? m_props[idx]->SetValue(prop_value) : false;
+}
+
+
+
+bool Avida::SlotPropertyMap::operator==(const PropertyMap& p) const
+{
+  if (p.GetSize() != m_props.GetSize()) return false;
+  
+  for (int i = 0; i < m_props.GetSize(); i++) {
+    if (!p.Has(m_props[i]->ID()) || *m_props[i] != p.Get(m_props[i]->ID())) return false;
+  }
+  
+  return true;
+}
+
+void Avida::SlotPropertyMap::Define(PropertyPtr p) { define(PropertyKey::Intern(p->ID()), p); }
+void Avida::SlotPropertyMap::Define(const PropertyKey& p_key, PropertyPtr p) { define(p_key.Slot(), p); }
+
+bool Avida::SlotPropertyMap::Remove(const PropertyID& p_id)
+{
+  const int idx = findID(p_id);
+  if (idx < 0) return false;
+  
+  m_id_slots.Remove(p_id);
+  const int last = m_keys.GetSize() - 1;
+  for (int i = idx; i < last; i++) {
+    m_keys[i] = m_keys[i + 1];
+    m_props[i] = m_props[i + 1];
+  }
+  m_keys.Resize(last);
+  m_props.Resize(last);
+  return true;
+}
+
+Avida::ConstPropertyIDSetPtr Avida::SlotPropertyMap::PropertyIDs() const
+{
+  PropertyIDSetPtr pidset(new PropertyIDSet);
+  for (int i = 0; i < m_props.GetSize(); i++) pidset->Insert(m_props[i]->ID());
+  return pidset;
+}
+
+
+bool Avida::SlotPropertyMap::Serialize(ArchivePtr) const
+{
+  // @TODO
+  assert(false);
+  return false;
+}
+
+
+int Avida::SlotPropertyMap::findSlot(int slot_id) const
+{
+  int lo = 0;
+  int hi = m_keys.GetSize() - 1;
+  while (lo <= hi) {
+    const int mid = (lo + hi) / 2;
+    if (m_keys[mid] == slot_id) return mid;
+    if (m_keys[mid] < slot_id) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return -1;
+}
+
+
+// String lookups go through the map's own ID index, and never touch the global key registry (or its lock)
+int Avida::SlotPropertyMap::findID(const PropertyID& p_id) const
+{
+  int slot_id = -1;
+  if (!m_id_slots.Get(p_id, slot_id)) return -1;
+  return findSlot(slot_id);
+}
+
+
+void Avida::SlotPropertyMap::define(int slot_id, PropertyPtr p)
+{
+  m_id_slots.Set(p->ID(), slot_id);
+  
+  const int existing = findSlot(slot_id);
+  if (existing >= 0) {
+    m_props[existing] = p;
+    return;
+  }
+  
+  // Keys usually arrive in ascending order, so the insertion shift is normally empty
+  int idx = m_keys.GetSize();
+  m_keys.Resize(idx + 1);
+  m_props.Resize(idx + 1);
+  while (idx > 0 && m_keys[idx - 1] > slot_id) {
+    m_keys[idx] = m_keys[idx - 1];
+    m_props[idx] = m_props[idx - 1];
+    idx--;
+  }
+  m_keys[idx] = slot_id;
+  m_props[idx] = p;
+}
@@ -94,10 +94,19 @@ bool Avida::World::AttachFacet(WorldFacetID facet_id, WorldFacetPtr facet)
   return true;
 }
 
-void Avida::World::PerformUpdate(Context& ctx, Update current_update)
+void Avida::World::PerformUpdate(Context& ctx, Update current_update, WorldUpdateObserver* observer)
 {
+  if (!observer) {
+    for (int i = 0; i < m_facet_order.GetSize(); i++) {
+      m_facet_order[i]->PerformUpdate(ctx, current_update);
+    }
+    return;
+  }
+  
   for (int i = 0; i < m_facet_order.GetSize(); i++) {
+    observer->FacetUpdateStarting(m_facet_order[i]);
     m_facet_order[i]->PerformUpdate(ctx, current_update);
+    observer->FacetUpdateFinished(m_facet_order[i]);
   }
 }
 
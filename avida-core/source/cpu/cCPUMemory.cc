@@ -22,6 +22,8 @@
 
 #include "cCPUMemory.h"
 
+#include "cCheckpoint.h"
+
 using namespace std;
 using namespace Avida;
 
@@ -34,7 +36,7 @@ cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_mem
 void cCPUMemory::adjustCapacity(int new_size)
 {
   InstructionSequence::adjustCapacity(new_size);
-  if (m_seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_seq.GetSize()); 
+  if (m_buf->sites.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_buf->sites.GetSize()); 
 }
 
 
@@ -49,7 +51,8 @@ void cCPUMemory::prepareInsert(int pos, int num_sites)
   adjustCapacity(new_size);
   
   // Shift any sites needed...
-  for (int i = old_size - 1; i >= pos; i--) m_seq[i + num_sites] = m_seq[i];
+  Apto::Array<Instruction>& cur_sites = sites();
+  for (int i = old_size - 1; i >= pos; i--) cur_sites[i + num_sites] = cur_sites[i];
   for (int i = old_size - 1; i >= pos; i--) m_flag_array[i + num_sites] = m_flag_array[i];
 }
 
@@ -70,8 +73,9 @@ void cCPUMemory::Resize(int new_size)
   const int old_size = m_active_size;
   adjustCapacity(new_size);
   
+  Apto::Array<Instruction>& cur_sites = sites();
   for (int i = old_size; i < new_size; i++) {
-    m_seq[i].SetOp(0);
+    cur_sites[i].SetOp(0);
     m_flag_array[i] = 0;
   }
 }
@@ -91,11 +95,12 @@ void cCPUMemory::ResizeOld(int new_size)
 void cCPUMemory::Copy(int to, int from)
 {
   assert(to >= 0);
-  assert(to < m_seq.GetSize());
+  assert(to < m_active_size);
   assert(from >= 0);
-  assert(from < m_seq.GetSize());
+  assert(from < m_active_size);
   
-  m_seq[to] = m_seq[from];
+  Apto::Array<Instruction>& cur_sites = sites();
+  cur_sites[to] = cur_sites[from];
   m_flag_array[to] = m_flag_array[from];
 }
 
@@ -103,21 +108,23 @@ void cCPUMemory::Copy(int to, int from)
 void cCPUMemory::Insert(int pos, const Instruction& inst)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
 
   prepareInsert(pos, 1);
-  m_seq[pos] = inst;
+  Apto::Array<Instruction>& cur_sites = sites();
+  cur_sites[pos] = inst;
   m_flag_array[pos] = 0;
 }
 
 void cCPUMemory::Insert(int pos, const InstructionSequence& genome)
 {
   assert(pos >= 0);
-  assert(pos <= m_seq.GetSize());
+  assert(pos <= m_active_size);
 
   prepareInsert(pos, genome.GetSize());
+  Apto::Array<Instruction>& cur_sites = sites();
   for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
+    cur_sites[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
   }
 }
@@ -129,8 +136,9 @@ void cCPUMemory::Remove(int pos, int num_sites)
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of genome.
 
   const int new_size = m_active_size - num_sites;
+  Apto::Array<Instruction>& cur_sites = sites();
   for (int i = pos; i < new_size; i++) {
-    m_seq[i] = m_seq[i + num_sites];
+    cur_sites[i] = cur_sites[i + num_sites];
     m_flag_array[i] = m_flag_array[i + num_sites];
   }
   adjustCapacity(new_size);
@@ -149,33 +157,51 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   else if (size_change < 0) Remove(pos, -size_change);
   
   // Now just copy everything over!
+  Apto::Array<Instruction>& cur_sites = sites();
   for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
+    cur_sites[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
   }
 }
 
 
+// Assignment shares the other sequence's sites until either side is modified; the flags always belong to this memory
+
 void cCPUMemory::operator=(const cCPUMemory& other_memory)
 {
-  adjustCapacity(other_memory.m_active_size);
-  
-  // Fill in the new information...
+  InstructionSequence::operator=(other_memory);
+  m_flag_array = other_memory.m_flag_array;
+}
+
+
+void cCPUMemory::operator=(const InstructionSequence& other_genome)
+{
+  InstructionSequence::operator=(other_genome);
+  m_flag_array.ResizeClear(m_buf->sites.GetSize());
+  m_flag_array.SetAll(0);
+}
+
+
+void cCPUMemory::SaveState(cCheckpointWriter& ckp) const
+{
+  ckp.WriteInt(m_active_size);
+  const Apto::Array<Instruction>& cur_sites = sites();
   for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_memory.m_seq[i];
-    m_flag_array[i] = other_memory.m_flag_array[i];
+    ckp.WriteByte(cur_sites[i].GetOp());
+    ckp.WriteByte(m_flag_array[i]);
   }
 }
 
 
-void cCPUMemory::operator=(const InstructionSequence& other_genome)
+void cCPUMemory::LoadState(cCheckpointReader& ckp)
 {
-  adjustCapacity(other_genome.GetSize());
+  const int size = ckp.ReadInt();
+  if (!ckp.Good() || size < 0) return;
   
-  // Fill in the new information...
+  adjustCapacity(size);
+  Apto::Array<Instruction>& cur_sites = sites();
   for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_genome[i];
-    m_flag_array[i] = 0;
+    cur_sites[i].SetOp(ckp.ReadByte());
+    m_flag_array[i] = ckp.ReadByte();
   }
 }
-
@@ -25,6 +25,9 @@
 
 #include "avida/core/InstructionSequence.h"
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 
 class cCPUMemory : public Avida::InstructionSequence
 {
@@ -74,8 +77,9 @@ public:
   
   void Clear()
 	{
+		Apto::Array<Avida::Instruction>& cur_sites = sites();
 		for (int i = 0; i < m_active_size; i++) {
-			m_seq[i].SetOp(0);
+			cur_sites[i].SetOp(0);
 			m_flag_array[i] = 0;
 		}
 	}
@@ -93,6 +97,9 @@ public:
 
   void operator=(const cCPUMemory& other_memory);
   void operator=(const InstructionSequence& other_genome);
+  
+  void SaveState(cCheckpointWriter& ckp) const;
+  void LoadState(cCheckpointReader& ckp);
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include "cCPUStack.h"
 
 #include <cassert>
+#include "cCheckpoint.h"
 #include "cString.h"
 
 using namespace std;
@@ -75,3 +76,15 @@ void cCPUStack::LoadState(istream & fp)
     Push(value);
   }
 }
+
+void cCPUStack::SaveState(cCheckpointWriter& ckp) const
+{
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) ckp.WriteInt(stack[i]);
+  ckp.WriteByte(stack_pointer);
+}
+
+void cCPUStack::LoadState(cCheckpointReader& ckp)
+{
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) stack[i] = ckp.ReadInt();
+  stack_pointer = ckp.ReadByte();
+}
@@ -29,6 +29,9 @@
 #include "nHardware.h"
 #endif
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 class cCPUStack
 {
 private:
@@ -53,6 +56,8 @@ public:
 
   void SaveState(std::ostream& fp);
   void LoadState(std::istream & fp);
+  void SaveState(cCheckpointWriter& ckp) const;
+  void LoadState(cCheckpointReader& ckp);
 };
 
 
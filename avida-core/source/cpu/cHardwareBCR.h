@@ -32,6 +32,7 @@
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
 #include "cHeadCPU.h"
+#include "cMiniTrace.h"
 #include "cOrgSensor.h"
 #include "cStats.h"
 #include "cString.h"
@@ -301,9 +302,10 @@ public:
   int GetType() const { return HARDWARE_TYPE_CPU_BCR; }
   bool SupportsSpeculative() const { return true; }
   void PrintStatus(std::ostream& fp);
-  void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
-  void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success);
+  bool SupportsMiniTrace() const { return true; }
+  unsigned int GetMiniTraceFlags() const { return sMiniTraceRecord::MICRO_OP | (m_use_avatar ? sMiniTraceRecord::AVATAR : 0); }
+  void GetMiniTraceRecord(cAvidaContext& ctx, sMiniTraceRecord& rec);
   
   // --------  Stack Manipulation  --------
   inline int GetStack(int depth=0, int stack_id = -1, int in_thread = -1) const;
@@ -26,13 +26,16 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCodeLabel.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
+#include "cHardwareTraceRecorder.h"
 #include "cHeadCPU.h"
 #include "cInstSet.h"
+#include "cMiniTrace.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
 #include "cPopulation.h"
@@ -47,7 +50,7 @@ using namespace AvidaTools;
 
 
 cHardwareBase::cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* inst_set)
-: m_world(world), m_organism(in_organism), m_inst_set(inst_set), m_tracer(NULL)
+: m_world(world), m_organism(in_organism), m_inst_set(inst_set), m_tracer(NULL), m_inst_profile(NULL)
 , m_minitrace(false), m_microtrace(false), m_topnavtrace(false), m_reprotrace(false)
 , m_has_costs(inst_set->HasCosts()), m_has_ft_costs(inst_set->HasFTCosts()) , m_has_energy_costs(m_inst_set->HasEnergyCosts())
 , m_has_res_costs(m_inst_set->HasResCosts()), m_has_fem_res_costs(m_inst_set->HasFemResCosts())
@@ -68,6 +71,29 @@ cHardwareBase::cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* in
 }
 
 
+void cHardwareBase::saveBaseState(cCheckpointWriter& ckp) const
+{
+  ckp.WriteInt(m_inst_cost);
+  ckp.WriteInt(m_female_cost);
+  ckp.WriteIntArray(m_active_thread_costs);
+  ckp.WriteIntArray(m_active_thread_post_costs);
+  ckp.WriteInt(m_ext_mem.GetSize());
+  for (int i = 0; i < m_ext_mem.GetSize(); i++) ckp.WriteInt(m_ext_mem[i]);
+}
+
+
+void cHardwareBase::loadBaseState(cCheckpointReader& ckp)
+{
+  m_inst_cost = ckp.ReadInt();
+  m_female_cost = ckp.ReadInt();
+  ckp.ReadIntArray(m_active_thread_costs);
+  ckp.ReadIntArray(m_active_thread_post_costs);
+  const int ext_mem_size = ckp.ReadInt();
+  m_ext_mem.Resize((ext_mem_size > 0) ? ext_mem_size : 0);
+  for (int i = 0; i < m_ext_mem.GetSize(); i++) m_ext_mem[i] = ckp.ReadInt();
+}
+
+
 void cHardwareBase::Reset(cAvidaContext& ctx)
 {
   m_organism->HardwareReset(ctx);
@@ -1425,15 +1451,60 @@ void cHardwareBase::InsertGenomeFragment(const InstructionSequence& fragment) {
 	wh.Adjust();
 }
 
-void cHardwareBase::SetMiniTrace(const cString& filename)
+void cHardwareBase::SetMiniTrace(const cString& filename, bool binary)
 {
-  m_tracer = HardwareTracerPtr(new cHardwareStatusPrinter(m_world->GetNewWorld(), (const char*)filename, true));
+  if (binary) m_tracer = HardwareTracerPtr(new cHardwareTraceRecorder(m_world->GetNewWorld(), (const char*)filename));
+  else m_tracer = HardwareTracerPtr(new cHardwareStatusPrinter(m_world->GetNewWorld(), (const char*)filename, true));
   m_minitrace = true;
 }
 
+void cHardwareBase::GetMiniTraceHeader(const int gen_id, const Apto::String& genotype, sMiniTraceHeader& header)
+{
+  const Genome& in_genome = m_organism->GetGenome();
+  ConstInstructionSequencePtr in_seq_p;
+  in_seq_p.DynamicCastFrom(in_genome.Representation());
+
+  header.flags = GetMiniTraceFlags();
+  header.timestamp = 0;
+  header.update_born = m_world->GetStats().GetUpdate();
+  header.org_id = m_organism->GetID();
+  header.gen_id = gen_id;
+  header.genome_length = in_seq_p->GetSize();
+  header.genotype = (const char*)genotype;
+  header.inst_names.Resize(0);
+}
+
+void cHardwareBase::SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype)
+{
+  if (!SupportsMiniTrace()) return;
+
+  sMiniTraceHeader header;
+  GetMiniTraceHeader(gen_id, genotype, header);
+  Apto::Array<cString> comments;
+  cMiniTrace::GetHeaderComments(header, comments);
+
+  df.WriteTimeStamp();
+  for (int i = 0; i < comments.GetSize(); i++) df.WriteComment(comments[i]);
+  df.Endl();
+}
+
+void cHardwareBase::PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp)
+{
+  if (!SupportsMiniTrace()) return;
+
+  sMiniTraceRecord rec;
+  GetMiniTraceRecord(ctx, rec);
+  cMiniTrace::PrintStatus(fp, rec, GetInstSet().GetName(rec.next_inst));
+}
+
 void cHardwareBase::RecordMicroTrace(const Instruction& cur_inst)
 {
-  m_microtracer.Push(cur_inst.GetSymbol()[0]);
+  // Only the leading symbol character is kept, so look it up rather than building the full symbol string every step
+  static struct sLeadSymbols {
+    char symbol[256];
+    sLeadSymbols() { for (int op = 0; op < 256; op++) symbol[op] = Instruction(op).GetSymbol()[0]; }
+  } lead_symbols;
+  m_microtracer.Push(lead_symbols.symbol[cur_inst.GetOp()]);
 }
 
 void cHardwareBase::PrintMicroTrace(int gen_id)
@@ -36,13 +36,18 @@
 #include "tBuffer.h"
 
 class cAvidaContext;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cCodeLabel;
 class cCPUMemory;
 class cHeadCPU;
+class cInstProfile;
 class cMutation;
 class cOrganism;
 class cString;
 class cWorld;
+struct sMiniTraceHeader;
+struct sMiniTraceRecord;
 
 using namespace std;
 using namespace Avida;
@@ -56,6 +61,7 @@ protected:
   cInstSet* m_inst_set;             // Instruction set being used.
 
   HardwareTracerPtr m_tracer;        // Set this if you want execution traced.
+  cInstProfile* m_inst_profile;      // Set this to record instruction execution counts and timings.
   Apto::Array<char, Apto::Smart> m_microtracer;
   Apto::Array<int, Apto::Smart> m_navtraceloc;
   Apto::Array<int, Apto::Smart> m_navtracefacing;
@@ -139,14 +145,22 @@ public:
   int Divide_DoMutations(cAvidaContext& ctx, double mut_multiplier = 1.0, const int maxmut = INT_MAX);
   bool Divide_TestFitnessMeasures(cAvidaContext& ctx);
   
+  // --------  Checkpointing  --------
+  // Hardware types that support checkpointing record their complete execution state.  Populations with organisms on
+  // other hardware types cannot be checkpointed.
+  virtual bool SupportsCheckpoint() const { return false; }
+  virtual void SaveState(cCheckpointWriter& ckp) const { ; }
+  virtual bool LoadState(cCheckpointReader& ckp) { return false; }
+  
   // --------  Helper methods  --------
   virtual int GetType() const = 0;
   virtual bool SupportsSpeculative() const = 0;
   virtual void PrintStatus(std::ostream& fp) = 0;
-  virtual void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) = 0;
+  virtual void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
   virtual void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) = 0;
   void SetTrace(HardwareTracerPtr tracer) { m_tracer = tracer; }
-  void SetMiniTrace(const cString& filename);
+  void SetInstProfile(cInstProfile* profile) { m_inst_profile = profile; }
+  void SetMiniTrace(const cString& filename, bool binary = false);
   void SetMicroTrace() { m_microtrace = true; } 
   void SetTopNavTrace(bool nav_trace) { m_topnavtrace = nav_trace; }
   bool IsTopNavTrace() { return m_topnavtrace; }
@@ -160,10 +174,16 @@ public:
   Apto::Array<int, Apto::Smart>& GetNavTraceFacing() { return m_navtracefacing; }
   Apto::Array<int, Apto::Smart>& GetNavTraceUpdate() { return m_navtraceupdate; }
   void DeleteMiniTrace(bool print_reacs, bool repro_split = false);
-  virtual void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype) = 0;
+  virtual void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void SetupExtendedMemory(const Apto::Array<int, Apto::Smart>& ext_mem) { m_ext_mem = ext_mem; }
   void PrintMiniTraceReactions();
   
+  // Hardware that can be mini traced reports each step as a fixed-size record, shared by the text and binary traces
+  virtual bool SupportsMiniTrace() const { return false; }
+  virtual unsigned int GetMiniTraceFlags() const { return 0; }
+  virtual void GetMiniTraceRecord(cAvidaContext& ctx, sMiniTraceRecord& rec) { (void)ctx; (void)rec; }
+  void GetMiniTraceHeader(const int gen_id, const Apto::String& genotype, sMiniTraceHeader& header);
+  
   // --------  Stack Manipulation...  --------
   virtual int GetStack(int depth = 0, int stack_id = -1, int in_thread = -1) const = 0;
   virtual int GetCurStack(int in_thread_id = -1) const { (void)in_thread_id; return -1; }
@@ -244,6 +264,9 @@ public:
   
 protected:
   void ResizeCostArrays(int new_size);
+  
+  void saveBaseState(cCheckpointWriter& ckp) const;
+  void loadBaseState(cCheckpointReader& ckp);
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_PayPreCosts(cAvidaContext& ctx, const Instruction& cur_inst, const int thread_id);
@@ -29,6 +29,7 @@
 #include "avida/private/systematics/SexualAncestry.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareManager.h"
@@ -37,6 +38,7 @@
 #include "cOrganism.h"
 #include "cOrgMessage.h"
 #include "cPhenotype.h"
+#include "cProfiler.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
 #include "cReaction.h"
@@ -869,6 +871,116 @@ void cHardwareCPU::internalResetOnFailedDivide()
 }
 
 
+void cHardwareCPU::SaveState(cCheckpointWriter& ckp) const
+{
+  saveBaseState(ckp);
+  
+  m_memory.SaveState(ckp);
+  m_global_stack.SaveState(ckp);
+  
+  ckp.WriteInt(m_threads.GetSize());
+  for (int t = 0; t < m_threads.GetSize(); t++) {
+    const cLocalThread& thread = m_threads[t];
+    ckp.WriteInt(thread.GetID());
+    for (int i = 0; i < NUM_REGISTERS; i++) ckp.WriteInt(thread.reg[i]);
+    for (int i = 0; i < NUM_HEADS; i++) ckp.WriteInt(thread.heads[i].GetFullLocation());
+    thread.stack.SaveState(ckp);
+    ckp.WriteByte(thread.cur_stack);
+    ckp.WriteByte(thread.cur_head);
+    ckp.WriteInt(thread.GetPromoterInstExecuted());
+    ckp.WriteInt(thread.getMessageTriggerType());
+    
+    ckp.WriteInt(thread.read_label.GetSize());
+    for (int i = 0; i < thread.read_label.GetSize(); i++) ckp.WriteByte(thread.read_label[i]);
+    ckp.WriteInt(thread.next_label.GetSize());
+    for (int i = 0; i < thread.next_label.GetSize(); i++) ckp.WriteByte(thread.next_label[i]);
+  }
+  ckp.WriteInt(m_thread_id_chart);
+  ckp.WriteInt(m_cur_thread);
+  
+  ckp.WriteBool(m_mal_active);
+  ckp.WriteBool(m_executedmatchstrings);
+  ckp.WriteInt(m_promoter_index);
+  ckp.WriteInt(m_promoter_offset);
+  ckp.WriteInt(m_promoters.GetSize());
+  for (int i = 0; i < m_promoters.GetSize(); i++) {
+    ckp.WriteInt(m_promoters[i].m_pos);
+    ckp.WriteInt(m_promoters[i].m_bit_code);
+    ckp.WriteInt(m_promoters[i].m_regulation);
+  }
+  
+  ckp.WriteBool(m_epigenetic_state);
+  for (int i = 0; i < NUM_REGISTERS; i++) ckp.WriteInt(m_epigenetic_saved_reg[i]);
+  m_epigenetic_saved_stack.SaveState(ckp);
+  
+  ckp.WriteBool(m_last_cell_data.first);
+  ckp.WriteInt(m_last_cell_data.second);
+  ckp.WriteUInt(m_flash_info.first);
+  ckp.WriteUInt(m_flash_info.second);
+  ckp.WriteUInt(m_cycle_counter);
+}
+
+
+bool cHardwareCPU::LoadState(cCheckpointReader& ckp)
+{
+  loadBaseState(ckp);
+  
+  // Memory must be restored before the heads, which adjust themselves against it
+  m_memory.LoadState(ckp);
+  m_global_stack.LoadState(ckp);
+  
+  const int num_threads = ckp.ReadInt();
+  if (!ckp.Good() || num_threads < 1) return false;
+  
+  m_threads.Resize(num_threads);
+  for (int t = 0; t < num_threads; t++) {
+    cLocalThread& thread = m_threads[t];
+    thread.Reset(this, ckp.ReadInt());
+    for (int i = 0; i < NUM_REGISTERS; i++) thread.reg[i] = ckp.ReadInt();
+    for (int i = 0; i < NUM_HEADS; i++) thread.heads[i].SetFullLocation(ckp.ReadInt());
+    thread.stack.LoadState(ckp);
+    thread.cur_stack = ckp.ReadByte();
+    thread.cur_head = ckp.ReadByte();
+    thread.SetPromoterInstExecuted(ckp.ReadInt());
+    thread.setMessageTriggerType(ckp.ReadInt());
+    
+    thread.read_label.Clear();
+    const int read_size = ckp.ReadInt();
+    for (int i = 0; i < read_size; i++) thread.read_label.AddNop(ckp.ReadByte());
+    thread.next_label.Clear();
+    const int next_size = ckp.ReadInt();
+    for (int i = 0; i < next_size; i++) thread.next_label.AddNop(ckp.ReadByte());
+  }
+  m_thread_id_chart = ckp.ReadInt();
+  m_cur_thread = ckp.ReadInt();
+  
+  m_mal_active = ckp.ReadBool();
+  m_executedmatchstrings = ckp.ReadBool();
+  m_promoter_index = ckp.ReadInt();
+  m_promoter_offset = ckp.ReadInt();
+  const int num_promoters = ckp.ReadInt();
+  if (!ckp.Good() || num_promoters < 0) return false;
+  m_promoters.Resize(num_promoters);
+  for (int i = 0; i < num_promoters; i++) {
+    m_promoters[i].m_pos = ckp.ReadInt();
+    m_promoters[i].m_bit_code = ckp.ReadInt();
+    m_promoters[i].m_regulation = ckp.ReadInt();
+  }
+  
+  m_epigenetic_state = ckp.ReadBool();
+  for (int i = 0; i < NUM_REGISTERS; i++) m_epigenetic_saved_reg[i] = ckp.ReadInt();
+  m_epigenetic_saved_stack.LoadState(ckp);
+  
+  m_last_cell_data.first = ckp.ReadBool();
+  m_last_cell_data.second = ckp.ReadInt();
+  m_flash_info.first = ckp.ReadUInt();
+  m_flash_info.second = ckp.ReadUInt();
+  m_cycle_counter = ckp.ReadUInt();
+  
+  return ckp.Good();
+}
+
+
 
 void cHardwareCPU::cLocalThread::operator=(const cLocalThread& in_thread)
 {
@@ -1071,6 +1183,7 @@ bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instructi
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
   // And execute it.
+  cInstProfileTimer inst_timer(m_inst_profile, actual_inst);
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
   
   // NOTE: Organism may be dead now if instruction executed killed it (such as some divides, "die", or "explode")
@@ -89,11 +89,12 @@ protected:
     void Reset(cHardwareBase* in_hardware, int in_id);
     int GetID() const { return m_id; }
     void SetID(int in_id) { m_id = in_id; }
-    int GetPromoterInstExecuted() { return m_promoter_inst_executed; }
+    int GetPromoterInstExecuted() const { return m_promoter_inst_executed; }
+    void SetPromoterInstExecuted(int value) { m_promoter_inst_executed = value; }
     void IncPromoterInstExecuted() { m_promoter_inst_executed++; }
     void ResetPromoterInstExecuted() { m_promoter_inst_executed = 0; }
     void setMessageTriggerType(int value) { m_messageTriggerType = value; }
-    int getMessageTriggerType() { return m_messageTriggerType; }
+    int getMessageTriggerType() const { return m_messageTriggerType; }
   };
 
 
@@ -252,6 +253,9 @@ public:
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
+  bool SupportsCheckpoint() const { return true; }
+  void SaveState(cCheckpointWriter& ckp) const;
+  bool LoadState(cCheckpointReader& ckp);
 
   // --------  Stack Manipulation...  --------
   inline int GetStack(int depth=0, int stack_id=-1, int in_thread=-1) const;
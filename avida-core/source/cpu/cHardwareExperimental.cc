@@ -35,6 +35,7 @@
 #include "cInstSet.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
+#include "cProfiler.h"
 #include "cPopulation.h"
 #include "cStateGrid.h"
 #include "cStringUtil.h"
@@ -753,6 +754,7 @@ bool cHardwareExperimental::SingleProcess_ExecuteInst(cAvidaContext& ctx, const
   // And execute it.
   m_from_sensor = false;
   m_from_message = false;
+  cInstProfileTimer inst_timer(m_inst_profile, actual_inst);
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
   
 	if (exec_success) {
@@ -839,78 +841,38 @@ void cHardwareExperimental::PrintStatus(ostream& fp)
   fp.flush();
 }
 
-void cHardwareExperimental::SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype)
-{
-  const Genome& in_genome = m_organism->GetGenome();
-  ConstInstructionSequencePtr in_seq_p;
-  in_seq_p.DynamicCastFrom(in_genome.Representation());
-  const InstructionSequence& in_seq = *in_seq_p;
-
-  df.WriteTimeStamp();
-  cString org_dat("");
-  df.WriteComment(org_dat.Set("Update Born: %d", m_world->GetStats().GetUpdate()));
-  df.WriteComment(org_dat.Set("Org ID: %d", m_organism->GetID()));
-  df.WriteComment(org_dat.Set("Genotype ID: %d", gen_id));
-  df.WriteComment(org_dat.Set("Genotype: %s", (const char*) genotype));
-  df.WriteComment(org_dat.Set("Genome Length: %d", in_seq.GetSize()));
-  df.WriteComment(" ");
-  df.WriteComment("Exec Stats Columns:");
-  df.WriteComment("CPU Cycle");
-  df.WriteComment("Current Update");
-  df.WriteComment("Register Contents (CPU Cycle Origin of Contents)");
-  df.WriteComment("Current Thread");
-  df.WriteComment("IP Position");
-  df.WriteComment("RH Position");
-  df.WriteComment("WH Position");
-  df.WriteComment("FH Position");
-  df.WriteComment("CPU Cycle of Last Output");
-  df.WriteComment("Current Merit");
-  df.WriteComment("Current Bonus");
-  df.WriteComment("Forager Type");
-  df.WriteComment("Group ID (opinion)");
-  df.WriteComment("Current Cell");
-  df.WriteComment("Avatar Cell");
-  df.WriteComment("Faced Direction");
-  df.WriteComment("Faced Cell Occupied?");
-  df.WriteComment("Faced Cell Has Hill?");
-  df.WriteComment("Faced Cell Has Wall?");
-  df.WriteComment("Queued Instruction");
-  df.WriteComment("Trailing NOPs");
-  df.WriteComment("Did Queued Instruction Execute (-1=no, paying cpu costs; 0=failed; 1=yes)");
-  df.Endl();
-}
-
-void cHardwareExperimental::PrintMiniTraceStatus(cAvidaContext& ctx, ostream& fp)
+void cHardwareExperimental::GetMiniTraceRecord(cAvidaContext& ctx, sMiniTraceRecord& rec)
 {
+  rec.flags = GetMiniTraceFlags();
   // basic status info
-  fp << m_cycle_count << " ";
-  fp << m_world->GetStats().GetUpdate() << " ";
+  rec.cycle = m_cycle_count;
+  rec.update = m_world->GetStats().GetUpdate();
+  rec.num_registers = NUM_REGISTERS;
   for (int i = 0; i < NUM_REGISTERS; i++) {
     DataValue& reg = m_threads[m_cur_thread].reg[i];
-    fp << GetRegister(i) << " ";
-    fp << "(" << reg.originated << ") ";
+    rec.reg[i] = GetRegister(i);
+    rec.reg_origin[i] = reg.originated;
   }    
   // genome loc info
-  fp << m_cur_thread << " ";
-  fp << getIP().GetPosition() << " ";  
-  fp << getHead(nHardware::HEAD_READ).GetPosition() << " ";
-  fp << getHead(nHardware::HEAD_WRITE).GetPosition()  << " ";
-  fp << getHead(nHardware::HEAD_FLOW).GetPosition()   << " ";
+  rec.thread = m_cur_thread;
+  rec.ip = getIP().GetPosition();
+  rec.read_head = getHead(nHardware::HEAD_READ).GetPosition();
+  rec.write_head = getHead(nHardware::HEAD_WRITE).GetPosition();
+  rec.flow_head = getHead(nHardware::HEAD_FLOW).GetPosition();
   // last output
-  fp << m_last_output << " ";
+  rec.last_output = m_last_output;
   // phenotype/org status info
-  fp << m_organism->GetPhenotype().GetMerit().GetDouble() << " ";
-  fp << m_organism->GetPhenotype().GetCurBonus() << " ";
-  fp << m_organism->GetForageTarget() << " ";
-  if (m_organism->HasOpinion()) fp << m_organism->GetOpinion().first << " ";
-  else fp << -99 << " ";
+  rec.merit = m_organism->GetPhenotype().GetMerit().GetDouble();
+  rec.bonus = m_organism->GetPhenotype().GetCurBonus();
+  rec.forage_target = m_organism->GetForageTarget();
+  rec.group = m_organism->HasOpinion() ? m_organism->GetOpinion().first : -99;
   // environment info / things that affect movement
-  fp << m_organism->GetOrgInterface().GetCellID() << " ";
-  if (m_use_avatar) fp << m_organism->GetOrgInterface().GetAVCellID() << " ";
-  if (!m_use_avatar) fp << m_organism->GetOrgInterface().GetFacedDir() << " ";
-  else fp << m_organism->GetOrgInterface().GetAVFacing() << " ";
-  if (!m_use_avatar) fp << m_organism->IsNeighborCellOccupied() << " ";  
-  else fp << m_organism->GetOrgInterface().FacedHasAV() << " ";
+  rec.cell = m_organism->GetOrgInterface().GetCellID();
+  if (m_use_avatar) rec.av_cell = m_organism->GetOrgInterface().GetAVCellID();
+  if (!m_use_avatar) rec.facing = m_organism->GetOrgInterface().GetFacedDir();
+  else rec.facing = m_organism->GetOrgInterface().GetAVFacing();
+  if (!m_use_avatar) rec.faced_occupied = m_organism->IsNeighborCellOccupied();
+  else rec.faced_occupied = m_organism->GetOrgInterface().FacedHasAV();
   const cResourceLib& resource_lib = m_world->GetEnvironment().GetResourceLib();
   Apto::Array<double> cell_resource_levels;
   if (!m_use_avatar) cell_resource_levels = m_organism->GetOrgInterface().GetFacedCellResources(ctx);
@@ -932,29 +894,20 @@ void cHardwareExperimental::PrintMiniTraceStatus(cAvidaContext& ctx, ostream& fp
     }
     if (hill == 1 && wall == 1) break;
   }
-  fp << hill << " ";
-  fp << wall << " ";
+  rec.faced_hill = hill;
+  rec.faced_wall = wall;
   // instruction about to be executed
-  cString next_name(GetInstSet().GetName(IP().GetInst()));
-
-  fp << next_name << " ";
+  rec.next_inst = IP().GetInst().GetOp();
   // any trailing nops (up to NUM_REGISTERS)
   cCPUMemory& memory = m_memory;
   int pos = getIP().GetPosition();
-  Apto::Array<int, Apto::Smart> seq;
-  seq.Resize(0);
+  rec.num_nop_mods = 0;
   for (int i = 0; i < NUM_REGISTERS; i++) {
     pos += 1;
     if (pos >= memory.GetSize()) pos = 0;
-    if (m_inst_set->IsNop(memory[pos])) seq.Push(m_inst_set->GetNopMod(memory[pos])); 
+    if (m_inst_set->IsNop(memory[pos])) rec.nop_mods[rec.num_nop_mods++] = m_inst_set->GetNopMod(memory[pos]) + 'A';
     else break;
   }
-  cString mod_string;
-  for (int j = 0; j < seq.GetSize(); j++) {
-    mod_string += (char) seq[j] + 'A';  
-  }  
-  if (mod_string.GetSize() != 0) fp << mod_string << " ";
-  else fp << "NoMods" << " ";
 }
 
 void cHardwareExperimental::PrintMiniTraceSuccess(ostream& fp, const int exec_sucess)
@@ -40,7 +40,7 @@
 
 using namespace Avida;
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
+static const PropertyKey s_prop_id_instset("instset");
 
 cHardwareManager::cHardwareManager(cWorld* world)
 : m_world(world)
@@ -0,0 +1,105 @@
+/*
+ *  cHardwareTraceRecorder.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cHardwareTraceRecorder.h"
+
+#include "avida/output/Manager.h"
+
+#include "cHardwareBase.h"
+#include "cOrganism.h"
+
+#include <cstring>
+#include <ctime>
+
+
+cHardwareTraceRecorder::cHardwareTraceRecorder(Avida::World* world, const Apto::String& filename)
+  : m_fp(&m_buf), m_header_done(false), m_num_records(0), m_has_status(false)
+{
+  Avida::Output::ManagerPtr mgr = Avida::Output::Manager::Of(world);
+  Avida::Output::OutputID oid = mgr->OutputIDFromPath(filename);
+  if (oid.GetSize() == 0 || !m_buf.Open(oid, false, mgr->OutputWriter(), true)) m_fp.setstate(std::ios::failbit);
+}
+
+cHardwareTraceRecorder::~cHardwareTraceRecorder()
+{
+  flushRecords();
+  m_buf.Close();
+}
+
+
+void cHardwareTraceRecorder::TraceHardware(cAvidaContext& ctx, cHardwareBase& hardware, bool, bool mini, int exec_success)
+{
+  // Only mini trace steps are recorded, mirroring cHardwareStatusPrinter in minitrace mode
+  if (!mini || m_fp.fail() || !hardware.SupportsMiniTrace()) return;
+
+  cOrganism* organism = hardware.GetOrganism();
+  if (!organism) return;
+
+  bool in_setup = false;
+  if (!m_header_done) {
+    Apto::String genotype_name = organism->SystematicsGroup("genotype")->Properties().Get("genotype").StringValue();
+    sMiniTraceHeader header;
+    hardware.GetMiniTraceHeader(organism->SystematicsGroup("genotype")->ID(), genotype_name, header);
+    header.timestamp = time(0);
+    const cInstSet& inst_set = hardware.GetInstSet();
+    for (int i = 0; i < inst_set.GetSize(); i++) header.inst_names.Push(inst_set.GetName(i));
+
+    cMiniTrace::WriteBinaryHeader(m_fp, header);
+    m_header_done = true;
+    in_setup = true;
+  }
+
+  if (exec_success == sMiniTraceRecord::NO_SUCCESS || in_setup) {
+    // A status that is never closed out stays in the trace as is, as it would in the text trace
+    nextRecord();
+    hardware.GetMiniTraceRecord(ctx, m_records[m_num_records - 1]);
+    m_records[m_num_records - 1].exec_success = sMiniTraceRecord::NO_SUCCESS;
+    m_has_status = true;
+  }
+  if (exec_success != sMiniTraceRecord::NO_SUCCESS) PrintSuccess(organism, exec_success);
+}
+
+void cHardwareTraceRecorder::PrintSuccess(cOrganism*, int exec_success)
+{
+  if (!m_header_done) return;
+
+  if (!m_has_status) {
+    nextRecord();
+    m_records[m_num_records - 1].flags = sMiniTraceRecord::SUCCESS_ONLY;
+  }
+  m_records[m_num_records - 1].exec_success = exec_success;
+  m_has_status = false;
+}
+
+
+void cHardwareTraceRecorder::nextRecord()
+{
+  if (m_num_records == RECORD_BUFFER_SIZE) flushRecords();
+
+  // Records go to disk byte for byte, so clear the padding along with the fields
+  memset(&m_records[m_num_records], 0, sizeof(sMiniTraceRecord));
+  m_num_records++;
+}
+
+void cHardwareTraceRecorder::flushRecords()
+{
+  if (m_num_records) m_fp.write(reinterpret_cast<const char*>(m_records), m_num_records * sizeof(sMiniTraceRecord));
+  m_num_records = 0;
+}
@@ -0,0 +1,69 @@
+/*
+ *  cHardwareTraceRecorder.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cHardwareTraceRecorder_h
+#define cHardwareTraceRecorder_h
+
+#include "avida/output/Writer.h"
+
+#include "cHardwareTracer.h"
+#include "cMiniTrace.h"
+
+#include <ostream>
+
+namespace Avida { class World; };
+
+
+// cHardwareTraceRecorder - binary mini trace writer
+//
+//   Each step becomes one fixed-size sMiniTraceRecord in a local buffer, which is handed to the output writer whole
+//   once it fills (and when the trace ends).  Nothing is formatted while the organism runs; the avida-trace tool turns
+//   the file back into the text written by cHardwareStatusPrinter.
+
+class cHardwareTraceRecorder : public cHardwareTracer
+{
+private:
+  static const int RECORD_BUFFER_SIZE = 256;
+
+  Avida::Output::FileBuffer m_buf;
+  std::ostream m_fp;
+  bool m_header_done;
+
+  sMiniTraceRecord m_records[RECORD_BUFFER_SIZE];
+  int m_num_records;
+  bool m_has_status;      // last record holds a status still waiting for its instruction's outcome
+
+
+  void nextRecord();
+  void flushRecords();
+
+  cHardwareTraceRecorder(const cHardwareTraceRecorder&); // @not_implemented
+  cHardwareTraceRecorder& operator=(const cHardwareTraceRecorder&); // @not_implemented
+
+public:
+  cHardwareTraceRecorder(Avida::World* world, const Apto::String& filename);
+  ~cHardwareTraceRecorder();
+
+  virtual void TraceHardware(cAvidaContext& ctx, cHardwareBase& hardware, bool bonus, bool mini, int exec_success);
+  virtual void PrintSuccess(cOrganism* organism, int exec_success);
+  virtual void TraceTestCPU(int, int, const cOrganism&) { ; }
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include "cHardwareTracer.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
+#include "cProfiler.h"
 #include "cTestCPU.h"
 #include "cWorld.h"
 #include "tInstLibEntry.h"
@@ -323,6 +324,7 @@ bool cHardwareTransSMT::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Inst
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
   // And execute it.
+  cInstProfileTimer inst_timer(m_inst_profile, actual_inst);
   const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
 	
   // decremenet if the instruction was not executed successfully
@@ -0,0 +1,232 @@
+/*
+ *  cMiniTrace.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cMiniTrace.h"
+
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+
+const char* const cMiniTrace::BINARY_EXTENSION = ".trcb";
+
+
+namespace {
+  const char BINARY_MAGIC[4] = { 'A', 'V', 'M', 'T' };
+  const unsigned int BINARY_VERSION = 1;
+
+  template <typename T> inline void writeValue(ostream& fp, T value)
+  {
+    fp.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T> inline bool readValue(istream& fp, T& value)
+  {
+    return bool(fp.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  void writeString(ostream& fp, const cString& str)
+  {
+    writeValue<unsigned int>(fp, str.GetSize());
+    fp.write(str, str.GetSize());
+  }
+
+  bool readString(istream& fp, cString& str)
+  {
+    unsigned int size = 0;
+    if (!readValue(fp, size) || size > (1 << 24)) return false;
+    Apto::Array<char> buf(size + 1);
+    if (size && !fp.read(&buf[0], size)) return false;
+    buf[size] = '\0';
+    str = &buf[0];
+    return true;
+  }
+};
+
+
+void cMiniTrace::GetHeaderComments(const sMiniTraceHeader& header, Apto::Array<cString>& comments)
+{
+  cString org_dat("");
+  comments.Resize(0);
+  comments.Push(org_dat.Set("Update Born: %d", header.update_born));
+  comments.Push(org_dat.Set("Org ID: %d", header.org_id));
+  comments.Push(org_dat.Set("Genotype ID: %d", header.gen_id));
+  comments.Push(org_dat.Set("Genotype: %s", (const char*)header.genotype));
+  comments.Push(org_dat.Set("Genome Length: %d", header.genome_length));
+  comments.Push(" ");
+  comments.Push("Exec Stats Columns:");
+  comments.Push("CPU Cycle");
+  if (header.flags & sMiniTraceRecord::MICRO_OP) comments.Push("MicroOp");
+  comments.Push("Current Update");
+  if (header.flags & sMiniTraceRecord::HW_QUEUE) {
+    comments.Push("Queued Eat");
+    comments.Push("Queued Move");
+    comments.Push("Queued Rotate (Number)");
+  }
+  comments.Push("Register Contents (CPU Cycle Origin of Contents)");
+  comments.Push("Current Thread");
+  comments.Push("IP Position");
+  comments.Push("RH Position");
+  comments.Push("WH Position");
+  comments.Push("FH Position");
+  comments.Push("CPU Cycle of Last Output");
+  comments.Push("Current Merit");
+  comments.Push("Current Bonus");
+  comments.Push("Forager Type");
+  comments.Push("Group ID (opinion)");
+  comments.Push("Current Cell");
+  comments.Push("Avatar Cell");
+  comments.Push("Faced Direction");
+  comments.Push("Faced Cell Occupied?");
+  comments.Push("Faced Cell Has Hill?");
+  comments.Push("Faced Cell Has Wall?");
+  comments.Push("Queued Instruction");
+  comments.Push("Trailing NOPs");
+  comments.Push("Did Queued Instruction Execute (-1=no, paying cpu costs; 0=failed; 1=yes)");
+}
+
+
+void cMiniTrace::PrintStatus(ostream& fp, const sMiniTraceRecord& rec, const char* inst_name)
+{
+  // basic status info
+  fp << rec.cycle << " ";
+  if (rec.flags & sMiniTraceRecord::MICRO_OP) fp << rec.micro_op << " ";
+  fp << rec.update << " ";
+  if (rec.flags & sMiniTraceRecord::HW_QUEUE) {
+    fp << rec.queue_eat << " ";
+    fp << rec.queue_move << " ";
+    fp << rec.queue_rotate;
+    fp << (rec.queue_rotate_reverse ? " (-" : " (");
+    fp << rec.queue_rotate_num << ") ";
+  }
+  for (int i = 0; i < rec.num_registers; i++) {
+    fp << rec.reg[i] << " ";
+    fp << "(" << rec.reg_origin[i] << ") ";
+  }
+  // genome loc info
+  fp << rec.thread << " ";
+  fp << rec.ip << " ";
+  fp << rec.read_head << " ";
+  fp << rec.write_head << " ";
+  fp << rec.flow_head << " ";
+  // last output
+  fp << rec.last_output << " ";
+  // phenotype/org status info
+  fp << rec.merit << " ";
+  fp << rec.bonus << " ";
+  fp << rec.forage_target << " ";
+  fp << rec.group << " ";
+  // environment info / things that affect movement
+  fp << rec.cell << " ";
+  if (rec.flags & sMiniTraceRecord::AVATAR) fp << rec.av_cell << " ";
+  fp << rec.facing << " ";
+  fp << rec.faced_occupied << " ";
+  fp << rec.faced_hill << " ";
+  fp << rec.faced_wall << " ";
+  // instruction about to be executed, and any trailing nops
+  fp << inst_name << " ";
+  if (rec.num_nop_mods) {
+    fp.write(rec.nop_mods, rec.num_nop_mods);
+    fp << " ";
+  } else {
+    fp << "NoMods" << " ";
+  }
+}
+
+
+void cMiniTrace::PrintSuccess(ostream& fp, int exec_success)
+{
+  fp << exec_success;
+  fp << endl;
+}
+
+
+void cMiniTrace::WriteBinaryHeader(ostream& fp, const sMiniTraceHeader& header)
+{
+  fp.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  writeValue<unsigned int>(fp, BINARY_VERSION);
+  writeValue<unsigned int>(fp, sizeof(sMiniTraceRecord));
+
+  writeValue(fp, header.flags);
+  writeValue(fp, header.timestamp);
+  writeValue(fp, header.update_born);
+  writeValue(fp, header.org_id);
+  writeValue(fp, header.gen_id);
+  writeValue(fp, header.genome_length);
+  writeString(fp, header.genotype);
+
+  writeValue<int>(fp, header.inst_names.GetSize());
+  for (int i = 0; i < header.inst_names.GetSize(); i++) writeString(fp, header.inst_names[i]);
+}
+
+
+bool cMiniTrace::ReadBinaryHeader(istream& fp, sMiniTraceHeader& header)
+{
+  char magic[sizeof(BINARY_MAGIC)];
+  if (!fp.read(magic, sizeof(magic)) || memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0) return false;
+
+  unsigned int version = 0;
+  unsigned int record_size = 0;
+  if (!readValue(fp, version) || version != BINARY_VERSION) return false;
+  if (!readValue(fp, record_size) || record_size != sizeof(sMiniTraceRecord)) return false;
+
+  if (!readValue(fp, header.flags) || !readValue(fp, header.timestamp) || !readValue(fp, header.update_born) ||
+      !readValue(fp, header.org_id) || !readValue(fp, header.gen_id) || !readValue(fp, header.genome_length) ||
+      !readString(fp, header.genotype)) {
+    return false;
+  }
+
+  int num_insts = 0;
+  if (!readValue(fp, num_insts) || num_insts < 0 || num_insts > 256) return false;
+  header.inst_names.Resize(num_insts);
+  for (int i = 0; i < num_insts; i++) {
+    if (!readString(fp, header.inst_names[i])) return false;
+  }
+
+  return true;
+}
+
+
+bool cMiniTrace::DecodeBinary(istream& in, ostream& out)
+{
+  sMiniTraceHeader header;
+  if (!ReadBinaryHeader(in, header)) return false;
+
+  // Same layout as Avida::Output::File gives the text trace: time stamp, comments, then a blank first data row
+  time_t timestamp = (time_t)header.timestamp;
+  out << "# " << ctime(&timestamp);
+  Apto::Array<cString> comments;
+  GetHeaderComments(header, comments);
+  for (int i = 0; i < comments.GetSize(); i++) out << "# " << comments[i] << "\n";
+  out << endl << endl;
+
+  sMiniTraceRecord rec;
+  while (in.read(reinterpret_cast<char*>(&rec), sizeof(rec))) {
+    if (!(rec.flags & sMiniTraceRecord::SUCCESS_ONLY)) {
+      const bool known_inst = (rec.next_inst >= 0 && rec.next_inst < header.inst_names.GetSize());
+      PrintStatus(out, rec, known_inst ? (const char*)header.inst_names[rec.next_inst] : "?");
+    }
+    if (rec.exec_success != sMiniTraceRecord::NO_SUCCESS) PrintSuccess(out, rec.exec_success);
+  }
+
+  // A trailing partial record means the trace was cut off mid-write
+  return in.gcount() == 0 && out.good();
+}
@@ -0,0 +1,117 @@
+/*
+ *  cMiniTrace.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cMiniTrace_h
+#define cMiniTrace_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+
+#include <iostream>
+
+
+// sMiniTraceRecord - the state of a traced organism before one instruction, and whether that instruction executed
+//
+//   Hardware fills these in field by field, so the text and binary traces are both formatted from the same values.
+//   Records are plain data; the binary trace writes them to disk as is.
+
+struct sMiniTraceRecord
+{
+  static const int MAX_REGISTERS = 12;
+  static const int NO_SUCCESS = -2;     // exec_success when the instruction's outcome was never reported
+
+  enum {
+    MICRO_OP = 0x1,       // hardware reports the current micro-op
+    HW_QUEUE = 0x2,       // hardware reports queued eat/move/rotate actions
+    AVATAR = 0x4,         // organism uses an avatar, so its avatar cell is reported
+    SUCCESS_ONLY = 0x8    // record only closes out the previous status (no status of its own)
+  };
+
+  unsigned int flags;
+  unsigned int cycle;
+  int micro_op;
+  int update;
+  int queue_eat;
+  int queue_move;
+  int queue_rotate;
+  int queue_rotate_reverse;
+  int queue_rotate_num;
+  int num_registers;
+  int reg[MAX_REGISTERS];
+  unsigned int reg_origin[MAX_REGISTERS];
+  int thread;
+  int ip;
+  int read_head;
+  int write_head;
+  int flow_head;
+  unsigned int last_output;
+  double merit;
+  double bonus;
+  int forage_target;
+  int group;
+  int cell;
+  int av_cell;
+  int facing;
+  int faced_occupied;
+  int faced_hill;
+  int faced_wall;
+  int next_inst;
+  int num_nop_mods;
+  char nop_mods[MAX_REGISTERS];
+  int exec_success;
+};
+
+
+// sMiniTraceHeader - everything the text header of a mini trace file is built from
+struct sMiniTraceHeader
+{
+  unsigned int flags;
+  long long timestamp;
+  int update_born;
+  int org_id;
+  int gen_id;
+  int genome_length;
+  cString genotype;
+  Apto::Array<cString> inst_names;   // binary traces only, indexed by opcode
+};
+
+
+// cMiniTrace - formatting shared by the text mini traces and the binary trace decoder
+class cMiniTrace
+{
+public:
+  static const char* const BINARY_EXTENSION;   // ".trcb"
+
+  // Header comment lines (without the leading "# "), following the time stamp
+  static void GetHeaderComments(const sMiniTraceHeader& header, Apto::Array<cString>& comments);
+
+  static void PrintStatus(std::ostream& fp, const sMiniTraceRecord& rec, const char* inst_name);
+  static void PrintSuccess(std::ostream& fp, int exec_success);
+
+  // Binary trace files: a header followed by raw records, in the byte order of the machine that wrote them
+  static void WriteBinaryHeader(std::ostream& fp, const sMiniTraceHeader& header);
+  static bool ReadBinaryHeader(std::istream& fp, sMiniTraceHeader& header);
+
+  // Regenerate the text trace from a binary trace
+  static bool DecodeBinary(std::istream& in, std::ostream& out);
+};
+
+#endif
@@ -28,6 +28,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Provider.h"
 #include "avida/data/Recorder.h"
+#include "avida/util/ThreadPool.h"
 
 #include <cassert>
 
@@ -42,13 +43,20 @@ bool Avida::Data::Manager::s_registered_with_facet_factory =
   Avida::WorldFacet::RegisterFacetType(Avida::Reserved::DataManagerFacetID, DeserializeDataManager);
 
 
-Avida::Data::Manager::Manager() : m_world(NULL), m_available(new DataSet)
+Avida::Data::Manager::Manager(int num_update_threads) : m_world(NULL), m_available(new DataSet), m_update_pool(NULL)
 {
-  
+  if (num_update_threads != 1) {
+    m_update_pool = new Util::ThreadPool(num_update_threads);
+    if (m_update_pool->NumThreads() == 1) {
+      delete m_update_pool;
+      m_update_pool = NULL;
+    }
+  }
 }
 
 Avida::Data::Manager::~Manager()
 {
+  delete m_update_pool;
 }
 
 
@@ -418,6 +426,54 @@ Avida::WorldFacetID Avida::Data::Manager::UpdateAfter() const
 }
 
 
+// Job 0 processes the items that require serial handling in order on the calling (simulation) thread, while the
+// remaining jobs each handle one of the concurrency safe items on the update pool.
+
+class Avida::Data::Manager::ProviderUpdateJob : public Util::ThreadPool::Job
+{
+private:
+  const Apto::Array<ProviderPtr>& m_serial;
+  const Apto::Array<ProviderPtr>& m_concurrent;
+  Update m_update;
+  
+public:
+  ProviderUpdateJob(const Apto::Array<ProviderPtr>& serial, const Apto::Array<ProviderPtr>& concurrent, Update update)
+    : m_serial(serial), m_concurrent(concurrent), m_update(update) { ; }
+  
+  void Execute(int idx)
+  {
+    if (idx == 0) {
+      for (int i = 0; i < m_serial.GetSize(); i++) m_serial[i]->UpdateProvidedValues(m_update);
+    } else {
+      m_concurrent[idx - 1]->UpdateProvidedValues(m_update);
+    }
+  }
+};
+
+class Avida::Data::Manager::RecorderNotifyJob : public Util::ThreadPool::Job
+{
+private:
+  const Apto::Array<RecorderPtr>& m_serial;
+  const Apto::Array<RecorderPtr>& m_concurrent;
+  Update m_update;
+  DataRetrievalFunctor m_drf;
+  
+public:
+  RecorderNotifyJob(const Apto::Array<RecorderPtr>& serial, const Apto::Array<RecorderPtr>& concurrent, Update update,
+                    DataRetrievalFunctor drf)
+    : m_serial(serial), m_concurrent(concurrent), m_update(update), m_drf(drf) { ; }
+  
+  void Execute(int idx)
+  {
+    if (idx == 0) {
+      for (int i = 0; i < m_serial.GetSize(); i++) m_serial[i]->NotifyData(m_update, m_drf);
+    } else {
+      m_concurrent[idx - 1]->NotifyData(m_update, m_drf);
+    }
+  }
+};
+
+
 void Avida::Data::Manager::PerformUpdate(Context&, Update current_update)
 {
   m_current_value_mutex.Lock();
@@ -427,7 +483,18 @@ void Avida::Data::Manager::PerformUpdate(Context&, Update current_update)
   m_rwlock.ReadLock();
   
   // Update all of the active providers
-  for (int i = 0; i < m_active_providers.GetSize(); i++) m_active_providers[i]->UpdateProvidedValues(current_update);
+  if (m_update_pool) {
+    Apto::Array<ProviderPtr> serial_providers;
+    Apto::Array<ProviderPtr> concurrent_providers;
+    for (int i = 0; i < m_active_providers.GetSize(); i++) {
+      if (m_active_providers[i]->IsThreadSafe()) concurrent_providers.Push(m_active_providers[i]);
+      else serial_providers.Push(m_active_providers[i]);
+    }
+    ProviderUpdateJob job(serial_providers, concurrent_providers, current_update);
+    m_update_pool->Execute(job, concurrent_providers.GetSize() + 1);
+  } else {
+    for (int i = 0; i < m_active_providers.GetSize(); i++) m_active_providers[i]->UpdateProvidedValues(current_update);
+  }
   
   // Notify recorders that new data is available
   DataRetrievalFunctor drf(this, &Manager::GetCurrentValue);
@@ -438,18 +505,33 @@ void Avida::Data::Manager::PerformUpdate(Context&, Update current_update)
   // Release RWLock before notification to prevent double RWLocking deadlock during recorder attachment
   m_rwlock.ReadUnlock();
   
-  for (Apto::Set<RecorderPtr>::Iterator it = m_recorders.Begin(); it.Next();) {
-    (*it.Get())->NotifyData(current_update, drf);
+  if (m_update_pool) {
+    Apto::Array<RecorderPtr> serial_recorders;
+    Apto::Array<RecorderPtr> concurrent_recorders;
+    for (Apto::Set<RecorderPtr>::Iterator it = m_recorders.Begin(); it.Next();) {
+      if ((*it.Get())->SupportsConcurrentNotify()) concurrent_recorders.Push(*it.Get());
+      else serial_recorders.Push(*it.Get());
+    }
+    RecorderNotifyJob job(serial_recorders, concurrent_recorders, current_update, drf);
+    m_update_pool->Execute(job, concurrent_recorders.GetSize() + 1);
+  } else {
+    for (Apto::Set<RecorderPtr>::Iterator it = m_recorders.Begin(); it.Next();) {
+      (*it.Get())->NotifyData(current_update, drf);
+    }
   }
   m_recorder_mutex.Unlock();
 }
 
+// The value cache lock is only held to look up and store values, so that concurrently notified recorders can retrieve
+// from thread safe providers in parallel.  Two recorders asking for the same uncached value may both retrieve it; the
+// values are identical and the later store wins.
 Avida::Data::PackagePtr Avida::Data::Manager::GetCurrentValue(const DataID& data_id) const
 {
   PackagePtr rtn;
-  Apto::MutexAutoLock cvmutexlock(m_current_value_mutex);
-  
-  if (m_current_values.Get(data_id, rtn)) return rtn;
+  m_current_value_mutex.Lock();
+  const bool cached = m_current_values.Get(data_id, rtn);
+  m_current_value_mutex.Unlock();
+  if (cached) return rtn;
   
   if (data_id[data_id.GetSize() - 1] == ']') {
     // Find start of argument
@@ -469,20 +551,32 @@ Avida::Data::PackagePtr Avida::Data::Manager::GetCurrentValue(const DataID& data
     m_rwlock.ReadLock();
     ArgumentedProviderPtr arg_provider;
     if (m_active_arg_provider_map.Get(raw_id, arg_provider)) {
-      rtn = arg_provider->GetProvidedValueForArgument(raw_id, argument);
-      if (rtn) m_current_values[data_id] = rtn;
+      if (arg_provider->IsThreadSafe()) {
+        rtn = arg_provider->GetProvidedValueForArgument(raw_id, argument);
+      } else {
+        Apto::MutexAutoLock providerlock(m_provider_mutex);
+        rtn = arg_provider->GetProvidedValueForArgument(raw_id, argument);
+      }
     }
     m_rwlock.ReadUnlock();
   } else {
     m_rwlock.ReadLock();
     ProviderPtr provider;
     if (m_active_provider_map.Get(data_id, provider)) {
-      rtn = provider->GetProvidedValue(data_id);
-      if (rtn) m_current_values[data_id] = rtn;
+      if (provider->IsThreadSafe()) {
+        rtn = provider->GetProvidedValue(data_id);
+      } else {
+        Apto::MutexAutoLock providerlock(m_provider_mutex);
+        rtn = provider->GetProvidedValue(data_id);
+      }
     }
     m_rwlock.ReadUnlock();
   }
   
+  if (rtn) {
+    Apto::MutexAutoLock cvmutexlock(m_current_value_mutex);
+    m_current_values[data_id] = rtn;
+  }
   return rtn;
 }
 
@@ -33,6 +33,11 @@ bool Avida::Data::Provider::SupportsConcurrentUpdate() const
   return false;
 }
 
+bool Avida::Data::Provider::IsThreadSafe() const
+{
+  return false;
+}
+
 
 Avida::Data::PackagePtr Avida::Data::ArgumentedProvider::GetProvidedValuesForArguments(const DataID& data_id,
                                                                                        ConstArgumentSetPtr args) const
@@ -25,3 +25,8 @@
 #include "avida/data/Recorder.h"
 
 Avida::Data::Recorder::~Recorder() { ; }
+
+bool Avida::Data::Recorder::SupportsConcurrentNotify() const
+{
+  return false;
+}
@@ -298,6 +298,11 @@ public:
   // -------- Configuration File config options --------
   CONFIG_ADD_GROUP(CONFIG_FILE_GROUP, "Other configuration Files");
   CONFIG_ADD_VAR(DATA_DIR, cString, "data", "Directory in which config files are found");
+  CONFIG_ADD_VAR(OUTPUT_BUFFER_SIZE, int, 0, "Memory (in KB) for output file data pending on the background writer thread\n0 = write output files synchronously (default)\nWhen enabled, line ends do not flush, so data still queued is lost if the run crashes or aborts");
+  CONFIG_ADD_VAR(DATA_UPDATE_THREADS, int, 1, "Number of threads used to update data providers and notify data recorders each update\n1 = serial updates\n0 = use all available CPUs");
+  CONFIG_ADD_VAR(PROFILE_LEVEL, int, 0, "Built-in profiling of the update loop (see PrintProfilingData)\n0 = Off\n1 = Time each phase of the update\n2 = Also count executions and cycle costs per instruction (see PrintInstructionProfile)");
+  CONFIG_ADD_VAR(PROFILE_SAMPLE_RATE, int, 0, "With PROFILE_LEVEL 2, time one of every N instruction executions per instruction set\n0 = No timing samples");
+  CONFIG_ADD_VAR(BINARY_MINI_TRACES, int, 0, "Write mini traces as fixed-size binary records (.trcb files, convert with avida-trace)\n0 = Text mini traces (.trc files)");
   CONFIG_ADD_VAR(EVENT_FILE, cString, "events.cfg", "File containing list of events during run");
   CONFIG_ADD_VAR(ANALYZE_FILE, cString, "analyze.cfg", "File used for analysis mode");
   CONFIG_ADD_VAR(ENVIRONMENT_FILE, cString, "environment.cfg", "File that describes the environment");
@@ -478,7 +483,8 @@ public:
   // -------- Deme config options --------
   CONFIG_ADD_GROUP(DEME_GROUP, "Demes and Germlines");
   CONFIG_ADD_VAR(NUM_DEMES, int, 1, "Number of independent groups in the population");
-  CONFIG_ADD_VAR(DEMES_COMPETITION_STYLE, int, 0, "How should demes compete?\n0=Fitness proportional selection\n1=Tournament selection");
+  CONFIG_ADD_VAR(DEMES_COMPETITION_STYLE, int, 0, "How should demes compete?\n0=Fitness proportional selection\n1=Tournament selection\n2=Stochastic universal sampling (fitness proportional, evenly spaced picks)");
+  CONFIG_ADD_VAR(PROPORTIONAL_SAMPLER, int, 0, "How fitness proportional deme and organism competitions draw winners\n0=Running total search (same draws as before)\n1=Alias table (constant time per draw, different random sequence)");
   CONFIG_ADD_VAR(DEMES_TOURNAMENT_SIZE, int, 0, "Number of demes that participate in a tournament");
   CONFIG_ADD_VAR(DEMES_OVERRIDE_FITNESS, int, 0, "Should the calculated fitness is used?\n0=yes (default)\n1=no (all fitnesses=1)");
   CONFIG_ADD_VAR(DEMES_USE_GERMLINE, int, 0, "Should demes use a distinct germline? 0: No, 1: Traditional germ lines, 2: Genotype tracking, 3: Organism flagging germline");
@@ -592,6 +598,8 @@ public:
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(HISTORIC_GENOTYPE_MEMORY, int, 0, "Memory (in KB) for fully expanded ancestral genotypes; older ancestral\n  genotypes are compacted into packed records. 0 = never compact");
+  CONFIG_ADD_VAR(HISTORIC_GENOTYPE_STORE, cString, "", "File, relative to the data directory, that compacted ancestral genotype\n  records are spilled to; empty keeps them in memory");
   
 
   // -------- Organism Network config options --------
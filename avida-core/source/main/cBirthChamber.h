@@ -70,6 +70,9 @@ public:
   void ClearEntry(cBirthEntry& entry);
   
   int GetWaitingOffspringNumber(int which_mating_type, int hw_type);
+  
+  // True once a sexual (or waiting asexual) birth has been submitted, after which offspring may be held here
+  bool MayHoldOffspring() const { return m_handler_map.GetSize() > 0; }
   void PrintBirthChamber(const cString& filename, int hw_type);
 
 private:
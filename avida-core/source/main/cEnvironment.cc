@@ -29,6 +29,7 @@
 
 #include "cArgSchema.h"
 #include "cAvidaContext.h"
+#include "cBitArray.h"
 #include "cContextPhenotype.h"
 #include "cContextReactionRequisite.h"
 #include "cEnvReqs.h"
@@ -1327,6 +1328,12 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
   // Do setup for reaction tests...
   m_tasklib.SetupTests(taskctx);
 
+  // Reaction sets for the requisite checks, built the first time a reaction with requisites comes up and kept
+  // current below as reactions trigger
+  cBitArray reactions_done;
+  cBitArray reactions_met;
+  int tot_reactions = -1;
+
   // Loop through all reactions to see if any have been triggered...
   const int num_reactions = reaction_lib.GetSize();
   for (int i = 0; i < num_reactions; i++) {
@@ -1346,7 +1353,11 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
     const bool on_divide = taskctx.GetOnDivide();
 
     // Examine requisites on this reaction
-    if (TestRequisites(taskctx, cur_reaction, task_cnt, reaction_count, on_divide, is_parasite) == false) {
+    if (tot_reactions < 0 && cur_reaction->GetRequisites().GetSize() > 0) {
+      tot_reactions = BuildReactionSets(taskctx, reaction_count, reactions_done, reactions_met);
+    }
+    if (TestRequisites(taskctx, cur_reaction, task_cnt, reaction_count, reactions_done, reactions_met, tot_reactions,
+                       on_divide, is_parasite) == false) {
       if (!skipProcessing){
         continue;
       }
@@ -1395,6 +1406,11 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
       
       if (result.ReactionTriggered(i) == true) {
         reaction_count[i]++;
+        if (tot_reactions >= 0) {
+          tot_reactions++;
+          reactions_done.Set(i, true);
+          reactions_met.Set(i, true);
+        }
         taskctx.GetOrganism()->GetPhenotype().SetFirstReactionCycle(i);
         taskctx.GetOrganism()->GetPhenotype().SetFirstReactionExec(i);
       }
@@ -1405,8 +1421,34 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
   return result.GetActive();
 }
 
+// Fill in the set of reactions performed so far and the set that counts toward requisites (for organisms, reactions
+// stolen by predators count as met), returning the total reaction count
+int cEnvironment::BuildReactionSets(cTaskContext& taskctx, const Apto::Array<int>& reaction_count,
+                                    cBitArray& reactions_done, cBitArray& reactions_met) const
+{
+  const int num_reactions = reaction_count.GetSize();
+  reactions_done.ResizeClear(num_reactions);
+  int tot_reactions = 0;
+  for (int i = 0; i < num_reactions; i++) {
+    tot_reactions += reaction_count[i];
+    if (reaction_count[i] != 0) reactions_done.Set(i, true);
+  }
+
+  reactions_met = reactions_done;
+  if (taskctx.GetOrganism()) {
+    const Apto::Array<int>& stolen_reactions = taskctx.GetOrganism()->GetPhenotype().GetStolenReactionCount();
+    for (int i = 0; i < num_reactions; i++) {
+      if (stolen_reactions[i] != 0) reactions_met.Set(i, true);
+    }
+  }
+
+  return tot_reactions;
+}
+
 bool cEnvironment::TestRequisites(cTaskContext& taskctx, const cReaction* cur_reaction,
-                                  int task_count, const Apto::Array<int>& reaction_count, const bool on_divide, bool is_parasite) const
+                                  int task_count, const Apto::Array<int>& reaction_count,
+                                  const cBitArray& reactions_done, const cBitArray& reactions_met, int tot_reactions,
+                                  const bool on_divide, bool is_parasite) const
 {
   const tList<cReactionRequisite>& req_list = cur_reaction->GetRequisites();
   const int num_reqs = req_list.GetSize();
@@ -1422,44 +1464,10 @@ bool cEnvironment::TestRequisites(cTaskContext& taskctx, const cReaction* cur_re
   for (int i = 0; i < num_reqs; i++) {
     // See if this requisite batch can be satisfied.
     const cReactionRequisite* cur_req = req_it.Next();
-    bool satisfied = true;
-    
-    if (taskctx.GetOrganism()) {
-      // Have all reactions been met?
-      const Apto::Array<int>& stolen_reactions = taskctx.GetOrganism()->GetPhenotype().GetStolenReactionCount();
-      tLWConstListIterator<cReaction> reaction_it(cur_req->GetReactions());
-      while (reaction_it.Next() != NULL) {
-        int react_id = reaction_it.Get()->GetID();
-        if (reaction_count[react_id] == 0 && stolen_reactions[react_id] == 0) {   
-          satisfied = false;
-          break;
-        }
-      }
-    }
-    // If being called as a deme reaction..
-    else {
-      tLWConstListIterator<cReaction> reaction_it(cur_req->GetReactions());
-      while (reaction_it.Next() != NULL) {
-        int react_id = reaction_it.Get()->GetID();
-        if (reaction_count[react_id] == 0) {
-          satisfied = false;
-          break;
-        }
-      }
-    }
     
-    if (satisfied == false) continue;
-
-    // Have all no-reactions been met?
-    tLWConstListIterator<cReaction> noreaction_it(cur_req->GetNoReactions());
-    while (noreaction_it.Next() != NULL) {
-      int react_id = noreaction_it.Get()->GetID();
-      if (reaction_count[react_id] != 0) {
-        satisfied = false;
-        break;
-      }
-    }
-    if (satisfied == false) continue;
+    // Have all reactions been met, and none of the no-reactions?
+    if (!cur_req->GetReactionMask().IsSubsetOf(reactions_met)) continue;
+    if (cur_req->GetNoReactionMask().HasOverlap(reactions_done)) continue;
 
     // Have all task counts been met?
     if (task_count < cur_req->GetMinTaskCount()) continue;
@@ -1470,10 +1478,6 @@ bool cEnvironment::TestRequisites(cTaskContext& taskctx, const cReaction* cur_re
     if (reaction_count[cur_reaction->GetID()] >= cur_req->GetMaxReactionCount()) continue;
     
     // Have all total reaction counts been met?
-    int tot_reactions = 0;
-    for (int i=0; i<reaction_count.GetSize(); i++) {
-      tot_reactions += reaction_count[i];
-    }
     if (tot_reactions < cur_req->GetMinTotReactionCount()) continue;
     if (tot_reactions >= cur_req->GetMaxTotReactionCount()) continue;
     
@@ -42,6 +42,7 @@ namespace Avida {
 class cContextPhenotype;
 class cContextReactionRequisite;
 class cAvidaContext;
+class cBitArray;
 class cReaction;
 class cReactionRequisite;
 class cReactionProcess;
@@ -187,8 +188,12 @@ private:
 
                             const tList<cReactionProcess>& req_proc, bool& force_mark_task) const;
   
+  int BuildReactionSets(cTaskContext& taskctx, const Apto::Array<int>& reaction_count,
+                        cBitArray& reactions_done, cBitArray& reactions_met) const;
   bool TestRequisites(cTaskContext& taskctx, const cReaction* cur_reaction, int task_count,
-                      const Apto::Array<int>& reaction_count, const bool on_divide = false, bool is_parasite=false) const;
+                      const Apto::Array<int>& reaction_count, const cBitArray& reactions_done,
+                      const cBitArray& reactions_met, int tot_reactions,
+                      const bool on_divide = false, bool is_parasite=false) const;
   bool TestContextRequisites(const cReaction* cur_reaction, int task_count, 
                       const Apto::Array<int>& reaction_count, const bool on_divide = false) const;
   void DoProcesses(cAvidaContext& ctx, const tList<cReactionProcess>& process_list, 
@@ -23,15 +23,19 @@
 #include "cEventList.h"
 
 #include "avida/Avida.h"
+#include "avida/core/Feedback.h"
 
 #include "cActionLibrary.h"
+#include "cCheckpoint.h"
 #include "cInitFile.h"
 #include "cStats.h"
 #include "cString.h"
 #include "cWorld.h"
 
+#include <algorithm>
 #include <cfloat>           // for DBL_MIN
 #include <iostream>
+#include <set>
 
 using namespace std;
 
@@ -59,7 +63,7 @@ bool cEventList::AddEvent(eTriggerType trigger, double start, double interval,
   cAction* action = cActionLibrary::GetInstance().Create((const char*)name, m_world, args, feedback);
   
   if (action != NULL) {
-    cEventListEntry* entry = new cEventListEntry(action, name, trigger, start, interval, stop);
+    cEventListEntry* entry = new cEventListEntry(action, name, m_next_entry_id++, trigger, start, interval, stop);
     
     // If there are no events in the list yet.
     if (m_tail == NULL) {
@@ -73,10 +77,7 @@ bool cEventList::AddEvent(eTriggerType trigger, double start, double interval,
       m_tail = entry;
     }
     
-    SyncEvent(entry);
-		
-		if (trigger == BIRTHS_INTERRUPT)  //Operates outside of usual event processing
-			QueueBirthInterruptEvent(start);
+    if (SyncEvent(entry)) IndexEvent(entry);
 		
     ++m_num_events;
     return true;
@@ -153,10 +154,24 @@ void cEventList::Process(cAvidaContext& ctx)
 {
   double t_val = 0; // trigger value
   
-  // Iterate through all entrys in event list
-  cEventListEntry* entry = m_head;
-  while (entry != NULL) {
-    cEventListEntry* next_entry = entry->GetNext();
+  // Only the events whose next trigger value has been reached come out of the index.  They are handled in list order,
+  // just as a walk of the whole list would handle them, and go back into the index once the pass is over.
+  std::vector<cEventListEntry*> due;
+  std::vector<cEventListEntry*> requeue;
+  CollectDueEvents(due, false);
+  
+  int last_id = -1;
+  while (due.size()) {
+    std::pop_heap(due.begin(), due.end(), ListedAfter);
+    cEventListEntry* entry = due.back();
+    due.pop_back();
+    
+    // An action may make an event due that a walk of the list would already have passed; it waits for the next pass
+    if (entry->GetID() < last_id) {
+      requeue.push_back(entry);
+      continue;
+    }
+    last_id = entry->GetID();
     
     // Check trigger condition
     
@@ -164,11 +179,8 @@ void cEventList::Process(cAvidaContext& ctx)
     if (entry->GetTrigger() == IMMEDIATE) {
       entry->GetAction()->Process(ctx);
       Delete(entry);
-    } else if (entry->GetTrigger() != BIRTHS_INTERRUPT) {
-      //BIRTHS_INTERRUPT occur outside of update boundaries
-	  //and should not alter the behavior of other events.
-	  
-	  // Get the value of the appropriate trigger varile
+    } else {
+      // Get the value of the appropriate trigger varile
       t_val = GetTriggerValue(entry->GetTrigger());
       
       if (t_val != DBL_MAX &&
@@ -176,7 +188,9 @@ void cEventList::Process(cAvidaContext& ctx)
           (t_val <= entry->GetStop() || entry->GetStop() == TRIGGER_END)) {
 
         // Process the Action
+        m_processing = entry;
         entry->GetAction()->Process(ctx);
+        m_processing = NULL;
         
         // Handle Interval Adjustment
         if (entry->GetInterval() == TRIGGER_ALL) {
@@ -193,12 +207,24 @@ void cEventList::Process(cAvidaContext& ctx)
         // If the event can never happen now... excize it
         if (entry != NULL && entry->GetStop() != TRIGGER_END &&
             ((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
-             (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0)))
-            Delete(entry);
+             (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))) {
+          Delete(entry);
+          entry = NULL;
+        }
+      } else if (entry->GetTrigger() != GENERATION) {
+        // Updates and births only count up, so an event past its stop can never fire again.  It stays in the list
+        // (until the next sync removes it) but leaves the index.
+        entry = NULL;
       }
-    } 
-    entry = next_entry;
+      
+      if (entry != NULL) requeue.push_back(entry);
+    }
+    
+    // Actions can move the trigger values along (births, for instance), so pick up anything that has just come due
+    CollectDueEvents(due, false);
   }
+  
+  for (unsigned int i = 0; i < requeue.size(); i++) IndexEvent(requeue[i]);
 }
 
 
@@ -217,48 +243,52 @@ void cEventList::ProcessInterrupt(cAvidaContext& ctx)
 {
 	double t_val = 0; // trigger value
 	
-	// Iterate through all entrys in event list
-	cEventListEntry* entry = m_head;
-	while (entry != NULL) {
-		cEventListEntry* next_entry = entry->GetNext();
+	// Only BIRTHS_INTERRUPT events whose start has been reached come out of the index, in list order
+	std::vector<cEventListEntry*> due;
+	std::vector<cEventListEntry*> requeue;
+	CollectDueEvents(due, true);
+	
+	while (due.size()) {
+		std::pop_heap(due.begin(), due.end(), ListedAfter);
+		cEventListEntry* entry = due.back();
+		due.pop_back();
+		
+		// Get the value of the appropriate trigger varile
+		t_val = GetTriggerValue(entry->GetTrigger());
 		
-		//BIRTHS_INTERRUPT occur outside of update boundaries
-		//and should not alter the behavior of other events.
-		if (entry->GetTrigger() == BIRTHS_INTERRUPT) {
+		if (t_val == entry->GetStart() ) {  //This event *must* happen at this value
 			
-			// Get the value of the appropriate trigger varile
-			t_val = GetTriggerValue(entry->GetTrigger());
+			// Process the Action
+			m_processing = entry;
+			entry->GetAction()->Process(ctx);
+			m_processing = NULL;
+			
+			// Handle Interval Adjustment
+			if (entry->GetInterval() == TRIGGER_ALL) {
+				// Do Nothing
+			} else if (entry->GetInterval() == TRIGGER_ONCE) {
+				// If it is a onetime thing, remove it...
+				Delete(entry);
+				entry = NULL;
+			} else {
+				// There is an interval.. so add it
+				entry->NextInterval();
+			}
 			
-			if (t_val == entry->GetStart() ) {  //This event *must* happen at this value
-				
-				// Process the Action
-				entry->GetAction()->Process(ctx);
-				
-				// Handle Interval Adjustment
-				if (entry->GetInterval() == TRIGGER_ALL) {
-					// Do Nothing
-				} else if (entry->GetInterval() == TRIGGER_ONCE) {
-					// If it is a onetime thing, remove it...
-					Delete(entry);
-					entry = NULL;
-				} else {
-					// There is an interval.. so add it
-					entry->NextInterval();
-				}
-				
-				// If the event can never happen now... excize it
-				if (entry != NULL && entry->GetStop() != TRIGGER_END &&
-					((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
-					 (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))){
-					Delete(entry);
-				} else {
-					// We have to add this entry to the BirthInterrupt queue
-					QueueBirthInterruptEvent(entry->GetStart());
-				}
+			// If the event can never happen now... excize it
+			if (entry != NULL && entry->GetStop() != TRIGGER_END &&
+				((entry->GetStart() > entry->GetStop() && entry->GetInterval() > 0) ||
+				 (entry->GetStart() < entry->GetStop() && entry->GetInterval() < 0))){
+				Delete(entry);
+			} else if (entry != NULL) {
+				// We have to add this entry back to the birth interrupt index
+				requeue.push_back(entry);
 			}
-		} 
-		entry = next_entry;
+		}
+		// Otherwise its birth count has already gone by, and it never comes around again; leave it out of the index
 	}
+	
+	for (unsigned int i = 0; i < requeue.size(); i++) IndexEvent(requeue[i]);
 }
 
 
@@ -271,26 +301,30 @@ void cEventList::Sync()
     SyncEvent(entry);
     entry = next_entry;
   }
+  
+  // Trigger values may have jumped (e.g. loaded from a checkpoint), so re-index everything that is left
+  RebuildIndex();
 }
 
 
-void cEventList::SyncEvent(cEventListEntry* entry)
+// Returns false if the event has been removed
+bool cEventList::SyncEvent(cEventListEntry* entry)
 {
   // Ignore events that are immdeiate
-  if (entry->GetTrigger() == IMMEDIATE) return;
+  if (entry->GetTrigger() == IMMEDIATE) return true;
   
   double t_val = GetTriggerValue(entry->GetTrigger());
   
   // If t_val has past the end, remove (even if it is TRIGGER_ALL)
   if (t_val > entry->GetStop()) {
     Delete(entry);
-    return;
+    return false;
   }
   
   // If it is a trigger once and has passed, remove
   if (t_val > entry->GetStart() && entry->GetInterval() == TRIGGER_ONCE) {
     Delete(entry);
-    return;
+    return false;
   }
   
   // If for some reason t_val has been reset or soemthing, rewind
@@ -299,10 +333,72 @@ void cEventList::SyncEvent(cEventListEntry* entry)
   }
   
   // Can't fast forward events that are Triger All
-  if (entry->GetInterval() == TRIGGER_ALL) return;
+  if (entry->GetInterval() == TRIGGER_ALL) return true;
   
   // Keep adding interval to start until we are caught up
   while (t_val > entry->GetStart()) entry->NextInterval();
+  
+  return true;
+}
+
+
+void cEventList::IndexEvent(cEventListEntry* entry)
+{
+  // Undefined triggers never fire
+  if (entry->GetTrigger() == UNDEFINED) return;
+  
+  std::vector<cEventListEntry*>& index = m_trigger_index[entry->GetTrigger()];
+  index.push_back(entry);
+  std::push_heap(index.begin(), index.end(), FiresAfter);
+}
+
+
+void cEventList::RebuildIndex()
+{
+  for (int i = 0; i < NUM_TRIGGER_TYPES; i++) m_trigger_index[i].clear();
+  for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) IndexEvent(entry);
+}
+
+
+// Move every indexed event whose next trigger value has been reached into due, a heap in list order
+void cEventList::CollectDueEvents(std::vector<cEventListEntry*>& due, bool interrupt)
+{
+  for (int trigger = 0; trigger < NUM_TRIGGER_TYPES; trigger++) {
+    if ((trigger == BIRTHS_INTERRUPT) != interrupt) continue;
+    
+    std::vector<cEventListEntry*>& index = m_trigger_index[trigger];
+    if (index.size() == 0) continue;
+    
+    const double t_val = GetTriggerValue((eTriggerType)trigger);
+    while (index.size() && GetIndexKey(index.front()) <= t_val) {
+      std::pop_heap(index.begin(), index.end(), FiresAfter);
+      due.push_back(index.back());
+      index.pop_back();
+      std::push_heap(due.begin(), due.end(), ListedAfter);
+    }
+  }
+}
+
+
+double cEventList::GetIndexKey(const cEventListEntry* entry)
+{
+  // Events set to begin (and immediate events) are due whatever the trigger value
+  if (entry->GetTrigger() == IMMEDIATE || entry->GetStart() == TRIGGER_BEGIN) return -DBL_MAX;
+  return entry->GetStart();
+}
+
+
+bool cEventList::FiresAfter(const cEventListEntry* lhs, const cEventListEntry* rhs)
+{
+  const double lhs_key = GetIndexKey(lhs);
+  const double rhs_key = GetIndexKey(rhs);
+  return (lhs_key > rhs_key) || (lhs_key == rhs_key && lhs->GetID() > rhs->GetID());
+}
+
+
+bool cEventList::ListedAfter(const cEventListEntry* lhs, const cEventListEntry* rhs)
+{
+  return lhs->GetID() > rhs->GetID();
 }
 
 
@@ -354,32 +450,12 @@ void cEventList::PrintEventList(ostream& os)
 }
 
 
-// Dequeue a particular birth interrupt event
-void cEventList::DequeueBirthInterruptEvent(double t_val)
-{
-	double* ptr = m_birth_interrupt_queue.Remove(&t_val);
-	if (ptr != NULL) 
-		delete ptr;
-}
-
-
-// Add a birth event trigger time to avoid unnecessary processing
-void cEventList::QueueBirthInterruptEvent(double t_val)
-{
-	//See if the event is already queued; add if not
-	if (m_birth_interrupt_queue.Find(&t_val) == NULL){
-		double* val_ptr = new double(t_val);
-		m_birth_interrupt_queue.PushRear(val_ptr);
-	}
-}
-
-// Check to see whether or not a particular value is in the asynchronous
-// birth queue.
 bool cEventList::CheckBirthInterruptQueue(double)
 {
 	return false;
-	//Disabled for now...
-	//return (m_birth_interrupt_queue.Find(&t_val) != NULL);
+	//Disabled for now...  The BIRTHS_INTERRUPT index answers this directly once it is re-enabled:
+	//const std::vector<cEventListEntry*>& index = m_trigger_index[BIRTHS_INTERRUPT];
+	//return (index.size() && GetIndexKey(index.front()) <= t_val);
 }
 
 
@@ -484,3 +560,53 @@ bool cEventList::IsEventUpcoming(const cString& event_name) {
 	}
 	return false;
 }
+
+
+void cEventList::SaveState(cCheckpointWriter& ckp) const
+{
+  for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) {
+    if (entry->GetTrigger() == IMMEDIATE) continue;
+    
+    // The event that is saving the checkpoint has not been advanced past the trigger value that fired it yet
+    double start = entry->GetStart();
+    if (entry == m_processing) {
+      if (entry->GetInterval() == TRIGGER_ONCE) continue;
+      if (entry->GetInterval() != TRIGGER_ALL) start += entry->GetInterval();
+    }
+    
+    ckp.WriteInt(entry->GetTrigger());
+    ckp.WriteString(entry->GetName());
+    ckp.WriteString(entry->GetArgs());
+    ckp.WriteDouble(start);
+  }
+  ckp.WriteInt(-1);
+}
+
+
+bool cEventList::LoadState(cCheckpointReader& ckp, Feedback& feedback)
+{
+  // Start values change under the trigger index; the Sync() that follows every population load rebuilds it
+  std::set<cEventListEntry*> restored;
+  for (int trigger = ckp.ReadInt(); trigger >= 0 && ckp.Good(); trigger = ckp.ReadInt()) {
+    const cString name = ckp.ReadString();
+    const cString args = ckp.ReadString();
+    const double start = ckp.ReadDouble();
+    
+    // The event loading the checkpoint is never matched, it is the one part of this list the saving run did not have
+    cEventListEntry* entry = m_head;
+    for (; entry != NULL; entry = entry->GetNext()) {
+      if (entry == m_processing || entry->GetTrigger() != trigger || restored.count(entry)) continue;
+      if (entry->GetName() == name && entry->GetArgs() == args) break;
+    }
+    
+    if (entry == NULL) {
+      feedback.Warning("checkpoint event '%s %s' is not in the event list, it will not fire in the resumed run",
+                       (const char*)name, (const char*)args);
+      continue;
+    }
+    entry->SetStart(start);
+    restored.insert(entry);
+  }
+  
+  return ckp.Good();
+}
@@ -27,7 +27,7 @@
 #include "cAction.h"
 #endif
 
-#include "tList.h"
+#include <vector>
 
 
 namespace Avida {
@@ -35,6 +35,8 @@ namespace Avida {
 };
 
 class cAvidaContext;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cString;
 class cWorld;
 
@@ -61,6 +63,7 @@ public:
   //                  Some statistical information gathered at the end of an update is not
   //                  available or is incomplete with this option.
   enum eTriggerType { UPDATE, GENERATION, IMMEDIATE, BIRTHS, UNDEFINED, BIRTHS_INTERRUPT };
+  static const int NUM_TRIGGER_TYPES = BIRTHS_INTERRUPT + 1;
   
   static const double TRIGGER_BEGIN;  //Are these unsafely defined? @MRR
   static const double TRIGGER_END;
@@ -75,13 +78,22 @@ private:
   cEventListEntry* m_head;
   cEventListEntry* m_tail;
   int m_num_events;
-  
-  tList<double> m_birth_interrupt_queue;
-  
-  void QueueBirthInterruptEvent(double t_val);
-  void DequeueBirthInterruptEvent(double t_val);
-  
-  void SyncEvent(cEventListEntry* event);
+  int m_next_entry_id;
+  cEventListEntry* m_processing;  // Event whose action is running, NULL between actions
+  
+  // Events of each trigger type that may still fire, kept as a heap ordered by the trigger value at which they next
+  // fire, so that processing only has to look at the events that are due.  Entries that can no longer fire under
+  // their (never decreasing) trigger stay in the list but leave the index.
+  std::vector<cEventListEntry*> m_trigger_index[NUM_TRIGGER_TYPES];
+  
+  void IndexEvent(cEventListEntry* entry);
+  void RebuildIndex();
+  void CollectDueEvents(std::vector<cEventListEntry*>& due, bool interrupt);
+  static double GetIndexKey(const cEventListEntry* entry);
+  static bool FiresAfter(const cEventListEntry* lhs, const cEventListEntry* rhs);
+  static bool ListedAfter(const cEventListEntry* lhs, const cEventListEntry* rhs);
+  
+  bool SyncEvent(cEventListEntry* event);
   double GetTriggerValue(eTriggerType trigger) const;
   void Delete(cEventListEntry* entry);
   
@@ -91,7 +103,8 @@ private:
   
   
 public:
-  cEventList(cWorld* world) : m_world(world), m_head(NULL), m_tail(NULL), m_num_events(0) { ; }
+  cEventList(cWorld* world)
+    : m_world(world), m_head(NULL), m_tail(NULL), m_num_events(0), m_next_entry_id(0), m_processing(NULL) { ; }
   ~cEventList();
   
   
@@ -132,6 +145,12 @@ public:
 	//! Check to see if an event with the given name is upcoming at some point in the future.
 	bool IsEventUpcoming(const cString& event_name);
   
+  // Checkpointing - records the trigger value at which each event next fires.  Loading applies the recorded values to
+  // the matching events of this list (same trigger, action and arguments, in list order); recorded events that have
+  // no match are reported, as they will not fire in the resumed run.
+  void SaveState(cCheckpointWriter& ckp) const;
+  bool LoadState(cCheckpointReader& ckp, Feedback& feedback);
+  
   
 private:
   class cEventListEntry
@@ -139,6 +158,7 @@ private:
   private:
     cAction* m_action;
     cString m_name;
+    int m_id;
     
     eTriggerType m_trigger;
     double m_start;
@@ -150,10 +170,10 @@ private:
     cEventListEntry* m_next;
     
   public:
-    cEventListEntry(cAction* action, const cString& name, eTriggerType trigger = UPDATE, double start = TRIGGER_BEGIN,
-                    double interval = TRIGGER_ONCE, double stop = TRIGGER_END, cEventListEntry* prev = NULL,
-                    cEventListEntry* next = NULL)
-    : m_action(action), m_name(name), m_trigger(trigger), m_start(start), m_interval(interval), m_stop(stop)
+    cEventListEntry(cAction* action, const cString& name, int id, eTriggerType trigger = UPDATE,
+                    double start = TRIGGER_BEGIN, double interval = TRIGGER_ONCE, double stop = TRIGGER_END,
+                    cEventListEntry* prev = NULL, cEventListEntry* next = NULL)
+    : m_action(action), m_name(name), m_id(id), m_trigger(trigger), m_start(start), m_interval(interval), m_stop(stop)
     , m_original_start(start), m_prev(prev), m_next(next)
     {
     }
@@ -164,6 +184,7 @@ private:
     void SetNext(cEventListEntry* next) { m_next = next; }
     
     void NextInterval(){ m_start += m_interval; }
+    void SetStart(double start) { m_start = start; }
     void Reset() { m_start = m_original_start; }
     
     // accessors
@@ -171,6 +192,7 @@ private:
     
     const cString GetName() const { assert(m_action != NULL); return m_name; }
     const cString& GetArgs() const { assert(m_action != NULL); return m_action->GetArgs(); }
+    int GetID() const { return m_id; }   // increases along the list
     
     eTriggerType GetTrigger() const { return m_trigger; }
     double GetStart() const { return m_start; }
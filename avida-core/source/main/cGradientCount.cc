@@ -119,6 +119,9 @@ cGradientCount::cGradientCount(cWorld* world, int peakx, int peaky, int height,
   , m_min_usedy(-1)
   , m_max_usedx(-1)
   , m_max_usedy(-1)
+  , m_stamp_spread(-1)
+  , m_stamp_height(-1)
+  , m_stamp_size(0)
 {
   ResetGradRes(m_world->GetDefaultContext(), worldx, worldy);
 }
@@ -272,6 +275,13 @@ void cGradientCount::fillinResourceValues()
   int min_pos_x;
   int max_pos_y;
   int min_pos_y;
+
+  // cells holding resource after the last fill, everything outside of these bounds is already empty
+  const bool prev_used = !(m_min_usedx == -1 || m_min_usedy == -1 || m_max_usedx == -1 || m_max_usedy == -1);
+  const int prev_min_x = m_min_usedx;
+  const int prev_max_x = m_max_usedx;
+  const int prev_min_y = m_min_usedy;
+  const int prev_max_y = m_max_usedy;
   resetUsedBounds();
 
   // if we are resetting a resource, we need to calculate new values for the whole world so we can wipe away any residue
@@ -295,6 +305,22 @@ void cGradientCount::fillinResourceValues()
     min_pos_x = max(m_peakx - m_spread - m_move_speed - 1, 0);
     max_pos_y = min(m_peaky + m_spread + m_move_speed + 1, GetY() - 1);
     min_pos_y = max(m_peaky - m_spread - m_move_speed - 1, 0);
+
+    // of that range, only the cells covered by the new peak or left holding resource by the old one need rewriting
+    int dirty_max_x = m_peakx + m_spread;
+    int dirty_min_x = m_peakx - m_spread;
+    int dirty_max_y = m_peaky + m_spread;
+    int dirty_min_y = m_peaky - m_spread;
+    if (prev_used) {
+      dirty_max_x = max(dirty_max_x, prev_max_x);
+      dirty_min_x = min(dirty_min_x, prev_min_x);
+      dirty_max_y = max(dirty_max_y, prev_max_y);
+      dirty_min_y = min(dirty_min_y, prev_min_y);
+    }
+    max_pos_x = min(max_pos_x, dirty_max_x);
+    min_pos_x = max(min_pos_x, dirty_min_x);
+    max_pos_y = min(max_pos_y, dirty_max_y);
+    min_pos_y = max(min_pos_y, dirty_min_y);
   }
 
   if (m_is_plateau_common == 1 && !m_just_reset && m_world->GetStats().GetUpdate() > 0) {
@@ -311,93 +337,195 @@ void cGradientCount::fillinResourceValues()
     m_current_height = m_height;
   }
 
-  int plateau_cell = 0;
-  for (int ii = min_pos_x; ii < max_pos_x + 1; ii++) {
+  if (m_stamp_spread != m_spread || m_stamp_height != m_height) buildRadialStamp();
+  assignPlateauCells();
+
+  const int worldx = GetX();
+  const bool cone_flow = (m_cone_inflow > 0 || m_cone_outflow > 0 || m_gradient_inflow > 0) &&
+                         !m_just_reset && m_world->GetStats().GetUpdate() > 0;
+
+  if (cone_flow && (m_old_peakx != m_peakx || m_old_peaky != m_peaky)) {
+    // cone cells carry over the amount at their position relative to the old peak, and that cell may already have
+    // been refilled during this pass. Visit the cells column by column, as always, so the same amounts are carried.
+    for (int ii = min_pos_x; ii < max_pos_x + 1; ii++) {
+      for (int jj = min_pos_y; jj < max_pos_y + 1; jj++) {
+        double thisheight = 0.0;
+        const int dx = ii - m_peakx;
+        const int dy = jj - m_peaky;
+        if (abs(dx) <= m_spread && abs(dy) <= m_spread &&
+            m_stamp_dist[(dy + m_spread) * m_stamp_size + dx + m_spread] >= 0) {
+          thisheight = fillinCell(ii, jj, cone_flow);
+        }
+        Element(jj * worldx + ii).SetAmount(thisheight);
+        if (thisheight > 0) updateBounds(ii, jj);
+      }
+    }
+  }
+  else {
+    // fill row by row, following the cell layout. Each row is the span covered by the peak, bracketed by empty cells.
     for (int jj = min_pos_y; jj < max_pos_y + 1; jj++) {
-      double thisheight = 0.0;
-      double thisdist = sqrt((double) (m_peakx - ii) * (m_peakx - ii) + (m_peaky - jj) * (m_peaky - jj));
-      if (m_spread >= thisdist) {
-        // determine theoretical individual cells values and add one to distance from center 
-        // (so that center point = radius 1, not 0)
-        // also used to distinguish plateau cells
-        
-        thisheight = m_current_height / (thisdist + 1);
-        
-        // set the floor values
-        // plateaus will override this so that plateaus can hit 0 when being eaten
-        if (thisheight < m_floor) thisheight = m_floor;
-        
-        // create cylindrical profiles of resources whereever thisheight would be >1 (area where thisdist + 1 <= m_height)
-        // and slopes outside of that range
-        // plateau = -1 turns off this option; if activated, causes 'peaks' to be flat plateaus = plateau value 
-        bool is_plat_cell = ((m_height / (thisdist + 1)) >= 1);
-        // apply plateau inflow(s) and outflow 
-        if ((is_plat_cell && m_plateau >= 0) || (m_plateau < 0 && thisdist == 0 && m_plateau_array.GetSize())) { 
-          if (m_just_reset || m_world->GetStats().GetUpdate() <= 0) {
-            m_past_height = m_height;
-            if (m_plateau >= 0.0) {
-              thisheight = m_plateau;
-            } 
-            else {
-              thisheight = m_height;
-            }
-          } 
-          else { 
-            if (m_is_plateau_common == 0) {
-              m_past_height = m_plateau_array[plateau_cell]; 
-              thisheight = m_past_height + m_plateau_inflow - (m_past_height * m_plateau_outflow);
-              thisheight += m_gradient_inflow / (thisdist + 1);
-              if (thisheight > m_plateau && m_plateau >= 0) {
-                thisheight = m_plateau;
-              } 
-              if (m_plateau < 0 && thisdist == 0 && thisheight > m_height) {
-                thisheight = m_height;
-              }
-            }
-            else if (m_is_plateau_common == 1) {   
-              thisheight = m_common_plat_height;
-            }
-          }
-          if (m_initial && m_initial_plat != -1) thisheight = m_initial_plat;
-          if (thisheight < 0) thisheight = 0;
-          m_plateau_array[plateau_cell] = thisheight;
-          m_plateau_cell_IDs[plateau_cell] = jj * GetX() + ii;
-          plateau_cell ++;
-         }
-        // now apply any off-plateau inflow(s) and outflow
-        else if (!is_plat_cell && (m_cone_inflow > 0 || m_cone_outflow > 0 || m_gradient_inflow > 0)) {
-          if (!m_just_reset && m_world->GetStats().GetUpdate() > 0) {
-            int offsetx = m_old_peakx - m_peakx;
-            int offsety = m_old_peaky - m_peaky;
-            
-            int old_cell_x = ii + offsetx;
-            int old_cell_y = jj + offsety;
-            
-            // cone cells that were previously off the world and moved onto world, start at 0
-            if ( old_cell_x < 0 || old_cell_y < 0 || (old_cell_y > (GetY() - 1)) || (old_cell_x > (GetX() - 1)) ) {
-              thisheight = 0;
-            }
-            else {
-              double past_height = Element(old_cell_y * GetX() + old_cell_x).GetAmount(); 
-              double newheight = past_height; 
-              if (m_cone_inflow > 0 || m_cone_outflow > 0) newheight += m_cone_inflow - (past_height * m_cone_outflow);
-              if (m_gradient_inflow > 0) newheight += m_gradient_inflow / (thisdist + 1); 
-              // don't exceed expected slope value
-              if (newheight < thisheight) thisheight = newheight;
-              if (thisheight < 0) thisheight = 0;
-            }
-          }
+      const int row = jj * worldx;
+      const int dy = jj - m_peaky;
+      int lo = max_pos_x + 1;
+      int hi = max_pos_x;
+      if (dy >= -m_spread && dy <= m_spread) {
+        const int half_width = m_stamp_half_width[dy + m_spread];
+        lo = max(min_pos_x, m_peakx - half_width);
+        hi = min(max_pos_x, m_peakx + half_width);
+      }
+
+      for (int ii = min_pos_x; ii < min(lo, max_pos_x + 1); ii++) Element(row + ii).SetAmount(0.0);
+
+      int row_min = -1;
+      int row_max = -1;
+      for (int ii = lo; ii < hi + 1; ii++) {
+        const double thisheight = fillinCell(ii, jj, cone_flow);
+        Element(row + ii).SetAmount(thisheight);
+        if (thisheight > 0) {
+          if (row_min == -1) row_min = ii;
+          row_max = ii;
         }
       }
-      Element(jj * GetX() + ii).SetAmount(thisheight);
-      if (thisheight > 0) updateBounds(ii, jj);
+      if (row_min != -1) {
+        updateBounds(row_min, jj);
+        updateBounds(row_max, jj);
+      }
+
+      for (int ii = max(hi + 1, lo); ii < max_pos_x + 1; ii++) Element(row + ii).SetAmount(0.0);
     }
-  }         
+  }
   SetCurrPeakX(m_peakx);
   SetCurrPeakY(m_peaky);
   m_just_reset = false;
 }
 
+inline double cGradientCount::fillinCell(int ii, int jj, bool cone_flow)
+{
+  const int stamp_idx = (jj - m_peaky + m_spread) * m_stamp_size + (ii - m_peakx + m_spread);
+  const double thisdist = m_stamp_dist[stamp_idx];
+
+  // determine theoretical individual cells values and add one to distance from center 
+  // (so that center point = radius 1, not 0)
+  // also used to distinguish plateau cells
+  double thisheight = m_current_height / (thisdist + 1);
+  
+  // set the floor values
+  // plateaus will override this so that plateaus can hit 0 when being eaten
+  if (thisheight < m_floor) thisheight = m_floor;
+  
+  // create cylindrical profiles of resources whereever thisheight would be >1 (area where thisdist + 1 <= m_height)
+  // and slopes outside of that range
+  // plateau = -1 turns off this option; if activated, causes 'peaks' to be flat plateaus = plateau value 
+  const int plateau_cell = m_stamp_plat_cell[stamp_idx];
+  // apply plateau inflow(s) and outflow 
+  if (plateau_cell >= 0) {
+    if (m_just_reset || m_world->GetStats().GetUpdate() <= 0) {
+      m_past_height = m_height;
+      if (m_plateau >= 0.0) {
+        thisheight = m_plateau;
+      } 
+      else {
+        thisheight = m_height;
+      }
+    } 
+    else { 
+      if (m_is_plateau_common == 0) {
+        m_past_height = m_plateau_array[plateau_cell]; 
+        thisheight = m_past_height + m_plateau_inflow - (m_past_height * m_plateau_outflow);
+        thisheight += m_gradient_inflow / (thisdist + 1);
+        if (thisheight > m_plateau && m_plateau >= 0) {
+          thisheight = m_plateau;
+        } 
+        if (m_plateau < 0 && thisdist == 0 && thisheight > m_height) {
+          thisheight = m_height;
+        }
+      }
+      else if (m_is_plateau_common == 1) {   
+        thisheight = m_common_plat_height;
+      }
+    }
+    if (m_initial && m_initial_plat != -1) thisheight = m_initial_plat;
+    if (thisheight < 0) thisheight = 0;
+    m_plateau_array[plateau_cell] = thisheight;
+    m_plateau_cell_IDs[plateau_cell] = jj * GetX() + ii;
+  }
+  // now apply any off-plateau inflow(s) and outflow
+  else if (cone_flow && !m_stamp_is_plat[stamp_idx]) {
+    int offsetx = m_old_peakx - m_peakx;
+    int offsety = m_old_peaky - m_peaky;
+    
+    int old_cell_x = ii + offsetx;
+    int old_cell_y = jj + offsety;
+    
+    // cone cells that were previously off the world and moved onto world, start at 0
+    if ( old_cell_x < 0 || old_cell_y < 0 || (old_cell_y > (GetY() - 1)) || (old_cell_x > (GetX() - 1)) ) {
+      thisheight = 0;
+    }
+    else {
+      double past_height = Element(old_cell_y * GetX() + old_cell_x).GetAmount(); 
+      double newheight = past_height; 
+      if (m_cone_inflow > 0 || m_cone_outflow > 0) newheight += m_cone_inflow - (past_height * m_cone_outflow);
+      if (m_gradient_inflow > 0) newheight += m_gradient_inflow / (thisdist + 1); 
+      // don't exceed expected slope value
+      if (newheight < thisheight) thisheight = newheight;
+      if (thisheight < 0) thisheight = 0;
+    }
+  }
+  return thisheight;
+}
+
+void cGradientCount::buildRadialStamp()
+{
+  m_stamp_spread = m_spread;
+  m_stamp_height = m_height;
+  m_stamp_size = (m_spread >= 0) ? 2 * m_spread + 1 : 0;
+
+  m_stamp_dist.ResizeClear(m_stamp_size * m_stamp_size);
+  m_stamp_is_plat.ResizeClear(m_stamp_size * m_stamp_size);
+  m_stamp_plat_cell.ResizeClear(m_stamp_size * m_stamp_size);
+  m_stamp_plat_cell.SetAll(-1);
+  m_stamp_half_width.ResizeClear(m_stamp_size);
+  m_stamp_half_width.SetAll(0);
+  m_stamp_plat_offsets.Resize(0);
+
+  // plateau candidates are listed column by column, the order in which plateau cells have always been numbered
+  for (int dx = -m_spread; dx <= m_spread; dx++) {
+    for (int dy = -m_spread; dy <= m_spread; dy++) {
+      const int stamp_idx = (dy + m_spread) * m_stamp_size + dx + m_spread;
+      double thisdist = sqrt((double) dx * dx + dy * dy);
+      if (m_spread >= thisdist) {
+        m_stamp_dist[stamp_idx] = thisdist;
+        m_stamp_is_plat[stamp_idx] = ((m_height / (thisdist + 1)) >= 1);
+        if (m_stamp_is_plat[stamp_idx]) m_stamp_plat_offsets.Push(stamp_idx);
+        if (dx > m_stamp_half_width[dy + m_spread]) m_stamp_half_width[dy + m_spread] = dx;
+      }
+      else {
+        m_stamp_dist[stamp_idx] = -1;
+        m_stamp_is_plat[stamp_idx] = false;
+      }
+    }
+  }
+}
+
+void cGradientCount::assignPlateauCells()
+{
+  if (!m_stamp_size) return;
+
+  // number the plateau cells of the current peak that fall within the world
+  const int center = m_spread * m_stamp_size + m_spread;
+  m_stamp_plat_cell[center] = -1;
+  int plateau_cell = 0;
+  for (int i = 0; i < m_stamp_plat_offsets.GetSize(); i++) {
+    const int stamp_idx = m_stamp_plat_offsets[i];
+    const int x = m_peakx + (stamp_idx % m_stamp_size) - m_spread;
+    const int y = m_peaky + (stamp_idx / m_stamp_size) - m_spread;
+    if (m_plateau >= 0 && x >= 0 && y >= 0 && x < GetX() && y < GetY()) m_stamp_plat_cell[stamp_idx] = plateau_cell++;
+    else m_stamp_plat_cell[stamp_idx] = -1;
+  }
+  // with plateaus turned off, only the peak itself is tracked
+  if (m_plateau < 0 && m_plateau_array.GetSize()) m_stamp_plat_cell[center] = 0;
+}
+
 void cGradientCount::getCurrentPlatValues()
 { 
   int temp_height = 0;
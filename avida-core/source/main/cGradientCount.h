@@ -116,6 +116,17 @@ private:
   int m_min_usedy;
   int m_max_usedx;
   int m_max_usedy;
+
+  // Radial stamp of the peak, (2 * spread + 1) cells square and centered on the peak.  Rebuilt whenever the spread
+  // or height change, so that refilling the peak does not recompute distances cell by cell.
+  int m_stamp_spread;
+  int m_stamp_height;
+  int m_stamp_size;
+  Apto::Array<double> m_stamp_dist;         // distance from the peak, -1 outside of the spread
+  Apto::Array<bool> m_stamp_is_plat;        // within the edible (height >= 1) radius
+  Apto::Array<int> m_stamp_half_width;      // per row, largest x offset within the spread
+  Apto::Array<int> m_stamp_plat_offsets;    // plateau candidate stamp indices, in plateau cell order
+  Apto::Array<int> m_stamp_plat_cell;       // plateau cell index assigned to each stamp index, -1 if none
     
 public:
   cGradientCount(cWorld* world, int peakx, int peaky, int height, int spread, double plateau, int decay,              
@@ -187,6 +198,9 @@ public:
   
 private:
   void fillinResourceValues();
+  void buildRadialStamp();
+  void assignPlateauCells();
+  inline double fillinCell(int ii, int jj, bool cone_flow);
   void updatePeakRes(cAvidaContext& ctx);
   void moveRes(cAvidaContext& ctx);
   int setHaloOrbit(cAvidaContext& ctx, int current_orbit);
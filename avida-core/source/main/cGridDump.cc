@@ -0,0 +1,163 @@
+/*
+ *  cGridDump.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGridDump.h"
+
+#include "avida/util/ThreadPool.h"
+
+#include "cAvidaConfig.h"
+#include "cPopulation.h"
+#include "cPopulationCell.h"
+#include "cWorld.h"
+
+#include <cstdio>
+
+
+namespace {
+  inline int formatValue(int value, int, char* out) { return cGridDump::FormatInt(value, out); }
+  inline int formatValue(double value, int precision, char* out) { return cGridDump::FormatDouble(value, precision, out); }
+
+  inline int maxValueChars(const int*, int) { return cGridDump::MAX_INT_CHARS; }
+  inline int maxValueChars(const double*, int precision) { return cGridDump::MaxDoubleChars(precision); }
+}
+
+
+class cGridDump::cBand
+{
+public:
+  int first_row;
+  int num_rows;
+  Apto::Array<char> text;
+  int text_size;
+
+  cBand() : first_row(0), num_rows(0), text_size(0) { ; }
+};
+
+
+template <class T, class SourceType> class cGridDump::tBandJob : public Avida::Util::ThreadPool::Job
+{
+private:
+  cPopulation& m_pop;
+  const SourceType& m_source;
+  Apto::Array<T>& m_values;
+  Apto::Array<cBand>& m_bands;
+  const int m_world_x;
+  const bool m_gather;
+  const int m_precision;
+
+public:
+  tBandJob(cPopulation& pop, const SourceType& source, Apto::Array<T>& values, Apto::Array<cBand>& bands, int world_x,
+           bool gather, int precision)
+    : m_pop(pop), m_source(source), m_values(values), m_bands(bands), m_world_x(world_x), m_gather(gather)
+    , m_precision(precision) { ; }
+
+  void Execute(int idx)
+  {
+    cBand& band = m_bands[idx];
+    const int first_cell = band.first_row * m_world_x;
+    const int end_cell = first_cell + band.num_rows * m_world_x;
+
+    if (m_gather) {
+      for (int i = first_cell; i < end_cell; i++) m_values[i] = m_source.Value(m_pop.GetCell(i));
+    }
+
+    // Size the block for the widest possible values, plus a newline per row
+    const T* values = (first_cell < end_cell) ? &m_values[first_cell] : NULL;
+    band.text.Resize((end_cell - first_cell) * maxValueChars(values, m_precision) + band.num_rows);
+    char* out = (band.text.GetSize()) ? &band.text[0] : NULL;
+    int pos = 0;
+    for (int row = 0; row < band.num_rows; row++) {
+      for (int col = 0; col < m_world_x; col++) pos += formatValue(*values++, m_precision, out + pos);
+      out[pos++] = '\n';
+    }
+    band.text_size = pos;
+  }
+};
+
+
+template <class T, class SourceType> void cGridDump::write(std::ostream& fp, const SourceType& source)
+{
+  cPopulation& pop = m_world->GetPopulation();
+  const int world_x = pop.GetWorldX();
+  const int world_y = pop.GetWorldY();
+  const int num_cells = world_x * world_y;
+  if (num_cells <= 0) return;
+
+  Apto::Array<T> values(num_cells);
+  const bool parallel_gather = source.IsThreadSafe();
+  if (!parallel_gather) {
+    for (int i = 0; i < num_cells; i++) values[i] = source.Value(pop.GetCell(i));
+  }
+
+  const int num_bands = (world_y + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+  Apto::Array<cBand> bands(num_bands);
+  for (int b = 0; b < num_bands; b++) {
+    bands[b].first_row = b * ROWS_PER_BAND;
+    bands[b].num_rows = Apto::Min<int>(ROWS_PER_BAND, world_y - bands[b].first_row);
+  }
+
+  const int num_threads = (num_cells < MIN_PARALLEL_CELLS) ? 1 : m_world->GetConfig().MAX_CONCURRENCY.Get();
+  Avida::Util::ThreadPool pool(num_threads);
+  tBandJob<T, SourceType> job(pop, source, values, bands, world_x, parallel_gather, (int)fp.precision());
+  pool.Execute(job, num_bands);
+
+  // Hand the blocks over in row order; the file's buffer passes them on to the output writer thread
+  for (int b = 0; b < num_bands; b++) {
+    if (bands[b].text_size) fp.write(&bands[b].text[0], bands[b].text_size);
+  }
+}
+
+
+void cGridDump::Write(std::ostream& fp, const cIntSource& source)
+{
+  write<int>(fp, source);
+}
+
+void cGridDump::Write(std::ostream& fp, const cDoubleSource& source)
+{
+  write<double>(fp, source);
+}
+
+
+int cGridDump::FormatInt(int value, char* out)
+{
+  char digits[10];
+  unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+  int num_digits = 0;
+  do {
+    digits[num_digits++] = (char)('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude);
+
+  int pos = 0;
+  if (value < 0) out[pos++] = '-';
+  while (num_digits) out[pos++] = digits[--num_digits];
+  out[pos++] = ' ';
+  return pos;
+}
+
+
+// The general float format of an ostream is printf's %g at the stream's precision
+int cGridDump::FormatDouble(double value, int precision, char* out)
+{
+  const int size = MaxDoubleChars(precision);
+  const int written = snprintf(out, size, "%.*g ", precision, value);
+  return (written < size) ? written : size - 1;
+}
@@ -0,0 +1,91 @@
+/*
+ *  cGridDump.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGridDump_h
+#define cGridDump_h
+
+#include "apto/core.h"
+
+#include <iostream>
+
+class cPopulationCell;
+class cWorld;
+
+
+// cGridDump - writes one value per population cell as a text grid (one row per line, each value followed by a space)
+//
+//   The grid is split into bands of rows.  Each band gathers its values into a typed buffer and formats them into its
+//   own text block; bands run in parallel (up to MAX_CONCURRENCY threads) and the blocks are then written to the stream
+//   in row order.  The output is byte for byte what streaming each value through operator<< would produce; doubles
+//   are formatted at the stream's precision, as the default (general) float format does.
+//
+//   Value sources are called from several threads at once, for different cells.  A source that is not safe to call
+//   that way (it draws random numbers, or touches shared state that is not read-only) returns false from
+//   IsThreadSafe(); its values are then gathered on the calling thread, and only the formatting runs in parallel.
+
+class cGridDump
+{
+public:
+  class cIntSource
+  {
+  public:
+    virtual ~cIntSource() { ; }
+    virtual int Value(cPopulationCell& cell) const = 0;
+    virtual bool IsThreadSafe() const { return true; }
+  };
+
+  class cDoubleSource
+  {
+  public:
+    virtual ~cDoubleSource() { ; }
+    virtual double Value(cPopulationCell& cell) const = 0;
+    virtual bool IsThreadSafe() const { return true; }
+  };
+
+private:
+  class cBand;
+  template <class T, class SourceType> class tBandJob;
+
+  enum { ROWS_PER_BAND = 16 };
+  enum { MIN_PARALLEL_CELLS = 4096 };  // smaller grids are not worth waking the worker threads for
+
+  cWorld* m_world;
+
+
+  template <class T, class SourceType> void write(std::ostream& fp, const SourceType& source);
+
+  cGridDump(const cGridDump&); // @not_implemented
+  cGridDump& operator=(const cGridDump&); // @not_implemented
+
+public:
+  explicit cGridDump(cWorld* world) : m_world(world) { ; }
+  ~cGridDump() { ; }
+
+  void Write(std::ostream& fp, const cIntSource& source);
+  void Write(std::ostream& fp, const cDoubleSource& source);
+
+  // Fast formatters; each appends the value and a trailing space at out, returning the number of characters written
+  enum { MAX_INT_CHARS = 12 };
+  static int FormatInt(int value, char* out);
+  static int MaxDoubleChars(int precision) { return precision + 16; }
+  static int FormatDouble(double value, int precision, char* out);
+};
+
+#endif
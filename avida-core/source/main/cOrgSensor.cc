@@ -24,6 +24,8 @@
 #include "cOrgSensor.h"
 
 #include "cEnvironment.h"
+#include "cOrgSpatialIndex.h"
+#include "cPopulation.h"
 #include "cPopulationCell.h"
 #include "cResource.h"
 #include "cResourceCount.h"
@@ -485,6 +487,15 @@ void cOrgSensor::WalkCells(cAvidaContext& ctx, sLookInit& in_defs, const int fac
       if (!do_left && direction == left) continue;
       if (!do_right && direction == right) break;
       
+      // when every cell on this side is in bounds and none of them hold anything sought, there is nothing to test
+      if (num_cells_either_side > 0 && (habitat_used == -2 || TestBounds(center_cell, tot_bounds)) &&
+          TestBounds(center_cell + direction, worldBounds) && TestBounds(center_cell + direction * num_cells_either_side, worldBounds) &&
+          SideIsEmpty(in_defs, val_res, center_cell, direction, num_cells_either_side, worldBounds, false)) {
+        any_valid_side_cells = true;
+        first_step = false;
+        continue;
+      }
+      
       // walk in from the farthest cell on side towards the center
       for (int j = num_cells_either_side; j > 0; j--) {
         bool valid_cell = true;
@@ -691,6 +702,14 @@ void cOrgSensor::WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int fac
     for (int do_lr = 0; do_lr <= 1; do_lr++) {
       if (do_lr == 1) direction = right;
       
+      // when none of the cells on this side hold anything sought, there is nothing to test
+      if (num_cells_either_side > 0 && (habitat_used == -2 || TestBounds(center_cell, tot_bounds)) &&
+          SideIsEmpty(in_defs, val_res, center_cell, direction, num_cells_either_side, worldBounds, true)) {
+        any_valid_side_cells = true;
+        first_step = false;
+        continue;
+      }
+      
       // walk in from the farthest cell on side towards the center
       for (int j = num_cells_either_side; j > 0; j--) {
         bool valid_cell = true;
@@ -851,6 +870,99 @@ void cOrgSensor::CorrectTorusEdge(Apto::Coord<int>& cell, sBounds& worldBounds)
   else if (cell.Y() < worldBounds.min_y) { cell.Y() = worldBounds.max_y - (worldBounds.min_y - cell.Y() - 1); }
 }
 
+int cOrgSensor::GetSideRects(const Apto::Coord<int>& center_cell, const Apto::Coord<int>& direction, int num_cells, sBounds& worldBounds, bool wrap, sBounds rects[2])
+{
+  // side cells run in a straight line along one axis, so they span at most two rectangles once wrapped on a torus
+  const Apto::Coord<int> near_cell = center_cell + direction;
+  const Apto::Coord<int> far_cell = center_cell + direction * num_cells;
+  
+  int num_rects = 1;
+  rects[0].min_x = min(near_cell.X(), far_cell.X());
+  rects[0].max_x = max(near_cell.X(), far_cell.X());
+  rects[0].min_y = min(near_cell.Y(), far_cell.Y());
+  rects[0].max_y = max(near_cell.Y(), far_cell.Y());
+  
+  if (wrap) {
+    const bool along_x = (direction.X() != 0);
+    int& lo = (along_x) ? rects[0].min_x : rects[0].min_y;
+    int& hi = (along_x) ? rects[0].max_x : rects[0].max_y;
+    const int world_min = (along_x) ? worldBounds.min_x : worldBounds.min_y;
+    const int world_max = (along_x) ? worldBounds.max_x : worldBounds.max_y;
+    const int world_size = world_max - world_min + 1;
+    
+    if (hi - lo + 1 >= world_size) {
+      lo = world_min;
+      hi = world_max;
+    } else if (lo < world_min || hi > world_max) {
+      rects[1] = rects[0];
+      int& lo2 = (along_x) ? rects[1].min_x : rects[1].min_y;
+      int& hi2 = (along_x) ? rects[1].max_x : rects[1].max_y;
+      if (lo < world_min) {
+        lo2 = lo + world_size;
+        hi2 = world_max;
+        lo = world_min;
+      } else {
+        lo2 = world_min;
+        hi2 = hi - world_size;
+        hi = world_max;
+      }
+      num_rects = 2;
+    }
+  }
+  return num_rects;
+}
+
+// Returns true only if testing each of the side cells would find nothing (but never draws random numbers)
+bool cOrgSensor::SideIsEmpty(sLookInit& in_defs, const Apto::Array<int, Apto::Smart>& val_res, const Apto::Coord<int>& center_cell, const Apto::Coord<int>& direction, int num_cells, sBounds& worldBounds, bool wrap)
+{
+  sBounds rects[2];
+  const int num_rects = GetSideRects(center_cell, direction, num_cells, worldBounds, wrap, rects);
+  
+  if (in_defs.habitat == -2) {
+    // organisms and avatars, as counted by TestCell for the search type
+    const cOrgSpatialIndex& org_index = m_world->GetPopulation().GetOrgSpatialIndex();
+    cOrgSpatialIndex::eLayer layers[2];
+    int num_layers = 1;
+    if (!m_use_avatar) layers[0] = cOrgSpatialIndex::ORGANISMS;
+    else if (m_use_avatar == 2) {
+      if (in_defs.search_type > 0) layers[0] = cOrgSpatialIndex::PREDATOR_AVATARS;
+      else if (in_defs.search_type < 0) layers[0] = cOrgSpatialIndex::PREY_AVATARS;
+      else {
+        layers[0] = cOrgSpatialIndex::PREDATOR_AVATARS;
+        layers[1] = cOrgSpatialIndex::PREY_AVATARS;
+        num_layers = 2;
+      }
+    }
+    else return false;
+    
+    for (int i = 0; i < num_rects; i++) {
+      for (int l = 0; l < num_layers; l++) {
+        if (org_index.AnyNear(layers[l], rects[i].min_x, rects[i].min_y, rects[i].max_x, rects[i].max_y)) return false;
+      }
+    }
+    return true;
+  }
+  
+  if (in_defs.habitat == 3) return false;
+  
+  cResourceCount* res_count = m_organism->GetOrgInterface().GetResourceCount();
+  if (res_count == NULL) return false;
+  
+  for (int i = 0; i < num_rects; i++) {
+    for (int k = 0; k < val_res.GetSize(); k++) {
+      // TestCell ignores cells outside of each resource's bounds
+      const sBounds& res_bounds = m_soloBounds[val_res[k]];
+      const int min_x = max(rects[i].min_x, res_bounds.min_x);
+      const int min_y = max(rects[i].min_y, res_bounds.min_y);
+      const int max_x = min(rects[i].max_x, res_bounds.max_x);
+      const int max_y = min(rects[i].max_y, res_bounds.max_y);
+      if (min_x > max_x || min_y > max_y) continue;
+      if (res_count->HasResourceInArea(val_res[k], min_x, min_y, max_x, max_y)) return false;
+    }
+  }
+  return true;
+}
+
 void cOrgSensor::SetWalkLimits(cAvidaContext& ctx, sLookInit& in_defs, sWalkLimits& limits, sBounds& worldBounds, sBounds& tot_bounds, Apto::Array<int, Apto::Smart>& val_res, int worldx, Apto::Coord<int>& this_cell, int facing, int cell, Apto::Coord<int>& center_cell, const Apto::Coord<int>& ahead_dir)
 {
   limits.start = 0;
@@ -129,6 +129,8 @@ class cOrgSensor
 
   void WalkTorus(cAvidaContext& ctx, sLookInit& in_defs, const int facing, const int cell_id, sWalkLimits& limits, sLookOut& stuff_seen, Apto::Coord<int>& center_cell, sBounds& tot_bounds, sBounds& worldBounds, const Apto::Array<int, Apto::Smart>& val_res, Apto::Coord<int>& this_cell, const Apto::Coord<int>& ahead_dir, const int& worldx);
   void CorrectTorusEdge(Apto::Coord<int>& cell, sBounds& worldBounds);
+  int GetSideRects(const Apto::Coord<int>& center_cell, const Apto::Coord<int>& direction, int num_cells, sBounds& worldBounds, bool wrap, sBounds rects[2]);
+  bool SideIsEmpty(sLookInit& in_defs, const Apto::Array<int, Apto::Smart>& val_res, const Apto::Coord<int>& center_cell, const Apto::Coord<int>& direction, int num_cells, sBounds& worldBounds, bool wrap);
   void GetTorusTravelDist(int& travel_dist, int& x_dist, int& y_dist, const int facing, const int worldx, const int worldy);
   void GetConfusionOddsDensity(cAvidaContext& ctx, double& odds, cOrganism* first_org);
   void GetConfusionOddsFacings(cAvidaContext& ctx, double& odds, cOrganism* first_org);
@@ -0,0 +1,67 @@
+/*
+ *  cOrgSpatialIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cOrgSpatialIndex.h"
+
+
+cOrgSpatialIndex::cOrgSpatialIndex() : m_world_x(0), m_world_y(0), m_tiles_x(0), m_tiles_y(0)
+{
+  for (int i = 0; i < NUM_LAYERS; i++) m_totals[i] = 0;
+}
+
+void cOrgSpatialIndex::Resize(int world_x, int world_y)
+{
+  m_world_x = world_x;
+  m_world_y = world_y;
+  m_tiles_x = (world_x + ORG_INDEX_TILE_SIZE - 1) / ORG_INDEX_TILE_SIZE;
+  m_tiles_y = (world_y + ORG_INDEX_TILE_SIZE - 1) / ORG_INDEX_TILE_SIZE;
+  for (int i = 0; i < NUM_LAYERS; i++) {
+    m_tile_counts[i].ResizeClear(m_tiles_x * m_tiles_y);
+    m_tile_counts[i].SetAll(0);
+    m_totals[i] = 0;
+  }
+}
+
+int cOrgSpatialIndex::CountNear(eLayer layer, int min_x, int min_y, int max_x, int max_y) const
+{
+  if (min_x < 0) min_x = 0;
+  if (min_y < 0) min_y = 0;
+  if (max_x > m_world_x - 1) max_x = m_world_x - 1;
+  if (max_y > m_world_y - 1) max_y = m_world_y - 1;
+  if (min_x > max_x || min_y > max_y) return 0;
+  
+  const int min_tx = min_x / ORG_INDEX_TILE_SIZE;
+  const int max_tx = max_x / ORG_INDEX_TILE_SIZE;
+  const int min_ty = min_y / ORG_INDEX_TILE_SIZE;
+  const int max_ty = max_y / ORG_INDEX_TILE_SIZE;
+  
+  const Apto::Array<int>& counts = m_tile_counts[layer];
+  int count = 0;
+  for (int ty = min_ty; ty <= max_ty; ty++) {
+    for (int tx = min_tx; tx <= max_tx; tx++) count += counts[ty * m_tiles_x + tx];
+  }
+  return count;
+}
+
+bool cOrgSpatialIndex::AnyNear(eLayer layer, int min_x, int min_y, int max_x, int max_y) const
+{
+  if (m_totals[layer] == 0) return false;
+  return CountNear(layer, min_x, min_y, max_x, max_y) > 0;
+}
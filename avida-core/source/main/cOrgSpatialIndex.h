@@ -0,0 +1,87 @@
+/*
+ *  cOrgSpatialIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOrgSpatialIndex_h
+#define cOrgSpatialIndex_h
+
+#include "apto/core.h"
+
+#include <cassert>
+
+
+/* cOrgSpatialIndex counts what occupies the world grid, per square tile of ORG_INDEX_TILE_SIZE cells, in separate
+ * layers for organisms and for predator (input) and prey (output) avatars.  Cells report insertions and removals as
+ * they happen, so the counts are always current.  Searches use the counts to rule out whole stretches of cells
+ * without visiting them; a tile with a nonzero count still has to be checked cell by cell.
+ */
+
+const int ORG_INDEX_TILE_SIZE = 8;
+
+class cOrgSpatialIndex
+{
+public:
+  enum eLayer {
+    ORGANISMS = 0,
+    PREDATOR_AVATARS,
+    PREY_AVATARS,
+    NUM_LAYERS
+  };
+  
+private:
+  int m_world_x;
+  int m_world_y;
+  int m_tiles_x;
+  int m_tiles_y;
+  Apto::Array<int> m_tile_counts[NUM_LAYERS];
+  int m_totals[NUM_LAYERS];
+  
+  cOrgSpatialIndex(const cOrgSpatialIndex&); // @not_implemented
+  cOrgSpatialIndex& operator=(const cOrgSpatialIndex&); // @not_implemented
+  
+public:
+  cOrgSpatialIndex();
+  
+  void Resize(int world_x, int world_y);
+  
+  inline void Add(eLayer layer, int cell_id) { adjust(layer, cell_id, 1); }
+  inline void Remove(eLayer layer, int cell_id) { adjust(layer, cell_id, -1); }
+  
+  int GetTotal(eLayer layer) const { return m_totals[layer]; }
+  
+  // Number of entries in the tiles overlapping the (inclusive) rectangle, never less than the number within it
+  int CountNear(eLayer layer, int min_x, int min_y, int max_x, int max_y) const;
+  bool AnyNear(eLayer layer, int min_x, int min_y, int max_x, int max_y) const;
+  
+private:
+  inline void adjust(eLayer layer, int cell_id, int change);
+};
+
+
+inline void cOrgSpatialIndex::adjust(eLayer layer, int cell_id, int change)
+{
+  // cells outside of the world grid (e.g. before setup) are not tracked
+  if (cell_id < 0 || cell_id >= m_world_x * m_world_y) return;
+  const int tile = (cell_id / m_world_x / ORG_INDEX_TILE_SIZE) * m_tiles_x + (cell_id % m_world_x) / ORG_INDEX_TILE_SIZE;
+  m_tile_counts[layer][tile] += change;
+  m_totals[layer] += change;
+  assert(m_tile_counts[layer][tile] >= 0);
+}
+
+#endif
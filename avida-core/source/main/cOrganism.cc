@@ -26,6 +26,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cDeme.h"
 #include "cEnvironment.h"
@@ -51,7 +52,7 @@ using namespace Avida;
 
 // Referenced external properties
 // --------------------------------------------------------------------------------------------------------------
-static const Apto::BasicString<Apto::ThreadSafe> s_ext_prop_name_instset("instset");
+static const PropertyKey s_ext_prop_name_instset("instset");
 
 
 // Internal cOrganism Properties
@@ -109,6 +110,20 @@ public:
 struct OrgGlobalPropMap
 {
   Apto::Map<Apto::String, OrgPropRetrievalContainer*> prop_map;
+  Apto::Array<OrgPropRetrievalContainer*> prop_slots; // same containers, indexed by PropertyKey slot
+  
+  void Define(const PropertyID& prop_id, OrgPropRetrievalContainer* container)
+  {
+    prop_map.Set(prop_id, container);
+    
+    const int slot_id = PropertyKey::Intern(prop_id);
+    const int old_size = prop_slots.GetSize();
+    if (slot_id >= old_size) {
+      prop_slots.Resize(slot_id + 1);
+      for (int i = old_size; i < slot_id; i++) prop_slots[i] = NULL;
+    }
+    prop_slots[slot_id] = container;
+  }
   
   ~OrgGlobalPropMap()
   {
@@ -127,7 +142,7 @@ typedef Apto::SingletonHolder<OrgGlobalPropMap, Apto::CreateWithNew, Apto::Destr
 void cOrganism::Initialize()
 {
 #define DEFINE_PROP(NAME, TYPE, FUNCTION, DESC) s_prop_desc_map.Set(s_prop_name_ ## NAME, DESC); \
-  OrgGlobalPropMapSingleton::Instance().prop_map.Set(s_prop_name_ ## NAME, new OrgPropOfType<TYPE>(s_prop_name_ ## NAME, &cOrganism::FUNCTION));
+  OrgGlobalPropMapSingleton::Instance().Define(s_prop_name_ ## NAME, new OrgPropOfType<TYPE>(s_prop_name_ ## NAME, &cOrganism::FUNCTION));
   DEFINE_PROP(genome, Apto::String, getGenomeString, "Genome");
   DEFINE_PROP(src_transmission_type, int, getSrcTransmissionType, "Source Transmission Type");
   DEFINE_PROP(age, int, getAge, "Age");
@@ -727,6 +742,53 @@ double cOrganism::GetNeutralMin() const { return m_world->GetConfig().NEUTRAL_MI
 double cOrganism::GetNeutralMax() const { return m_world->GetConfig().NEUTRAL_MAX.Get(); }
 
 
+static void saveBufferState(cCheckpointWriter& ckp, const tBuffer<int>& buf)
+{
+  ckp.WriteIntArray(buf.GetRawData());
+  ckp.WriteInt(buf.GetOffset());
+  ckp.WriteInt(buf.GetTotal());
+  ckp.WriteInt(buf.GetLastTotal());
+}
+
+static void loadBufferState(cCheckpointReader& ckp, tBuffer<int>& buf)
+{
+  Apto::Array<int> data;
+  ckp.ReadIntArray(data);
+  const int offset = ckp.ReadInt();
+  const int total = ckp.ReadInt();
+  const int last_total = ckp.ReadInt();
+  if (ckp.Good() && data.GetSize() == buf.GetCapacity()) buf.SetRawState(data, offset, total, last_total);
+}
+
+void cOrganism::SaveState(cCheckpointWriter& ckp) const
+{
+  ckp.WriteInt(m_input_pointer);
+  saveBufferState(ckp, m_input_buf);
+  saveBufferState(ckp, m_output_buf);
+  saveBufferState(ckp, m_received_messages);
+
+  m_phenotype.SaveState(ckp);
+
+  // Populations on hardware types without checkpoint support are refused by cPopulation::SaveCheckpoint
+  const bool save_hw = m_hardware->SupportsCheckpoint();
+  ckp.WriteBool(save_hw);
+  if (save_hw) m_hardware->SaveState(ckp);
+}
+
+bool cOrganism::LoadState(cCheckpointReader& ckp)
+{
+  m_input_pointer = ckp.ReadInt();
+  loadBufferState(ckp, m_input_buf);
+  loadBufferState(ckp, m_output_buf);
+  loadBufferState(ckp, m_received_messages);
+
+  m_phenotype.LoadState(ckp);
+
+  if (ckp.ReadBool() && !m_hardware->LoadState(ckp)) return false;
+
+  return ckp.Good();
+}
+
 void cOrganism::PrintStatus(ostream& fp)
 {
   fp << "---------------------------" << endl;
@@ -1630,6 +1692,12 @@ bool cOrganism::OrgPropertyMap::Has(const PropertyID& p_id) const
   return OrgGlobalPropMapSingleton::Instance().prop_map.Has(p_id);
 }
 
+bool cOrganism::OrgPropertyMap::Has(const PropertyKey& p_key) const
+{
+  const Apto::Array<OrgPropRetrievalContainer*>& prop_slots = OrgGlobalPropMapSingleton::Instance().prop_slots;
+  return (p_key.Slot() < prop_slots.GetSize() && prop_slots[p_key.Slot()]);
+}
+
 const Avida::Property& cOrganism::OrgPropertyMap::Get(const PropertyID& p_id) const
 {
   OrgPropRetrievalContainer* container = NULL;
@@ -1640,6 +1708,16 @@ const Avida::Property& cOrganism::OrgPropertyMap::Get(const PropertyID& p_id) co
   return *s_default_prop;
 }
 
+const Avida::Property& cOrganism::OrgPropertyMap::Get(const PropertyKey& p_key) const
+{
+  const Apto::Array<OrgPropRetrievalContainer*>& prop_slots = OrgGlobalPropMapSingleton::Instance().prop_slots;
+  if (p_key.Slot() < prop_slots.GetSize() && prop_slots[p_key.Slot()]) {
+    return prop_slots[p_key.Slot()]->Get(m_organism, this);
+  }
+  
+  return *s_default_prop;
+}
+
 
 bool cOrganism::OrgPropertyMap::SetValue(const PropertyID& p_id, const Apto::String& prop_value) { return false; }
 bool cOrganism::OrgPropertyMap::SetValue(const PropertyID& p_id, const int prop_value) { return false; }
@@ -46,6 +46,8 @@
 
 class cAvidaContext;
 class cBioGroup;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cContextPhenotype;
 class cEnvironment;
 class cHardwareBase;
@@ -136,6 +138,8 @@ public:
   void HardwareReset(cAvidaContext& ctx);
   void NotifyDeath(cAvidaContext& ctx);
 
+  void SaveState(cCheckpointWriter& ckp) const;
+  bool LoadState(cCheckpointReader& ckp);
   void PrintStatus(std::ostream& fp);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success);
@@ -782,13 +786,17 @@ private:
     LIB_LOCAL OrgPropertyMap(cOrganism* organism);
     LIB_LOCAL ~OrgPropertyMap();
     
+    using PropertyMap::SetValue;
+    
     LIB_LOCAL int GetSize() const;
     
     LIB_LOCAL bool operator==(const PropertyMap& p) const;
     
     LIB_LOCAL bool Has(const PropertyID& p_id) const;
+    LIB_LOCAL bool Has(const PropertyKey& p_key) const;
     
     LIB_LOCAL const Property& Get(const PropertyID& p_id) const;
+    LIB_LOCAL const Property& Get(const PropertyKey& p_key) const;
     
     LIB_LOCAL bool SetValue(const PropertyID& p_id, const Apto::String& prop_value);
     LIB_LOCAL bool SetValue(const PropertyID& p_id, const int prop_value);
@@ -99,8 +99,9 @@ void cPhenPlastGenotype::Process(cCPUTestInfo& test_info, cWorld* world, cAvidaC
     m_avg_fitness += freq * fit;
     m_phenotypic_entropy -= freq * log(freq) / log(2.0);
     
-    for (int i = 0; i < num_tasks; i++)
-      m_task_probabilities[i] += (this_phen->GetLastTaskCount()[i] > 0) ? freq : 0;
+    const cBitArray& task_set = this_phen->GetLastTaskSet();
+    for (int i = task_set.FindBit1(); i >= 0; i = task_set.FindBit1(i + 1))
+      m_task_probabilities[i] += freq;
     
     m_viable_probability += (this_phen->IsViable() > 0) ? freq : 0;
     ++uit;
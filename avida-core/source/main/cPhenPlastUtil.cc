@@ -26,13 +26,15 @@
 #include "cPhenPlastGenotype.h"
 #include "cPhenPlastSummary.h"
 
+static const Avida::PropertyKey s_prop_id_genome("genome");
+
 
 int cPhenPlastUtil::GetNumPhenotypes(cAvidaContext& ctx, cWorld* world, Systematics::GroupPtr bg)
 {
   Apto::SmartPtr<cPhenPlastSummary> ps = bg->GetData<cPhenPlastSummary>();
   if (!ps) {
     
-    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get("genome"))));
+    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get(s_prop_id_genome))));
     bg->AttachData(ps);
   }
   
@@ -44,7 +46,7 @@ double cPhenPlastUtil::GetPhenotypicEntropy(cAvidaContext& ctx, cWorld* world, S
   Apto::SmartPtr<cPhenPlastSummary> ps = bg->GetData<cPhenPlastSummary>();
   if (!ps) {
     
-    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get("genome"))));
+    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get(s_prop_id_genome))));
     bg->AttachData(ps);
   }
   
@@ -56,7 +58,7 @@ double cPhenPlastUtil::GetTaskProbability(cAvidaContext& ctx, cWorld* world, Sys
   Apto::SmartPtr<cPhenPlastSummary> ps = bg->GetData<cPhenPlastSummary>();
   if (!ps) {
     
-    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get("genome"))));
+    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get(s_prop_id_genome))));
     bg->AttachData(ps);
   }
   
@@ -68,7 +70,7 @@ const Apto::Array<double>& cPhenPlastUtil::GetTaskProbabilities(cAvidaContext& c
   Apto::SmartPtr<cPhenPlastSummary> ps = bg->GetData<cPhenPlastSummary>();
   if (!ps) {
     
-    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get("genome"))));
+    ps = Apto::SmartPtr<cPhenPlastSummary>(TestPlasticity(ctx, world, Genome(bg->Properties().Get(s_prop_id_genome))));
     bg->AttachData(ps);
   }
   
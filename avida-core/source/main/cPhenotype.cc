@@ -22,6 +22,7 @@
 
 #include "cPhenotype.h"
 #include "avida/systematics/Types.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cEnvironment.h"
 #include "cDeme.h"
@@ -55,6 +56,7 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
 , first_reaction_execs(m_world->GetEnvironment().GetReactionLib().GetSize())
 , cur_stolen_reaction_count(m_world->GetEnvironment().GetReactionLib().GetSize())
 , cur_reaction_add_reward(m_world->GetEnvironment().GetReactionLib().GetSize())
+, m_inst_cur(0)
 , cur_sense_count(m_world->GetStats().GetSenseSize())
 , sensed_resources(m_world->GetEnvironment().GetResourceLib().GetSize())
 , cur_task_time(m_world->GetEnvironment().GetNumTasks())   // Added for tracking time; WRE 03-18-07
@@ -160,11 +162,17 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   cur_rbins_avail          = in_phen.cur_rbins_avail;
   cur_collect_spec_counts  = in_phen.cur_collect_spec_counts;
   cur_reaction_count       = in_phen.cur_reaction_count;            
+  m_cur_task_ids           = in_phen.m_cur_task_ids;
+  m_cur_reaction_ids       = in_phen.m_cur_reaction_ids;
+  m_cur_task_set           = in_phen.m_cur_task_set;
   first_reaction_cycles    = in_phen.first_reaction_cycles;            
   first_reaction_execs     = first_reaction_execs;            
   cur_reaction_add_reward  = in_phen.cur_reaction_add_reward;     
-  cur_inst_count           = in_phen.cur_inst_count;                 
-  cur_from_sensor_count    = in_phen.cur_from_sensor_count;
+  m_inst_cur               = in_phen.m_inst_cur;
+  m_inst_count[0]          = in_phen.m_inst_count[0];
+  m_inst_count[1]          = in_phen.m_inst_count[1];
+  m_from_sensor_count[0]   = in_phen.m_from_sensor_count[0];
+  m_from_sensor_count[1]   = in_phen.m_from_sensor_count[1];
   cur_group_attack_count    = in_phen.cur_group_attack_count;
   cur_top_pred_group_attack_count    = in_phen.cur_top_pred_group_attack_count;
   cur_killed_targets       = in_phen.cur_killed_targets;
@@ -186,7 +194,8 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   last_mating_display_a = in_phen.last_mating_display_a;
   last_mating_display_b = in_phen.last_mating_display_b;  
   
-  cur_from_message_count    = in_phen.cur_from_message_count;
+  m_from_message_count[0]   = in_phen.m_from_message_count[0];
+  m_from_message_count[1]   = in_phen.m_from_message_count[1];
 
   // Dynamically allocated m_task_states requires special handling
   for (Apto::Map<void*, cTaskState*>::ConstIterator it = in_phen.m_task_states.Begin(); it.Next();) {
@@ -211,9 +220,10 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   last_rbins_avail         = in_phen.last_rbins_avail;
   last_collect_spec_counts = in_phen.last_collect_spec_counts;
   last_reaction_count      = in_phen.last_reaction_count;
+  m_last_task_ids          = in_phen.m_last_task_ids;
+  m_last_reaction_ids      = in_phen.m_last_reaction_ids;
+  m_last_task_set          = in_phen.m_last_task_set;
   last_reaction_add_reward = in_phen.last_reaction_add_reward; 
-  last_inst_count          = in_phen.last_inst_count;	  
-  last_from_sensor_count   = in_phen.last_from_sensor_count;
   last_group_attack_count   = in_phen.last_group_attack_count;
   last_top_pred_group_attack_count   = in_phen.last_top_pred_group_attack_count;
   last_killed_targets      = in_phen.last_killed_targets;
@@ -225,8 +235,6 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   total_energy_donated     = in_phen.total_energy_donated;
   total_energy_received    = in_phen.total_energy_received;
   total_energy_applied     = in_phen.total_energy_applied;
-  
-  last_from_message_count   = in_phen.last_from_message_count;
 
   // 4. Records from this organisms life...
   num_divides              = in_phen.num_divides;   
@@ -405,9 +413,9 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -456,8 +464,8 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   last_collect_spec_counts  = parent_phenotype.last_collect_spec_counts;
   last_reaction_count       = parent_phenotype.last_reaction_count;
   last_reaction_add_reward  = parent_phenotype.last_reaction_add_reward;
-  last_inst_count           = parent_phenotype.last_inst_count;
-  last_from_sensor_count    = parent_phenotype.last_from_sensor_count;
+  m_inst_count[1 - m_inst_cur] = parent_phenotype.m_inst_count[1 - parent_phenotype.m_inst_cur];
+  m_from_sensor_count[1 - m_inst_cur] = parent_phenotype.m_from_sensor_count[1 - parent_phenotype.m_inst_cur];
   last_group_attack_count    = parent_phenotype.last_group_attack_count;
   last_top_pred_group_attack_count    = parent_phenotype.last_top_pred_group_attack_count;
   last_killed_targets       = parent_phenotype.last_killed_targets;
@@ -467,7 +475,7 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   last_fitness              = CalcFitness(last_merit_base, last_bonus, gestation_time, last_cpu_cycles_used);
   last_child_germline_propensity = parent_phenotype.last_child_germline_propensity;   // chance of child being a germline cell; @JEB
   
-  last_from_message_count    = parent_phenotype.last_from_message_count;
+  m_from_message_count[1 - m_inst_cur] = parent_phenotype.m_from_message_count[1 - parent_phenotype.m_inst_cur];
 
   // Setup other miscellaneous values...
   num_divides     = 0;
@@ -584,6 +592,7 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   // permanently set germline propensity of org (since DivideReset is called first, it is now in the "last" slot...)
   permanent_germline_propensity  = parent_phenotype.last_child_germline_propensity;
   
+  rebuildCountIndex();
   initialized = true;
 }
 
@@ -638,9 +647,9 @@ void cPhenotype::SetupInject(const InstructionSequence& _genome)
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -682,9 +691,9 @@ void cPhenotype::SetupInject(const InstructionSequence& _genome)
   last_collect_spec_counts.SetAll(0);
   last_reaction_count.SetAll(0);
   last_reaction_add_reward.SetAll(0);
-  last_inst_count.SetAll(0);
-  last_from_sensor_count.SetAll(0);
-  last_from_message_count.SetAll(0);
+  m_inst_count[1 - m_inst_cur].SetAll(0);
+  m_from_sensor_count[1 - m_inst_cur].SetAll(0);
+  m_from_message_count[1 - m_inst_cur].SetAll(0);
   for (int r = 0; r < last_group_attack_count.GetSize(); r++) {
     last_group_attack_count[r].SetAll(0);
     last_top_pred_group_attack_count[r].SetAll(0);
@@ -797,6 +806,7 @@ void cPhenotype::SetupInject(const InstructionSequence& _genome)
   
   permanent_germline_propensity = m_world->GetConfig().DEMES_DEFAULT_GERMLINE_PROPENSITY.Get();
   
+  rebuildCountIndex();
   initialized = true;
 }
 
@@ -873,9 +883,7 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
   last_collect_spec_counts  = cur_collect_spec_counts;
   last_reaction_count       = cur_reaction_count;
   last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
+  m_inst_cur                = 1 - m_inst_cur;  // cur instruction counts become last, the old last are zeroed below
   last_group_attack_count   = cur_group_attack_count;
   last_killed_targets       = cur_killed_targets;
   last_attacks              = cur_attacks;
@@ -928,9 +936,9 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -1051,6 +1059,8 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
 
   if (m_world->GetConfig().GENERATION_INC_METHOD.Get() == GENERATION_INC_BOTH) generation++;
   
+  rebuildCountIndex();
+  
   // Reset Task States
   for (Apto::Map<void*, cTaskState*>::ValueIterator it = m_task_states.Values(); it.Next();) delete *it.Get();
   m_task_states.Clear();
@@ -1106,9 +1116,7 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   last_collect_spec_counts  = cur_collect_spec_counts;
   last_reaction_count       = cur_reaction_count;
   last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
+  m_inst_cur                = 1 - m_inst_cur;  // cur instruction counts become last, the old last are zeroed below
   last_group_attack_count   = cur_group_attack_count;
   last_killed_targets       = cur_killed_targets;
   last_attacks              = cur_attacks;
@@ -1147,9 +1155,9 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -1253,6 +1261,8 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   (void) kaboom_executed;
   (void) kaboom_executed2;
   
+  rebuildCountIndex();
+  
   // Reset child info...
   (void) copy_true;
   (void) divide_sex;
@@ -1318,9 +1328,9 @@ void cPhenotype::SetupClone(const cPhenotype& clone_phenotype)
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -1361,9 +1371,9 @@ void cPhenotype::SetupClone(const cPhenotype& clone_phenotype)
   last_collect_spec_counts = clone_phenotype.last_collect_spec_counts;
   last_reaction_count      = clone_phenotype.last_reaction_count;
   last_reaction_add_reward = clone_phenotype.last_reaction_add_reward;
-  last_inst_count          = clone_phenotype.last_inst_count;
-  last_from_sensor_count   = clone_phenotype.last_from_sensor_count;
-  last_from_message_count   = clone_phenotype.last_from_message_count;
+  m_inst_count[1 - m_inst_cur] = clone_phenotype.m_inst_count[1 - clone_phenotype.m_inst_cur];
+  m_from_sensor_count[1 - m_inst_cur] = clone_phenotype.m_from_sensor_count[1 - clone_phenotype.m_inst_cur];
+  m_from_message_count[1 - m_inst_cur] = clone_phenotype.m_from_message_count[1 - clone_phenotype.m_inst_cur];
   last_group_attack_count   = clone_phenotype.last_group_attack_count;
   last_top_pred_group_attack_count   = clone_phenotype.last_top_pred_group_attack_count;
   last_killed_targets      = clone_phenotype.last_killed_targets;
@@ -1477,6 +1487,7 @@ void cPhenotype::SetupClone(const cPhenotype& clone_phenotype)
   child_copied_size  = 0;
   permanent_germline_propensity = clone_phenotype.permanent_germline_propensity;
   
+  rebuildCountIndex();
   initialized = true;
 }
 
@@ -1537,7 +1548,11 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
     }
 
     if (result.TaskDone(i) == true) {
+      if (cur_task_count[i] == 0 && cur_para_tasks[i] == 0 && cur_host_tasks[i] == 0 && cur_internal_task_count[i] == 0) {
+        m_cur_task_ids.Push(i);
+      }
       cur_task_count[i]++;
+      m_cur_task_set.Set(i, true);
       eff_task_count[i]++;
       
       // Update parasite/host task tracking appropriately
@@ -1573,12 +1588,8 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
   for (int i = 0; i < num_tasks; i++) {
     if (result.TaskDone(i) && !last_task_count[i]) {
       m_world->GetStats().AddNewTaskCount(i);
-      int prev_num_tasks = 0;
-      int cur_num_tasks = 0;
-      for (int j=0; j< num_tasks; j++) {
-        if (last_task_count[j]>0) prev_num_tasks++;
-        if (cur_task_count[j]>0) cur_num_tasks++;
-      }
+      const int prev_num_tasks = m_last_task_set.CountBits2();
+      const int cur_num_tasks = m_cur_task_set.CountBits2();
       m_world->GetStats().AddOtherTaskCounts(i, prev_num_tasks, cur_num_tasks);
     }
   }
@@ -1589,6 +1600,8 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
       m_world->GetStats().AddNewReactionCount(i);
     }
     if (result.ReactionTriggered(i) == true) {
+      // The environment has just counted this reaction; a count of one means it is new since the last reset
+      if (cur_reaction_count[i] == 1) m_cur_reaction_ids.Push(i);
       if (context_phenotype != 0) {
         context_phenotype->GetReactionCounts()[i]++;
       }
@@ -1726,6 +1739,254 @@ void cPhenotype::Sterilize()
 }
 
 
+void cPhenotype::SaveState(cCheckpointWriter& ckp) const
+{
+  assert(initialized == true);
+
+  ckp.WriteDouble(merit.GetDouble());
+  // Values calculated at the last divide
+  ckp.WriteDouble(executionRatio);
+  ckp.WriteDouble(energy_store);
+  ckp.WriteInt(genome_length);
+  ckp.WriteInt(bonus_instruction_count);
+  ckp.WriteInt(copied_size);
+  ckp.WriteInt(executed_size);
+  ckp.WriteInt(gestation_time);
+  ckp.WriteInt(gestation_start);
+  ckp.WriteDouble(fitness);
+  ckp.WriteDouble(div_type);
+
+  // In progress values
+  ckp.WriteDouble(cur_bonus);
+  ckp.WriteDouble(cur_energy_bonus);
+  ckp.WriteDouble(energy_tobe_applied);
+  ckp.WriteInt(cur_num_errors);
+  ckp.WriteInt(cur_num_donates);
+  ckp.WriteIntArray(cur_task_count);
+  ckp.WriteIntArray(cur_para_tasks);
+  ckp.WriteIntArray(cur_host_tasks);
+  ckp.WriteIntArray(cur_internal_task_count);
+  ckp.WriteIntArray(eff_task_count);
+  ckp.WriteDoubleArray(cur_task_quality);
+  ckp.WriteDoubleArray(cur_task_value);
+  ckp.WriteDoubleArray(cur_internal_task_quality);
+  ckp.WriteDoubleArray(cur_rbins_total);
+  ckp.WriteDoubleArray(cur_rbins_avail);
+  ckp.WriteIntArray(cur_collect_spec_counts);
+  ckp.WriteIntArray(cur_reaction_count);
+  ckp.WriteIntArray(first_reaction_cycles);
+  ckp.WriteIntArray(first_reaction_execs);
+  ckp.WriteIntArray(cur_stolen_reaction_count);
+  ckp.WriteDoubleArray(cur_reaction_add_reward);
+  ckp.WriteIntArray(m_inst_count[m_inst_cur]);
+  ckp.WriteIntArray(m_from_sensor_count[m_inst_cur]);
+  ckp.WriteIntArray(cur_killed_targets);
+  ckp.WriteInt(cur_attacks);
+  ckp.WriteInt(cur_kills);
+  ckp.WriteIntArray(cur_sense_count);
+  ckp.WriteDoubleArray(sensed_resources);
+  ckp.WriteDoubleArray(cur_task_time);
+  ckp.WriteIntArray(m_from_message_count[m_inst_cur]);
+  ckp.WriteInt(trial_time_used);
+  ckp.WriteInt(trial_cpu_cycles_used);
+  ckp.WriteDouble(cur_child_germline_propensity);
+
+  // Status of in progress values at the last divide
+  ckp.WriteDouble(last_merit_base);
+  ckp.WriteDouble(last_bonus);
+  ckp.WriteDouble(last_energy_bonus);
+  ckp.WriteInt(last_num_errors);
+  ckp.WriteInt(last_num_donates);
+  ckp.WriteIntArray(last_task_count);
+  ckp.WriteIntArray(last_para_tasks);
+  ckp.WriteIntArray(last_host_tasks);
+  ckp.WriteIntArray(last_internal_task_count);
+  ckp.WriteDoubleArray(last_task_quality);
+  ckp.WriteDoubleArray(last_task_value);
+  ckp.WriteDoubleArray(last_internal_task_quality);
+  ckp.WriteDoubleArray(last_rbins_total);
+  ckp.WriteDoubleArray(last_rbins_avail);
+  ckp.WriteIntArray(last_collect_spec_counts);
+  ckp.WriteIntArray(last_reaction_count);
+  ckp.WriteDoubleArray(last_reaction_add_reward);
+  ckp.WriteIntArray(m_inst_count[1 - m_inst_cur]);
+  ckp.WriteIntArray(m_from_sensor_count[1 - m_inst_cur]);
+  ckp.WriteIntArray(last_sense_count);
+  ckp.WriteIntArray(last_killed_targets);
+  ckp.WriteInt(last_attacks);
+  ckp.WriteInt(last_kills);
+  ckp.WriteIntArray(m_from_message_count[1 - m_inst_cur]);
+  ckp.WriteDouble(last_fitness);
+  ckp.WriteInt(last_cpu_cycles_used);
+
+  // Records from this organism's life
+  ckp.WriteInt(num_divides_failed);
+  ckp.WriteInt(num_divides);
+  ckp.WriteInt(generation);
+  ckp.WriteInt(cpu_cycles_used);
+  ckp.WriteInt(time_used);
+  ckp.WriteInt(num_execs);
+  ckp.WriteInt(age);
+  ckp.WriteDouble(neutral_metric);
+  ckp.WriteDouble(life_fitness);
+  ckp.WriteInt(exec_time_born);
+  ckp.WriteDouble(gmu_exec_time_born);
+  ckp.WriteInt(birth_update);
+  ckp.WriteInt(birth_cell_id);
+  ckp.WriteInt(av_birth_cell_id);
+  ckp.WriteInt(birth_group_id);
+  ckp.WriteInt(birth_forager_type);
+  ckp.WriteInt(last_task_id);
+  ckp.WriteInt(num_new_unique_reactions);
+  ckp.WriteDouble(res_consumed);
+  ckp.WriteBool(is_germ_cell);
+  ckp.WriteInt(last_task_time);
+
+  // Status flags and child information
+  ckp.WriteBool(to_die);
+  ckp.WriteBool(to_delete);
+  ckp.WriteBool(is_injected);
+  ckp.WriteBool(is_clone);
+  ckp.WriteBool(is_fertile);
+  ckp.WriteBool(is_mutated);
+  ckp.WriteBool(is_multi_thread);
+  ckp.WriteBool(parent_true);
+  ckp.WriteBool(parent_sex);
+  ckp.WriteInt(parent_cross_num);
+  ckp.WriteBool(copy_true);
+  ckp.WriteBool(divide_sex);
+  ckp.WriteInt(mate_select_id);
+  ckp.WriteInt(cross_num);
+  ckp.WriteBool(child_fertile);
+  ckp.WriteBool(last_child_fertile);
+  ckp.WriteInt(child_copied_size);
+}
+
+void cPhenotype::LoadState(cCheckpointReader& ckp)
+{
+  merit = cMerit(ckp.ReadDouble());
+  // Values calculated at the last divide
+  executionRatio = ckp.ReadDouble();
+  energy_store = ckp.ReadDouble();
+  genome_length = ckp.ReadInt();
+  bonus_instruction_count = ckp.ReadInt();
+  copied_size = ckp.ReadInt();
+  executed_size = ckp.ReadInt();
+  gestation_time = ckp.ReadInt();
+  gestation_start = ckp.ReadInt();
+  fitness = ckp.ReadDouble();
+  div_type = ckp.ReadDouble();
+
+  // In progress values
+  cur_bonus = ckp.ReadDouble();
+  cur_energy_bonus = ckp.ReadDouble();
+  energy_tobe_applied = ckp.ReadDouble();
+  cur_num_errors = ckp.ReadInt();
+  cur_num_donates = ckp.ReadInt();
+  ckp.ReadIntArray(cur_task_count);
+  ckp.ReadIntArray(cur_para_tasks);
+  ckp.ReadIntArray(cur_host_tasks);
+  ckp.ReadIntArray(cur_internal_task_count);
+  ckp.ReadIntArray(eff_task_count);
+  ckp.ReadDoubleArray(cur_task_quality);
+  ckp.ReadDoubleArray(cur_task_value);
+  ckp.ReadDoubleArray(cur_internal_task_quality);
+  ckp.ReadDoubleArray(cur_rbins_total);
+  ckp.ReadDoubleArray(cur_rbins_avail);
+  ckp.ReadIntArray(cur_collect_spec_counts);
+  ckp.ReadIntArray(cur_reaction_count);
+  ckp.ReadIntArray(first_reaction_cycles);
+  ckp.ReadIntArray(first_reaction_execs);
+  ckp.ReadIntArray(cur_stolen_reaction_count);
+  ckp.ReadDoubleArray(cur_reaction_add_reward);
+  ckp.ReadIntArray(m_inst_count[m_inst_cur]);
+  ckp.ReadIntArray(m_from_sensor_count[m_inst_cur]);
+  ckp.ReadIntArray(cur_killed_targets);
+  cur_attacks = ckp.ReadInt();
+  cur_kills = ckp.ReadInt();
+  ckp.ReadIntArray(cur_sense_count);
+  ckp.ReadDoubleArray(sensed_resources);
+  ckp.ReadDoubleArray(cur_task_time);
+  ckp.ReadIntArray(m_from_message_count[m_inst_cur]);
+  trial_time_used = ckp.ReadInt();
+  trial_cpu_cycles_used = ckp.ReadInt();
+  cur_child_germline_propensity = ckp.ReadDouble();
+
+  // Status of in progress values at the last divide
+  last_merit_base = ckp.ReadDouble();
+  last_bonus = ckp.ReadDouble();
+  last_energy_bonus = ckp.ReadDouble();
+  last_num_errors = ckp.ReadInt();
+  last_num_donates = ckp.ReadInt();
+  ckp.ReadIntArray(last_task_count);
+  ckp.ReadIntArray(last_para_tasks);
+  ckp.ReadIntArray(last_host_tasks);
+  ckp.ReadIntArray(last_internal_task_count);
+  ckp.ReadDoubleArray(last_task_quality);
+  ckp.ReadDoubleArray(last_task_value);
+  ckp.ReadDoubleArray(last_internal_task_quality);
+  ckp.ReadDoubleArray(last_rbins_total);
+  ckp.ReadDoubleArray(last_rbins_avail);
+  ckp.ReadIntArray(last_collect_spec_counts);
+  ckp.ReadIntArray(last_reaction_count);
+  ckp.ReadDoubleArray(last_reaction_add_reward);
+  ckp.ReadIntArray(m_inst_count[1 - m_inst_cur]);
+  ckp.ReadIntArray(m_from_sensor_count[1 - m_inst_cur]);
+  ckp.ReadIntArray(last_sense_count);
+  ckp.ReadIntArray(last_killed_targets);
+  last_attacks = ckp.ReadInt();
+  last_kills = ckp.ReadInt();
+  ckp.ReadIntArray(m_from_message_count[1 - m_inst_cur]);
+  last_fitness = ckp.ReadDouble();
+  last_cpu_cycles_used = ckp.ReadInt();
+
+  // Records from this organism's life
+  num_divides_failed = ckp.ReadInt();
+  num_divides = ckp.ReadInt();
+  generation = ckp.ReadInt();
+  cpu_cycles_used = ckp.ReadInt();
+  time_used = ckp.ReadInt();
+  num_execs = ckp.ReadInt();
+  age = ckp.ReadInt();
+  neutral_metric = ckp.ReadDouble();
+  life_fitness = ckp.ReadDouble();
+  exec_time_born = ckp.ReadInt();
+  gmu_exec_time_born = ckp.ReadDouble();
+  birth_update = ckp.ReadInt();
+  birth_cell_id = ckp.ReadInt();
+  av_birth_cell_id = ckp.ReadInt();
+  birth_group_id = ckp.ReadInt();
+  birth_forager_type = ckp.ReadInt();
+  last_task_id = ckp.ReadInt();
+  num_new_unique_reactions = ckp.ReadInt();
+  res_consumed = ckp.ReadDouble();
+  is_germ_cell = ckp.ReadBool();
+  last_task_time = ckp.ReadInt();
+
+  // Status flags and child information
+  to_die = ckp.ReadBool();
+  to_delete = ckp.ReadBool();
+  is_injected = ckp.ReadBool();
+  is_clone = ckp.ReadBool();
+  is_fertile = ckp.ReadBool();
+  is_mutated = ckp.ReadBool();
+  is_multi_thread = ckp.ReadBool();
+  parent_true = ckp.ReadBool();
+  parent_sex = ckp.ReadBool();
+  parent_cross_num = ckp.ReadInt();
+  copy_true = ckp.ReadBool();
+  divide_sex = ckp.ReadBool();
+  mate_select_id = ckp.ReadInt();
+  cross_num = ckp.ReadInt();
+  child_fertile = ckp.ReadBool();
+  last_child_fertile = ckp.ReadBool();
+  child_copied_size = ckp.ReadInt();
+
+  rebuildCountIndex();
+  initialized = true;
+}
+
+
 void cPhenotype::PrintStatus(ostream& fp) const
 {
   fp << "  MeritBase:"
@@ -2157,9 +2418,7 @@ void cPhenotype::NewTrial()
   last_collect_spec_counts  = cur_collect_spec_counts;
   last_reaction_count       = cur_reaction_count;
   last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
+  m_inst_cur                = 1 - m_inst_cur;  // cur instruction counts become last, the old last are zeroed below
   last_group_attack_count   = cur_group_attack_count;
   last_killed_targets       = cur_killed_targets;
   last_attacks              = cur_attacks;
@@ -2189,9 +2448,9 @@ void cPhenotype::NewTrial()
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
   cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
+  m_inst_count[m_inst_cur].SetAll(0);
+  m_from_sensor_count[m_inst_cur].SetAll(0);
+  m_from_message_count[m_inst_cur].SetAll(0);
   for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
     cur_group_attack_count[r].SetAll(0);
     cur_top_pred_group_attack_count[r].SetAll(0);
@@ -2276,6 +2535,9 @@ void cPhenotype::NewTrial()
   is_energy_requestor = false;
   is_energy_donor = false;
   is_energy_receiver = false;
+  
+  rebuildCountIndex();
+  
   (void) is_modifier;
   (void) is_modified;
   (void) is_fertile;
@@ -2356,9 +2618,10 @@ int cPhenotype::Compare(const cPhenotype* lhs, const cPhenotype* rhs) {
   if ( lhs->GetGestationTime() < rhs->GetGestationTime() ) return -1;
   else if ( lhs->GetGestationTime() > rhs->GetGestationTime() ) return 1;
   
-  // If gestation times are also equal, compare each task
-  Apto::Array<int> lhsTasks = lhs->GetLastTaskCount();
-  Apto::Array<int> rhsTasks = rhs->GetLastTaskCount();
+  // If gestation times are also equal, compare each task (unless both still share the same counts)
+  const Apto::Array<int>& lhsTasks = lhs->GetLastTaskCount();
+  const Apto::Array<int>& rhsTasks = rhs->GetLastTaskCount();
+  if (&lhsTasks == &rhsTasks) return 0;
   for (int k = 0; k < lhsTasks.GetSize(); k++) {
     if (lhsTasks[k] < rhsTasks[k]) return -1;
     else if (lhsTasks[k] > rhsTasks[k]) return 1;
@@ -2419,6 +2682,64 @@ double cPhenotype::GetResourcesConsumed()
 	return r; 
 }
 
+void cPhenotype::SetReactionCount(int index, int val)
+{
+  if (cur_reaction_count[index] == 0 && val != 0) m_cur_reaction_ids.Push(index);
+  else if (cur_reaction_count[index] != 0 && val == 0) {
+    for (int i = 0; i < m_cur_reaction_ids.GetSize(); i++) {
+      if (m_cur_reaction_ids[i] != index) continue;
+      m_cur_reaction_ids[i] = m_cur_reaction_ids[m_cur_reaction_ids.GetSize() - 1];
+      m_cur_reaction_ids.Resize(m_cur_reaction_ids.GetSize() - 1);
+      break;
+    }
+  }
+  cur_reaction_count[index] = val;
+}
+
+void cPhenotype::SetLastTaskCount(const Apto::Array<int>& tasks)
+{
+  assert(initialized == true);
+  last_task_count = tasks;
+  rebuildCountIndex();
+}
+
+void cPhenotype::UpdateParasiteTasks()
+{
+  last_para_tasks = cur_para_tasks;
+  cur_para_tasks.SetAll(0);
+  rebuildCountIndex();
+}
+
+// Collect the indices of the nonzero task and reaction counts, and the performed task sets, from scratch.  Run after
+// any bulk change to the count arrays; TestOutput and SetReactionCount keep them current between those.
+void cPhenotype::rebuildCountIndex()
+{
+  const int num_tasks = cur_task_count.GetSize();
+  m_cur_task_ids.Resize(0);
+  m_last_task_ids.Resize(0);
+  if (m_cur_task_set.GetSize() != num_tasks) m_cur_task_set.ResizeClear(num_tasks);
+  else m_cur_task_set.Clear();
+  if (m_last_task_set.GetSize() != num_tasks) m_last_task_set.ResizeClear(num_tasks);
+  else m_last_task_set.Clear();
+  for (int i = 0; i < num_tasks; i++) {
+    if (cur_task_count[i] || cur_para_tasks[i] || cur_host_tasks[i] || cur_internal_task_count[i]) {
+      m_cur_task_ids.Push(i);
+    }
+    if (last_task_count[i] || last_para_tasks[i] || last_host_tasks[i] || last_internal_task_count[i]) {
+      m_last_task_ids.Push(i);
+    }
+    if (cur_task_count[i] > 0) m_cur_task_set.Set(i, true);
+    if (last_task_count[i] > 0) m_last_task_set.Set(i, true);
+  }
+  
+  m_cur_reaction_ids.Resize(0);
+  m_last_reaction_ids.Resize(0);
+  for (int i = 0; i < cur_reaction_count.GetSize(); i++) {
+    if (cur_reaction_count[i]) m_cur_reaction_ids.Push(i);
+    if (last_reaction_count[i]) m_last_reaction_ids.Push(i);
+  }
+}
+
 //Deep copy parasite task count
 void cPhenotype::SetLastParasiteTaskCount(Apto::Array<int> oldParaPhenotype)
 {
@@ -2428,6 +2749,7 @@ void cPhenotype::SetLastParasiteTaskCount(Apto::Array<int> oldParaPhenotype)
   {
     last_para_tasks[i] = oldParaPhenotype[i];
   }
+  rebuildCountIndex();
 }
 
 /* Return the cumulative reaction count if we aren't resetting on divide. */
@@ -27,6 +27,7 @@
 
 #include <fstream>
 
+#include "cBitArray.h"
 #include "cMerit.h"
 #include "cString.h"
 #include "cCodeLabel.h"
@@ -60,6 +61,8 @@
  *************************************************************************/
 
 class cAvidaContext;
+class cCheckpointReader;
+class cCheckpointWriter;
 class cContextPhenotype;
 class cEnvironment;
 template <class T> class tBuffer;
@@ -125,8 +128,9 @@ private:
   Apto::Array<int> first_reaction_execs;            // Execution count at first time reaction was triggered (will be > cycles in parallel exec multithreaded orgs).
   Apto::Array<int> cur_stolen_reaction_count;      // Total counts of reactions stolen by predators.
   Apto::Array<double> cur_reaction_add_reward;     // Bonus change from triggering each reaction.
-  Apto::Array<int> cur_inst_count;                 // Instruction exection counter
-  Apto::Array<int> cur_from_sensor_count;           // Use of inputs that originated from sensory data were used in execution of this instruction.
+  Apto::Array<int> m_inst_count[2];                // Instruction exection counters, current and last (see m_inst_cur)
+  Apto::Array<int> m_from_sensor_count[2];         // Use of inputs that originated from sensory data were used in execution of this instruction.
+  int m_inst_cur;                                  // Index of the current instruction counters, divides flip it to make them last
   Apto::Array< Apto::Array<int> > cur_group_attack_count;
   Apto::Array< Apto::Array<int> > cur_top_pred_group_attack_count;
   Apto::Array<int> cur_killed_targets;
@@ -140,7 +144,7 @@ private:
   Apto::Array<double> cur_trial_fitnesses;         // Fitnesses of various trials.; @JEB
   Apto::Array<double> cur_trial_bonuses;           // Bonuses of various trials.; @JEB
   Apto::Array<int> cur_trial_times_used;           // Time used in of various trials.; @JEB
-  Apto::Array<int> cur_from_message_count;           // Use of inputs that originated from messages were used in execution of this instruction.
+  Apto::Array<int> m_from_message_count[2];        // Use of inputs that originated from messages were used in execution of this instruction.
 
   int trial_time_used;                        // like time_used, but reset every trial; @JEB
   int trial_cpu_cycles_used;                  // like cpu_cycles_used, but reset every trial; @JEB
@@ -179,8 +183,6 @@ private:
   Apto::Array<int> last_collect_spec_counts;
   Apto::Array<int> last_reaction_count;
   Apto::Array<double> last_reaction_add_reward;
-  Apto::Array<int> last_inst_count;	  // Instruction exection counter
-  Apto::Array<int> last_from_sensor_count;
   Apto::Array<int> last_sense_count;   // Total times resource combinations have been sensed; @JEB
   Apto::Array< Apto::Array<int> > last_group_attack_count;
   Apto::Array< Apto::Array<int> > last_top_pred_group_attack_count;
@@ -188,8 +190,6 @@ private:
   int last_attacks;
   int last_kills;
 
-  Apto::Array<int> last_from_message_count;
-
   double last_fitness;            // Used to determine sterilization.
   int last_cpu_cycles_used;
   double cur_child_germline_propensity;   // chance of child being a germline cell; @JEB
@@ -297,6 +297,16 @@ private:
   bool born_parent_group;// Was offspring born into the parent's group?
   bool kaboom_executed; // Has organism executed an explode instruction?
   bool kaboom_executed2; // Has organism executed an explode instruction? Testing two instructions
+  
+  // Indices of the tasks (in any of the task count arrays) and reactions with nonzero counts
+  Apto::Array<int> m_cur_task_ids;
+  Apto::Array<int> m_last_task_ids;
+  Apto::Array<int> m_cur_reaction_ids;
+  Apto::Array<int> m_last_reaction_ids;
+  
+  // Tasks performed (positive cur_task_count / last_task_count), one bit per task
+  cBitArray m_cur_task_set;
+  cBitArray m_last_task_set;
 
   // 6. Child information...
   bool copy_true;        // Can this genome produce an exact copy of itself?
@@ -312,10 +322,11 @@ private:
   
 
   inline void SetInstSetSize(int inst_set_size);
+  void rebuildCountIndex();
   inline void SetGroupAttackInstSetSize(int num_group_attack_inst);
   
 public:
-  cPhenotype() : m_world(NULL), m_reaction_result(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
+  cPhenotype() : m_world(NULL), m_inst_cur(0), m_reaction_result(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
   cPhenotype(cWorld* world, int parent_generation, int num_nops);
 
 
@@ -350,6 +361,8 @@ public:
                   Apto::Array<cString>& insts_triggered, bool is_parasite=false, cContextPhenotype* context_phenotype = 0);
 
   // State saving and loading, and printing...
+  void SaveState(cCheckpointWriter& ckp) const;
+  void LoadState(cCheckpointReader& ckp);
   void PrintStatus(std::ostream& fp) const;
 
   // Some useful methods...
@@ -366,9 +379,7 @@ public:
   }
   int CalcID() const {
     int phen_id = 0;
-    for (int i = 0; i < last_task_count.GetSize(); i++) {
-      if (last_task_count[i] > 0) phen_id += (1 << i);
-    }
+    for (int i = m_last_task_set.FindBit1(); i >= 0; i = m_last_task_set.FindBit1(i + 1)) phen_id += (1 << i);
     return phen_id;
   }
 
@@ -436,6 +447,9 @@ public:
   double GetCurRBinAvail(int index) const { assert(initialized == true); return cur_rbins_avail[index]; }
 
   const Apto::Array<int>& GetCurReactionCount() const { assert(initialized == true); return cur_reaction_count;}
+  const Apto::Array<int>& GetCurTaskIDs() const { assert(initialized == true); return m_cur_task_ids; }
+  const cBitArray& GetCurTaskSet() const { assert(initialized == true); return m_cur_task_set; }
+  const Apto::Array<int>& GetCurReactionIDs() const { assert(initialized == true); return m_cur_reaction_ids; }
   const Apto::Array<int>& GetFirstReactionCycles() const { assert(initialized == true); return first_reaction_cycles;}
   void SetFirstReactionCycle(int idx) { if (first_reaction_cycles[idx] < 0) first_reaction_cycles[idx] = time_used; }
   const Apto::Array<int>& GetFirstReactionExecs() const { assert(initialized == true); return first_reaction_execs;}
@@ -443,7 +457,7 @@ public:
 
   const Apto::Array<int>& GetStolenReactionCount() const { assert(initialized == true); return cur_stolen_reaction_count;}
   const Apto::Array<double>& GetCurReactionAddReward() const { assert(initialized == true); return cur_reaction_add_reward;}
-  const Apto::Array<int>& GetCurInstCount() const { assert(initialized == true); return cur_inst_count; }
+  const Apto::Array<int>& GetCurInstCount() const { assert(initialized == true); return m_inst_count[m_inst_cur]; }
   const Apto::Array<int>& GetCurSenseCount() const { assert(initialized == true); return cur_sense_count; }
 
   double GetSensedResource(int _in) { assert(initialized == true); return sensed_resources[_in]; }
@@ -474,7 +488,7 @@ public:
 
   int GetLastCountForTask(int idx) const { assert(initialized == true); return last_task_count[idx]; }
   const Apto::Array<int>& GetLastTaskCount() const { assert(initialized == true); return last_task_count; }
-  void SetLastTaskCount(Apto::Array<int> tasks) { assert(initialized == true); last_task_count = tasks; }
+  void SetLastTaskCount(const Apto::Array<int>& tasks);
   const Apto::Array<int>& GetLastHostTaskCount() const { assert(initialized == true); return last_host_tasks; }
   const Apto::Array<int>& GetLastParasiteTaskCount() const { assert(initialized == true); return last_para_tasks; }
   void  SetLastParasiteTaskCount(Apto::Array<int>  oldParaPhenotype);
@@ -485,14 +499,17 @@ public:
   const Apto::Array<double>& GetLastRBinsTotal() const { assert(initialized == true); return last_rbins_total; }
   const Apto::Array<double>& GetLastRBinsAvail() const { assert(initialized == true); return last_rbins_avail; }
   const Apto::Array<int>& GetLastReactionCount() const { assert(initialized == true); return last_reaction_count; }
+  const Apto::Array<int>& GetLastTaskIDs() const { assert(initialized == true); return m_last_task_ids; }
+  const cBitArray& GetLastTaskSet() const { assert(initialized == true); return m_last_task_set; }
+  const Apto::Array<int>& GetLastReactionIDs() const { assert(initialized == true); return m_last_reaction_ids; }
   const Apto::Array<double>& GetLastReactionAddReward() const { assert(initialized == true); return last_reaction_add_reward; }
-  const Apto::Array<int>& GetLastInstCount() const { assert(initialized == true); return last_inst_count; }
-  const Apto::Array<int>& GetLastFromSensorInstCount() const { assert(initialized == true); return last_from_sensor_count; }
+  const Apto::Array<int>& GetLastInstCount() const { assert(initialized == true); return m_inst_count[1 - m_inst_cur]; }
+  const Apto::Array<int>& GetLastFromSensorInstCount() const { assert(initialized == true); return m_from_sensor_count[1 - m_inst_cur]; }
   const Apto::Array<int>& GetLastSenseCount() const { assert(initialized == true); return last_sense_count; }
   const Apto::Array< Apto::Array<int> >& GetLastGroupAttackInstCount() const { assert(initialized == true); return last_group_attack_count; }
   const Apto::Array< Apto::Array<int> >& GetLastTopPredGroupAttackInstCount() const { assert(initialized == true); return last_top_pred_group_attack_count; }
 
-  const Apto::Array<int>& GetLastFromMessageInstCount() const { assert(initialized == true); return last_from_message_count; }
+  const Apto::Array<int>& GetLastFromMessageInstCount() const { assert(initialized == true); return m_from_message_count[1 - m_inst_cur]; }
 
   double GetLastFitness() const { assert(initialized == true); return last_fitness; }
   double GetPermanentGermlinePropensity() const { assert(initialized == true); return permanent_germline_propensity; }
@@ -621,7 +638,7 @@ public:
   int GetNumEnergyReceptions() { return num_energy_receptions; }
   int GetNumEnergyApplications() { return num_energy_applications; }
   
-  void SetReactionCount(int index, int val) { cur_reaction_count[index] = val; }
+  void SetReactionCount(int index, int val);
   void SetStolenReactionCount(int index, int val) { cur_stolen_reaction_count[index] = val; }
   
   bool GetKaboomExecuted() {return kaboom_executed;} //@AEJ
@@ -676,9 +693,9 @@ public:
   void SetCurBonus(double _bonus) { cur_bonus = _bonus; }
   void SetCurBonusInstCount(int _num_bonus_inst) {bonus_instruction_count = _num_bonus_inst;}
 
-  void IncCurInstCount(int _inst_num)  { assert(initialized == true); cur_inst_count[_inst_num]++; } 
-  void DecCurInstCount(int _inst_num)  { assert(initialized == true); cur_inst_count[_inst_num]--; }
-  void IncCurFromSensorInstCount(int _inst_num)  { assert(initialized == true); cur_from_sensor_count[_inst_num]++; }
+  void IncCurInstCount(int _inst_num)  { assert(initialized == true); m_inst_count[m_inst_cur][_inst_num]++; } 
+  void DecCurInstCount(int _inst_num)  { assert(initialized == true); m_inst_count[m_inst_cur][_inst_num]--; }
+  void IncCurFromSensorInstCount(int _inst_num)  { assert(initialized == true); m_from_sensor_count[m_inst_cur][_inst_num]++; }
   void IncCurGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur_group_attack_count[_inst_num][pack_size_idx]++; }
   void IncCurTopPredGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur_top_pred_group_attack_count[_inst_num][pack_size_idx]++; }
   void IncAttackedPreyFTData(int target_ft);
@@ -732,12 +749,12 @@ public:
   void  ResetNumNewUniqueReactions()  {num_new_unique_reactions =0; }
   double GetResourcesConsumed(); 
   Apto::Array<int> GetCumulativeReactionCount();
-  void IncCurFromMessageInstCount(int _inst_num)  { assert(initialized == true); cur_from_message_count[_inst_num]++; }
+  void IncCurFromMessageInstCount(int _inst_num)  { assert(initialized == true); m_from_message_count[m_inst_cur][_inst_num]++; }
  
 
   // @LZ - Parasite Etc. Helpers
   void DivideFailed();
-  void UpdateParasiteTasks() { last_para_tasks = cur_para_tasks; cur_para_tasks.SetAll(0); return; }
+  void UpdateParasiteTasks();
   
 
   void RefreshEnergy();
@@ -759,12 +776,11 @@ public:
 
 inline void cPhenotype::SetInstSetSize(int inst_set_size)
 {
-  cur_inst_count.Resize(inst_set_size, 0);
-  cur_from_sensor_count.Resize(inst_set_size, 0);
-  cur_from_message_count.Resize(inst_set_size, 0);
-  last_inst_count.Resize(inst_set_size, 0);
-  last_from_sensor_count.Resize(inst_set_size, 0);
-  last_from_message_count.Resize(inst_set_size, 0);
+  for (int i = 0; i < 2; i++) {
+    m_inst_count[i].Resize(inst_set_size, 0);
+    m_from_sensor_count[i].Resize(inst_set_size, 0);
+    m_from_message_count[i].Resize(inst_set_size, 0);
+  }
 }
 
 inline void cPhenotype::SetGroupAttackInstSetSize(int num_group_attack_inst)
@@ -29,6 +29,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -44,21 +45,28 @@
 
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
+#include "cCheckpoint.h"
 #include "cCodeLabel.h"
 #include "cDemePlaceholderUnit.h"
 #include "cEnvironment.h"
+#include "cEventList.h"
+#include "cFitnessSelector.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
+#include "cMappedTextFile.h"
 #include "cMigrationMatrix.h"   
+#include "cMiniTrace.h"
 #include "cOrganism.h"
 #include "cParasite.h"
 #include "cPhenotype.h"
+#include "cProfiler.h"
 #include "cPopulationCell.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cStats.h"
+#include "cStringIterator.h"
 #include "cTestCPU.h"
 #include "cTopology.h"
 #include "cWorld.h"
@@ -73,12 +81,20 @@
 #include <cfloat>
 #include <cmath>
 #include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
 using namespace std;
 using namespace AvidaTools;
 
-static const PropertyID s_prop_id_instset("instset");
+static const PropertyKey s_prop_id_instset("instset");
+static const PropertyKey s_prop_id_threshold("threshold");
+static const PropertyKey s_prop_id_last_forager_type("last_forager_type");
+static const PropertyKey s_prop_id_last_group_id("last_group_id");
+static const PropertyKey s_prop_id_generation("generation");
+static const PropertyKey s_prop_id_genome("genome");
+static const PropertyKey s_prop_id_update_born("update_born");
 
 
 cPopulationOrgStatProvider::~cPopulationOrgStatProvider() { ; }
@@ -276,6 +292,7 @@ cPopulation::cPopulation(cWorld* world)
 , num_pred_organisms(0)
 , num_top_pred_organisms(0)
 , sync_events(false)
+, m_checkpoint_thread(NULL)
 , m_hgt_resid(-1)
 {
   world_x = world->GetConfig().WORLD_X.Get();
@@ -334,6 +351,7 @@ void cPopulation::SetupCellGrid()
   
   // Allocate the cells, resources, and market.
   cell_array.ResizeClear(num_cells);
+  m_org_index.Resize(world_x, world_y);
   empty_cell_id_array.ResizeClear(cell_array.GetSize());
   for (int i = 0; i < empty_cell_id_array.GetSize(); i++) {
     empty_cell_id_array[i] = i;
@@ -343,6 +361,7 @@ void cPopulation::SetupCellGrid()
   bool fill_reaper_queue = (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST);
   for (int i = 0; i < num_cells; i++) {
     cell_array[i].Setup(m_world, i, environment.GetMutRates(), i % world_x, i / world_x);    
+    cell_array[i].m_org_index = &m_org_index;
     if (fill_reaper_queue) reaper_queue.Push(&(cell_array[i]));
   }
   
@@ -602,6 +621,10 @@ bool cPopulation::IsValidArgument(const Data::DataID& data_id, Data::Argument ar
 
 cPopulation::~cPopulation()
 {
+  if (m_checkpoint_thread) {
+    m_checkpoint_thread->Join();
+    delete m_checkpoint_thread;
+  }
   for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
   delete m_scheduler;
 }
@@ -1259,7 +1282,7 @@ bool cPopulation::ActivateParasite(cOrganism* host, Systematics::UnitPtr parent,
   
   Genome mg(parent->UnitGenome().HardwareType(), parent->UnitGenome().Properties(), tmpParasiteGenome);
 
-  Apto::SmartPtr<cParasite, Apto::InternalRCObject> parasite(new cParasite(m_world, mg, Apto::StrAs(parent->Properties().Get("generation")), Systematics::Source(Systematics::HORIZONTAL, (const char*)label)));
+  Apto::SmartPtr<cParasite, Apto::InternalRCObject> parasite(new cParasite(m_world, mg, Apto::StrAs(parent->Properties().Get(s_prop_id_generation)), Systematics::Source(Systematics::HORIZONTAL, (const char*)label)));
   //Handle potential virulence evolution if this parasite is comming from a parasite 
   //and virulence is inhereted from the parent (source == 1)
   if (parent->UnitSource().transmission_type == Systematics::HORIZONTAL && m_world->GetConfig().VIRULENCE_SOURCE.Get() == 1)
@@ -1319,6 +1342,9 @@ bool cPopulation::ActivateOrganism(cAvidaContext& ctx, cOrganism* in_organism, c
   target_cell.InsertOrganism(in_organism, ctx); 
   AddLiveOrg(in_organism); 
   
+  // Only organisms in the population are profiled; test CPUs may run concurrently on analyze threads
+  in_organism->GetHardware().SetInstProfile(m_world->GetProfiler().GetInstProfile(in_organism->GetHardware().GetInstSet()));
+  
   // Setup the inputs in the target cell.
   environment.SetupInputs(ctx, target_cell.m_inputs);
   
@@ -1504,9 +1530,11 @@ void cPopulation::SetupMiniTrace(cOrganism* in_organism)
   if (in_organism->HasOpinion()) group_id = in_organism->GetOpinion().first;
   else group_id = in_organism->GetParentGroup();
   
-  cString filename = cStringUtil::Stringf("minitraces/org%d-ud%d-grp%d_ft%d-gt%d.trc", id, m_world->GetStats().GetUpdate(), group_id, target, in_organism->SystematicsGroup("genotype")->ID());
+  const bool binary = m_world->GetConfig().BINARY_MINI_TRACES.Get();
+  cString filename = cStringUtil::Stringf("minitraces/org%d-ud%d-grp%d_ft%d-gt%d", id, m_world->GetStats().GetUpdate(), group_id, target, in_organism->SystematicsGroup("genotype")->ID());
+  filename += binary ? cMiniTrace::BINARY_EXTENSION : ".trc";
   
-  if (!use_micro_traces) in_organism->GetHardware().SetMiniTrace(filename);
+  if (!use_micro_traces) in_organism->GetHardware().SetMiniTrace(filename, binary);
   else in_organism->GetHardware().SetMicroTrace();
   
   if (print_mini_trace_genomes) {
@@ -1522,7 +1550,7 @@ void cPopulation::PrintMiniTraceGenome(cOrganism* in_organism, cString& filename
   cAvidaContext ctx2(&m_world->GetDriver(), rng);
   
   cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx2);
-  testcpu->PrintGenome(ctx2, Genome(in_organism->SystematicsGroup("genotype")->Properties().Get("genome")), filename, m_world->GetStats().GetUpdate());
+  testcpu->PrintGenome(ctx2, Genome(in_organism->SystematicsGroup("genotype")->Properties().Get(s_prop_id_genome)), filename, m_world->GetStats().GetUpdate());
   delete testcpu;
 }
 
@@ -1763,10 +1791,10 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
     if (bg_id_list.GetSize() < max_bgs && (!doms_done || !fts_done || !grps_done)) {
       if (i == 0 && save_dominants && num_doms > 0) {
         for (int j = 0; j < num_doms; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)) || bg_id_list.GetSize() == 0)) {
             bg_id_list.Push(bg->ID());
             if (save_foragers) {
-              int ft = Apto::StrAs(bg->Properties().Get("last_forager_type")); 
+              int ft = Apto::StrAs(bg->Properties().Get(s_prop_id_last_forager_type)); 
               if (fts_left > 0) {
                 for (int k = 0; k < fts_to_use.GetSize(); k++) {
                   if (ft == fts_to_use[k]) {
@@ -1785,7 +1813,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
               }
             }
             if (save_groups) {
-              int grp = bg->Properties().Get("last_group_id"); 
+              int grp = bg->Properties().Get(s_prop_id_last_group_id); 
               if (groups_left > 0) {
                 for (int k = 0; k < groups_to_use.GetSize(); k++) {
                   if (grp == groups_to_use[k]) {
@@ -1809,7 +1837,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             }
             else bg = it->Next();
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {      // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)))) {      // no more above threshold
             doms_done = true; 
             break; 
           }
@@ -1819,8 +1847,8 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
       
       else if (i == 1 && save_foragers && fts_left > 0) {
         for (int j = 0; j < fts_left; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
-            int ft = bg->Properties().Get("last_forager_type"); 
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)) || bg_id_list.GetSize() == 0)) {
+            int ft = bg->Properties().Get(s_prop_id_last_forager_type); 
             bool found_one = false;
             for (int k = 0; k < fts_to_use.GetSize(); k++) {
               if (ft == fts_to_use[k]) {
@@ -1838,7 +1866,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
               }
             }
             if (save_groups) {
-              int grp = bg->Properties().Get("last_group_id"); 
+              int grp = bg->Properties().Get(s_prop_id_last_group_id); 
               if (groups_left > 0) {
                 for (int k = 0; k < groups_to_use.GetSize(); k++) {
                   if (grp == groups_to_use[k]) {
@@ -1863,7 +1891,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             else bg = it->Next();
             if (!found_one) j--;
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {  // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)))) {  // no more above threshold
             fts_done = true; 
             break; 
           }
@@ -1873,8 +1901,8 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
       
       else if (i == 2 && save_groups && groups_left > 0) {
         for (int j = 0; j < groups_left; j++) {
-          if (bg && ((bool)Apto::StrAs(bg->Properties().Get("threshold")) || bg_id_list.GetSize() == 0)) {
-            int grp = bg->Properties().Get("last_group_id"); 
+          if (bg && ((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)) || bg_id_list.GetSize() == 0)) {
+            int grp = bg->Properties().Get(s_prop_id_last_group_id); 
             bool found_one = false;
             for (int k = 0; k < groups_to_use.GetSize(); k++) {
               if (grp == groups_to_use[k]) {
@@ -1898,7 +1926,7 @@ Apto::Array<int, Apto::Smart> cPopulation::SetTraceQ(int save_dominants, int sav
             else bg = it->Next();
             if (!found_one) j--;
           }
-          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get("threshold")))) {  // no more above threshold
+          else if (bg && !((bool)Apto::StrAs(bg->Properties().Get(s_prop_id_threshold)))) {  // no more above threshold
             grps_done = true; 
             break; 
           }
@@ -2147,64 +2175,60 @@ void cPopulation::AttackFacedOrg(cAvidaContext& ctx, int loser)
   KillOrganism(loser_cell, ctx); 
 }
 
-void cPopulation::KillRandPred(cAvidaContext& ctx, cOrganism* org)
+// exclude prey
+static bool isRandPredTarget(cOrganism* org)
+{
+  return org->GetParentFT() <= -2 || !org->IsPreyFT();
+}
+
+// exclude predators and juvenilles with predatory parents (include juvs with non-predatory parents)
+static bool isRandPreyTarget(cOrganism* org)
 {
-  cOrganism* org_to_kill = org;
-  const Apto::Array<cOrganism*, Apto::Smart>& live_org_list = GetLiveOrgList();
-  Apto::Array<cOrganism*> TriedIdx(live_org_list.GetSize());
-  int list_size = TriedIdx.GetSize();
-  for (int i = 0; i < list_size; i ++) { TriedIdx[i] = live_org_list[i]; }
+  return org->GetForageTarget() > -1 || (org->GetForageTarget() == -1 && org->GetParentFT() > -2);
+}
+
+// Randomly draws a live organism other than org that is_target accepts, returning org if none was found.
+// Draws from the live list without replacement of rejected organisms.  Rather than copying the whole list to strike
+// rejects from, the swaps are recorded in a map, so the cost follows the number of draws rather than the population
+// size.  The sequence of random numbers drawn is unchanged.
+cOrganism* cPopulation::DrawRandLiveOrg(cAvidaContext& ctx, cOrganism* org, bool (*is_target)(cOrganism*))
+{
+  cOrganism* target_org = org;
+  Apto::Map<int, cOrganism*> swapped;
+  int list_size = live_org_list.GetSize();
   
   int idx = ctx.GetRandom().GetUInt(list_size);
-  while (org_to_kill == org) {
-    cOrganism* org_at = TriedIdx[idx];
-    // exclude prey
-    if (org_at->GetParentFT() <= -2 || !org_at->IsPreyFT()) org_to_kill = org_at;
-    else TriedIdx.Swap(idx, --list_size);
+  while (target_org == org) {
+    cOrganism* org_at = live_org_list[idx];
+    swapped.Get(idx, org_at);
+    if (is_target(org_at)) target_org = org_at;
+    else {
+      cOrganism* org_last = live_org_list[--list_size];
+      swapped.Get(list_size, org_last);
+      swapped.Set(idx, org_last);
+      swapped.Set(list_size, org_at);
+    }
     if (list_size == 1) break;
     idx = ctx.GetRandom().GetUInt(list_size);
   }
+  return target_org;
+}
+
+void cPopulation::KillRandPred(cAvidaContext& ctx, cOrganism* org)
+{
+  cOrganism* org_to_kill = DrawRandLiveOrg(ctx, org, isRandPredTarget);
   if (org_to_kill != org) m_world->GetPopulation().KillOrganism(m_world->GetPopulation().GetCell(org_to_kill->GetCellID()), ctx);
 }
 
 void cPopulation::KillRandPrey(cAvidaContext& ctx, cOrganism* org)
 {
-  cOrganism* org_to_kill = org;
-  const Apto::Array<cOrganism*, Apto::Smart>& live_org_list = GetLiveOrgList();
-  Apto::Array<cOrganism*> TriedIdx(live_org_list.GetSize());
-  int list_size = TriedIdx.GetSize();
-  for (int i = 0; i < list_size; i ++) { TriedIdx[i] = live_org_list[i]; }
-  
-  int idx = ctx.GetRandom().GetUInt(list_size);
-  while (org_to_kill == org) {
-    cOrganism* org_at = TriedIdx[idx];
-    // exclude predators and juvenilles with predatory parents (include juvs with non-predatory parents)
-    if (org_at->GetForageTarget() > -1 || (org_at->GetForageTarget() == -1 && org_at->GetParentFT() > -2)) org_to_kill = org_at;
-    else TriedIdx.Swap(idx, --list_size);
-    if (list_size == 1) break;
-    idx = ctx.GetRandom().GetUInt(list_size);
-  }
+  cOrganism* org_to_kill = DrawRandLiveOrg(ctx, org, isRandPreyTarget);
   if (org_to_kill != org) m_world->GetPopulation().KillOrganism(m_world->GetPopulation().GetCell(org_to_kill->GetCellID()), ctx);
 }
 
 cOrganism* cPopulation::GetRandPrey(cAvidaContext& ctx, cOrganism* org)
 {
-  cOrganism* target_org = org;
-  const Apto::Array<cOrganism*, Apto::Smart>& live_org_list = GetLiveOrgList();
-  Apto::Array<cOrganism*> TriedIdx(live_org_list.GetSize());
-  int list_size = TriedIdx.GetSize();
-  for (int i = 0; i < list_size; i ++) { TriedIdx[i] = live_org_list[i]; }
-  
-  int idx = ctx.GetRandom().GetUInt(list_size);
-  while (target_org == org) {
-    cOrganism* org_at = TriedIdx[idx];
-    // exclude predators and juvenilles with predatory parents (include juvs with non-predatory parents)
-    if (org_at->GetForageTarget() > -1 || (org_at->GetForageTarget() == -1 && org_at->GetParentFT() > -2)) target_org = org_at;
-    else TriedIdx.Swap(idx, --list_size);
-    if (list_size == 1) break;
-    idx = ctx.GetRandom().GetUInt(list_size);
-  }
-  return target_org;
+  return DrawRandLiveOrg(ctx, org, isRandPreyTarget);
 }
 
 void cPopulation::KillOrganism(cPopulationCell& in_cell, cAvidaContext& ctx)
@@ -2359,9 +2383,9 @@ void cPopulation::Kaboom(cPopulationCell& in_cell, cAvidaContext& ctx, int dista
   Apto::String coop_inst = "Z";
   
   if (effect < 1)
-  agg_inst = m_world->GetHardwareManager().GetInstSet(organism->GetGenome().Properties().Get("instset").StringValue()).GetInst("agg-SA").GetSymbol();
+  agg_inst = m_world->GetHardwareManager().GetInstSet(organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue()).GetInst("agg-SA").GetSymbol();
   else
-  coop_inst = m_world->GetHardwareManager().GetInstSet(organism->GetGenome().Properties().Get("instset").StringValue()).GetInst("coop-SA").GetSymbol();
+  coop_inst = m_world->GetHardwareManager().GetInstSet(organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue()).GetInst("coop-SA").GetSymbol();
   int radius = m_world->GetConfig().KABOOM_RADIUS.Get();
   
   int sa_kin_count = 0;
@@ -2551,22 +2575,13 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
         }
         deme_fitness[deme_id] = single_deme_fitness.Ave();
       }
-      // ... then determine the rank of each deme based on its fitness
-      Apto::Array<double> deme_rank(num_demes);
-      deme_rank.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-          if (deme_fitness[deme_id] < deme_fitness[test_deme]) {
-            deme_rank[deme_id]++;
-          }
-        }
-      }
+      // ... then determine the rank of each deme based on its fitness (one plus the number of strictly fitter demes)
+      std::vector<double> sorted_fitness(&deme_fitness[0], &deme_fitness[0] + num_demes);
+      std::sort(sorted_fitness.begin(), sorted_fitness.end());
       // ... finally, make deme fitness 2^(-deme rank)
-      deme_fitness.SetAll(1);
       for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int i = 0; i < deme_rank[deme_id]; i++) {
-          deme_fitness[deme_id] = deme_fitness[deme_id]/2;
-        }
+        const int num_fitter = sorted_fitness.end() - std::upper_bound(sorted_fitness.begin(), sorted_fitness.end(), deme_fitness[deme_id]);
+        deme_fitness[deme_id] = ldexp(1.0, -(num_fitter + 1));
         total_fitness += deme_fitness[deme_id];
       }
     }
@@ -2599,22 +2614,13 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
         }
         deme_fitness[deme_id] = single_deme_life_fitness.Ave();
       }
-      // ... then determine the rank of each deme based on its fitness
-      Apto::Array<double> deme_rank(num_demes);
-      deme_rank.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-          if (deme_fitness[deme_id] < deme_fitness[test_deme]) {
-            deme_rank[deme_id]++;
-          }
-        }
-      }
+      // ... then determine the rank of each deme based on its fitness (one plus the number of strictly fitter demes)
+      std::vector<double> sorted_fitness(&deme_fitness[0], &deme_fitness[0] + num_demes);
+      std::sort(sorted_fitness.begin(), sorted_fitness.end());
       // ... finally, make deme fitness 2^(-deme rank)
-      deme_fitness.SetAll(1);
       for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int i = 0; i < deme_rank[deme_id]; i++) {
-          deme_fitness[deme_id] = deme_fitness[deme_id]/2;
-        }
+        const int num_fitter = sorted_fitness.end() - std::upper_bound(sorted_fitness.begin(), sorted_fitness.end(), deme_fitness[deme_id]);
+        deme_fitness[deme_id] = ldexp(1.0, -(num_fitter + 1));
         total_fitness += deme_fitness[deme_id];
       }
     }
@@ -2622,43 +2628,50 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
   }
   
   // Pick which demes should be in the next generation.
+  cFitnessSelector selector;
+  selector.SetWeights(&deme_fitness[0], num_demes);
+  const bool use_alias = (m_world->GetConfig().PROPORTIONAL_SAMPLER.Get() == 1);
+  
   Apto::Array<int> new_demes(num_demes);
+  new_demes.SetAll(-1);
   for (int i = 0; i < num_demes; i++) {
-    double birth_choice = (double) ctx.GetRandom().GetDouble(total_fitness);
-    double test_total = 0;
-    for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-      test_total += deme_fitness[test_deme];
-      if (birth_choice < test_total) {
-        new_demes[i] = test_deme;
-        break;
-      }
+    if (use_alias) {
+      new_demes[i] = selector.SelectAlias(ctx.GetRandom());
+      continue;
     }
+    const double birth_choice = (double) ctx.GetRandom().GetDouble(total_fitness);
+    new_demes[i] = selector.FindPosition(birth_choice);
   }
   
   // Track how many of each deme we should have.
   Apto::Array<int> deme_count(num_demes);
   deme_count.SetAll(0);
   for (int i = 0; i < num_demes; i++) {
-    deme_count[new_demes[i]]++;
+    if (new_demes[i] >= 0) deme_count[new_demes[i]]++;
   }
   
   Apto::Array<bool> is_init(num_demes);
   is_init.SetAll(false);
   
-  // Copy demes until all deme counts are 1.
+  // Copy demes until all deme counts are 1.  Counts only ever fall toward one on the from side and rise from zero on
+  // the to side, so neither search needs to revisit the demes it has already passed.
+  int last_from_deme_id = 0;
+  int last_to_deme_id = 0;
   while (true) {
     // Find the next deme to copy...
     int from_deme_id, to_deme_id;
-    for (from_deme_id = 0; from_deme_id < num_demes; from_deme_id++) {
+    for (from_deme_id = last_from_deme_id; from_deme_id < num_demes; from_deme_id++) {
       if (deme_count[from_deme_id] > 1) break;
     }
+    last_from_deme_id = from_deme_id;
     
     // Stop If we didn't find another deme to copy
     if (from_deme_id == num_demes) break;
     
-    for (to_deme_id = 0; to_deme_id < num_demes; to_deme_id++) {
+    for (to_deme_id = last_to_deme_id; to_deme_id < num_demes; to_deme_id++) {
       if (deme_count[to_deme_id] == 0) break;
     }
+    last_to_deme_id = to_deme_id;
     
     // We now have both a from and a to deme....
     deme_count[from_deme_id]--;
@@ -2790,6 +2803,10 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
   
   // Number of demes (at index) which should wind up in the next generation.
   std::vector<unsigned int> deme_counts(deme_array.GetSize(), 0);
+  
+  cFitnessSelector selector;
+  selector.SetWeights(&fitness[0], (int)fitness.size());
+  
   // Now, compete all demes based on the competition style.
   switch(m_world->GetConfig().DEMES_COMPETITION_STYLE.Get()) {
     case SELECTION_TYPE_PROPORTIONAL: {
@@ -2799,23 +2816,34 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
       
       const double total_fitness = std::accumulate(fitness.begin(), fitness.end(), 0.0);
       assert(total_fitness > 0.0); // Must have *some* positive fitnesses...
+      const bool use_alias = (m_world->GetConfig().PROPORTIONAL_SAMPLER.Get() == 1);
       
-      // Sum up the fitnesses until we reach or exceed the target fitness.
+      // Find the first deme whose running fitness total reaches the target fitness.
       // Then we're marking that deme as being part of the next generation.
       for (int i=0; i<deme_array.GetSize(); ++i) {
-        double running_sum = 0.0;
-        double target_sum = ctx.GetRandom().GetDouble(total_fitness);
-        for (int j=0; j<deme_array.GetSize(); ++j) {
-          running_sum += fitness[j];
-          if (running_sum >= target_sum) {
-            // j'th deme will be replicated.
-            ++deme_counts[j];
-            break;
-          }
+        int j = -1;
+        if (use_alias) {
+          j = selector.SelectAlias(ctx.GetRandom());
+        } else {
+          double target_sum = ctx.GetRandom().GetDouble(total_fitness);
+          j = selector.FindPositionInclusive(target_sum);
         }
+        // j'th deme will be replicated.
+        if (j >= 0) ++deme_counts[j];
       }
       break;
     }
+    case SELECTION_TYPE_UNIVERSAL: {
+      // Stochastic universal sampling.
+      // Same expected number of copies per deme as fitness-proportional selection, but the picks are evenly
+      // spaced across the fitness total, so a deme's count never strays far from its share.
+      assert(selector.GetTotalWeight() > 0.0); // Must have *some* positive fitnesses...
+      
+      Apto::Array<int> counts;
+      selector.SelectUniversal(ctx.GetRandom(), deme_array.GetSize(), counts);
+      for (int i=0; i<counts.GetSize(); ++i) deme_counts[i] = counts[i];
+      break;
+    }
     case SELECTION_TYPE_TOURNAMENT: {
       // Tournament selection.
       //
@@ -2852,15 +2880,11 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
         //
         // If no deme actually won, meaning no one had fitness greater than 0.0,
         // then the winner is selected at random from the tournament.
-        std::pair<int, double> winner(tournament[ctx.GetRandom().GetInt(tournament.size())], 0.0);
-        for(std::vector<int>::iterator j=tournament.begin(); j!=tournament.end(); ++j) {
-          if (fitness[*j] > winner.second) {
-            winner = std::make_pair(*j, fitness[*j]);
-          }
-        }
+        const int default_winner = tournament[ctx.GetRandom().GetInt(tournament.size())];
+        const int winner = selector.SelectTournamentWinner(&tournament[0], (int)tournament.size(), default_winner);
         
         // We have a winner!  Increment his replication count.
-        ++deme_counts[winner.first];
+        ++deme_counts[winner];
       }
       break;
     }
@@ -2878,9 +2902,12 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
   
   // Ok, the below algorithm relies upon the fact that we have a strict weak ordering
   // of fitness values for all demes.  We're going to loop through, find demes with a
-  // count greater than one, and insert them into demes with a count of zero.
+  // count greater than one, and insert them into demes with a count of zero.  Neither search needs to go back over
+  // the demes it has already passed, since counts only fall toward one on the source side and rise from zero on the
+  // target side.
+  int source_id=0;
+  int target_id=0;
   while (true) {
-    int source_id=0;
     for(; source_id<(int)deme_counts.size(); ++source_id) {
       if (deme_counts[source_id] > 1) {
         --deme_counts[source_id];
@@ -2892,7 +2919,6 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
       break; // All done; we looped through the whole list of counts, and didn't find any > 1.
     }
     
-    int target_id=0;
     for(; target_id<(int)deme_counts.size(); ++target_id) {
       if (deme_counts[target_id] == 0) {
         ++deme_counts[target_id];
@@ -3253,7 +3279,7 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
     assert(germline_genotype);
     
     // create a new genome by mutation
-    Genome mg(germline_genotype->Properties().Get("genome"));
+    Genome mg(germline_genotype->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
@@ -3430,7 +3456,7 @@ void cPopulation::ReplaceDemeFlaggedGermline(cDeme& source_deme, cDeme& target_d
     // this is the genotype of the organism, which does not reflect any point mutations that have occurred. 
     // we need to use it to get the right length for the genome
     Systematics::GroupPtr parent_bg = target_founders[i]->SystematicsGroup("genotype");
-    Genome mg(parent_bg->Properties().Get("genome"));
+    Genome mg(parent_bg->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
@@ -3543,7 +3569,7 @@ void cPopulation::SeedDeme(cDeme& _deme, Systematics::GroupPtr bg, Systematics::
   // Create the specified number of organisms in the deme.
   for(int i=0; i< m_world->GetConfig().DEMES_REPLICATE_SIZE.Get(); ++i) {
     int cellid = DemeSelectInjectionCell(_deme, i);
-    InjectGenome(cellid, src, Genome(bg->Properties().Get("genome")), ctx); 
+    InjectGenome(cellid, src, Genome(bg->Properties().Get(s_prop_id_genome)), ctx); 
     DemePostInjection(_deme, cell_array[cellid]);
     _deme.AddFounder(bg);
   }
@@ -4062,7 +4088,7 @@ void cPopulation::SeedDeme_InjectDemeFounder(int _cell_id, Systematics::GroupPtr
     // MUTATE!
     
     // create a new genome by mutation
-    Genome mg(bg->Properties().Get("genome"));
+    Genome mg(bg->Properties().Get(s_prop_id_genome));
     InstructionSequencePtr seq;
     seq.DynamicCastFrom(mg.Representation());
     cCPUMemory new_genome(*seq);
@@ -4093,7 +4119,7 @@ void cPopulation::SeedDeme_InjectDemeFounder(int _cell_id, Systematics::GroupPtr
     
   } else {    
     // phenotype can be NULL
-    InjectGenome(_cell_id, Systematics::Source(Systematics::DUPLICATION, ""), Genome(bg->Properties().Get("genome")), ctx, lineage_label);
+    InjectGenome(_cell_id, Systematics::Source(Systematics::DUPLICATION, ""), Genome(bg->Properties().Get(s_prop_id_genome)), ctx, lineage_label);
   }
   
   // At this point, the cell had better be occupied...
@@ -5924,40 +5950,46 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     if (cur_gestation_time < min_gestation_time) min_gestation_time = cur_gestation_time;
     if (cur_genome_length < min_genome_length) min_genome_length = cur_genome_length;
     
-    // Test what tasks this creatures has completed.
-    for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) {
+    // Test what tasks this creatures has completed.  Only the tasks the phenotype has counts for need to be visited.
+    const Apto::Array<int>& cur_task_ids = phenotype.GetCurTaskIDs();
+    for (int k = 0; k < cur_task_ids.GetSize(); k++) {
+      const int j = cur_task_ids[k];
       if (phenotype.GetCurTaskCount()[j] > 0) {
         stats.AddCurTask(j);
         stats.AddCurTaskQuality(j, phenotype.GetCurTaskQuality()[j]);
       }
       
+      if (phenotype.GetCurHostTaskCount()[j] > 0) {
+        stats.AddCurHostTask(j);
+      }
+      
+      if (phenotype.GetCurParasiteTaskCount()[j] > 0) {
+        stats.AddCurParasiteTask(j);
+      }
+      
+      if (phenotype.GetCurInternalTaskCount()[j] > 0) {
+        stats.AddCurInternalTask(j);
+        stats.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
+      }
+    }
+    
+    const Apto::Array<int>& last_task_ids = phenotype.GetLastTaskIDs();
+    for (int k = 0; k < last_task_ids.GetSize(); k++) {
+      const int j = last_task_ids[k];
       if (phenotype.GetLastTaskCount()[j] > 0) {
         stats.AddLastTask(j);
         stats.AddLastTaskQuality(j, phenotype.GetLastTaskQuality()[j]);
         stats.IncTaskExeCount(j, phenotype.GetLastTaskCount()[j]);
       }
       
-      if (phenotype.GetCurHostTaskCount()[j] > 0) {
-        stats.AddCurHostTask(j);
-      }
-      
       if (phenotype.GetLastHostTaskCount()[j] > 0) {
         stats.AddLastHostTask(j);
       }
       
-      if (phenotype.GetCurParasiteTaskCount()[j] > 0) {
-        stats.AddCurParasiteTask(j);
-      }
-      
       if (phenotype.GetLastParasiteTaskCount()[j] > 0) {
         stats.AddLastParasiteTask(j);
       }
       
-      if (phenotype.GetCurInternalTaskCount()[j] > 0) {
-        stats.AddCurInternalTask(j);
-        stats.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
-      }
-      
       if (phenotype.GetLastInternalTaskCount()[j] > 0) {
         stats.AddLastInternalTask(j);
         stats.AddLastInternalTaskQuality(j, phenotype.GetLastInternalTaskQuality()[j]);
@@ -5974,12 +6006,18 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     
     
     // Record what add bonuses this organism garnered for different reactions
-    for (int j = 0; j < m_world->GetEnvironment().GetNumReactions(); j++) {
+    const Apto::Array<int>& cur_reaction_ids = phenotype.GetCurReactionIDs();
+    for (int k = 0; k < cur_reaction_ids.GetSize(); k++) {
+      const int j = cur_reaction_ids[k];
       if (phenotype.GetCurReactionCount()[j] > 0) {
         stats.AddCurReaction(j);
         stats.AddCurReactionAddReward(j, phenotype.GetCurReactionAddReward()[j]);
       }
-      
+    }
+    
+    const Apto::Array<int>& last_reaction_ids = phenotype.GetLastReactionIDs();
+    for (int k = 0; k < last_reaction_ids.GetSize(); k++) {
+      const int j = last_reaction_ids[k];
       if (phenotype.GetLastReactionCount()[j] > 0) {
         stats.AddLastReaction(j);
         stats.IncReactionExeCount(j, phenotype.GetLastReactionCount()[j]);
@@ -6573,8 +6611,9 @@ bool cPopulation::LoadStructuredSystematicsGroup(cAvidaContext& ctx, const Syste
     // Process resident cell ids
     cString cellstr(props->Get("cells"));
     if (cellstr.GetSize()) {
-      while (cellstr.GetSize()) {
-        int cell_id = cellstr.Pop(',').AsInt();
+      cStringTokenizer cells(cellstr, ',');
+      while (!cells.AtEnd()) {
+        int cell_id = cells.Next().AsInt();
         if (cell_array[cell_id].IsOccupied()) {
           Systematics::UnitPtr unit(cell_array[cell_id].GetOrganism());
           cell_array[cell_id].GetOrganism()->AddReference(); // creating new smart pointer to org, explicitly add reference
@@ -6649,6 +6688,26 @@ bool cPopulation::SaveFlameData(const cString& filename)
   return true;
 }
 
+// Split a comma separated list of values in a single pass.  Repeated cString::Pop() copies the remainder of the
+// string on every call, which is quadratic in the length of the long cell lists found in population files.  Values
+// convert as cString::AsInt()/AsDouble() would, so empty fields still read as zero.
+static inline void parseListValue(const char* str, int& value) { value = static_cast<int>(strtol(str, NULL, 0)); }
+static inline void parseListValue(const char* str, bool& value) { value = (static_cast<int>(strtol(str, NULL, 0)) != 0); }
+static inline void parseListValue(const char* str, double& value) { value = strtod(str, NULL); }
+
+template <typename T> static void parseCommaList(const cString& str, Apto::Array<T>& list)
+{
+  const char* cur = str;
+  while (*cur != '\0') {
+    T value;
+    parseListValue(cur, value);
+    list.Push(value);
+    const char* comma = strchr(cur, ',');
+    if (!comma) break;
+    cur = comma + 1;
+  }
+}
+
 struct sTmpGenotype
 {
 public:
@@ -6715,7 +6774,15 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
 {
   // @TODO - build in support for verifying population dimensions
   
-  cInitFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback());
+  cMappedTextFile input_file(filename, m_world->GetWorkingDir(), m_world->GetConfig().MAX_CONCURRENCY.Get());
+  const cUserFeedback& feedback = input_file.GetFeedback();
+  for (int i = 0; i < feedback.GetNumMessages(); i++) {
+    switch (feedback.GetMessageType(i)) {
+      case cUserFeedback::UF_ERROR:    ctx.Driver().Feedback().Error(feedback.GetMessage(i)); break;
+      case cUserFeedback::UF_WARNING:  ctx.Driver().Feedback().Warning(feedback.GetMessage(i)); break;
+      default:                      ctx.Driver().Feedback().Notify(feedback.GetMessage(i)); break;
+    };
+  }
   if (!input_file.WasOpened()) return false;
   
   // Clear out the population, unless an offset is being used
@@ -6743,7 +6810,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
     cString cellstr(tmp.props->Get("cells"));
     if (structured || cellstr.GetSize()) {
       structured = true;
-      while (cellstr.GetSize()) tmp.cells.Push(cellstr.Pop(',').AsInt());
+      parseCommaList(cellstr, tmp.cells);
       assert(tmp.cells.GetSize() == tmp.num_cpus);
     }
     
@@ -6751,13 +6818,13 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
     if (!load_rebirth) {
       cString offsetstr(tmp.props->Get("gest_offset"));
       if (offsetstr.GetSize()) {
-        while (offsetstr.GetSize()) tmp.offsets.Push(offsetstr.Pop(',').AsInt());
+        parseCommaList(offsetstr, tmp.offsets);
         assert(tmp.offsets.GetSize() == tmp.num_cpus);
       }
     }
     // Lineage label (only set if given in file)
     cString lineagestr(tmp.props->Get("lineage"));
-    while (lineagestr.GetSize()) tmp.lineage_labels.Push(lineagestr.Pop(',').AsInt());
+    parseCommaList(lineagestr, tmp.lineage_labels);
     // @blw preserve compatability with older .spop files that don't have lineage labels
     assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
     
@@ -6765,27 +6832,27 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
     if (load_rebirth) {
       if (tmp.props->Has("birth_cell")) {
         cString birthstr(tmp.props->Get("birth_cell"));
-        while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
+        parseCommaList(birthstr, tmp.birth_cells);
         assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
       }
       if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
         cString avatarstr(tmp.props->Get("av_bcell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+        parseCommaList(avatarstr, tmp.avatar_cells);
         assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
       }
       if (tmp.props->Has("parent_is_teach")) {
         cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
+        parseCommaList(teachstr, tmp.parent_teacher);
         assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
       }
       if (tmp.props->Has("parent_ft")) {
         cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
+        parseCommaList(parentftstr, tmp.parent_ft);
         assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
       }
       if (tmp.props->Has("parent_merit")) {
         cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
+        parseCommaList(meritstr, tmp.parent_merit);
         assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
       }
     }
@@ -6793,53 +6860,53 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
       if (load_groups) {
         if (tmp.props->Has("group_id")) {
           cString groupstr(tmp.props->Get("group_id"));
-          while (groupstr.GetSize()) tmp.group_ids.Push(groupstr.Pop(',').AsInt());
+          parseCommaList(groupstr, tmp.group_ids);
           assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
         }
         if (tmp.props->Has("forager_type")) {
           cString foragestr(tmp.props->Get("forager_type"));
-          while (foragestr.GetSize()) tmp.forager_types.Push(foragestr.Pop(',').AsInt());
+          parseCommaList(foragestr, tmp.forager_types);
           assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
         }
       }
       if (load_birth_cells) {   
         if (tmp.props->Has("birth_cell")) {
           cString birthstr(tmp.props->Get("birth_cell"));
-          while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
+          parseCommaList(birthstr, tmp.birth_cells);
           assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
         }
         if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
           cString avatarstr(tmp.props->Get("av_bcell"));
-          while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+          parseCommaList(avatarstr, tmp.avatar_cells);
           assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
         }
       }
       else if (!load_birth_cells && load_avatars && tmp.props->Has("avatar_cell")) {
         cString avatarstr(tmp.props->Get("avatar_cell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+        parseCommaList(avatarstr, tmp.avatar_cells);
         assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
       }
     if (load_parent_dat) {
       if (tmp.props->Has("parent_is_teach")) {
         cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
+        parseCommaList(teachstr, tmp.parent_teacher);
         assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
       }
       if (tmp.props->Has("parent_ft")) {
         cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
+        parseCommaList(parentftstr, tmp.parent_ft);
         assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
       }
       if (tmp.props->Has("parent_merit")) {
         cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
+        parseCommaList(meritstr, tmp.parent_merit);
         assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
       }
     }
     }
     if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
       cString avatarstr(tmp.props->Get("avatar_cell"));
-      while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+      parseCommaList(avatarstr, tmp.avatar_cells);
       assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
     }
   }
@@ -6850,6 +6917,9 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
   Systematics::ArbiterPtr bgm = classmgr->ArbiterForRole("genotype");
   
+  // Index of each id among the genotypes already loaded (those after i), for the parent lookups
+  Apto::Map<int, int> loaded_index;
+  
   bool some_missing = false;
   for (int i = genotypes.GetSize() - 1; i >= 0; i--) {
     // Fix Parent IDs
@@ -6861,12 +6931,8 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
     while (opidlist.GetSize()) {
       int opid = opidlist.Pop().AsInt();
       int npid = -1;
-      for (int j = i; j < genotypes.GetSize(); j++) {
-        if (genotypes[j].id_num == opid) {
-          npid = genotypes[j].bg->ID();
-          break;
-        }
-      }
+      int j = -1;
+      if (loaded_index.Get(opid, j)) npid = genotypes[j].bg->ID();
       // only for pop saves that include historic (i.e. parent id found):
       if (npid != -1) {
         if (pcount) nparentstr += ",";
@@ -6878,6 +6944,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
     genotypes[i].props->Set("parents", (const char*)nparentstr);
     
     genotypes[i].bg = bgm->LegacyLoad(&genotypes[i].props);
+    loaded_index.Set(genotypes[i].id_num, i);
   }  
 //  if (some_missing) m_world->GetDriver().Feedback().Warning("Some parents not found in loaded pop file. Defaulting to parent ID of '(none)' for those genomes.");
   
@@ -6897,8 +6964,8 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         lineage_label = tmp.lineage_labels[cell_i] + lineage_offset;
       }
       
-      assert(tmp.bg->Properties().Has("genome"));
-      Genome mg(tmp.bg->Properties().Get("genome"));
+      assert(tmp.bg->Properties().Has(s_prop_id_genome));
+      Genome mg(tmp.bg->Properties().Get(s_prop_id_genome));
       cOrganism* new_organism = new cOrganism(m_world, ctx, mg, -1, Systematics::Source(Systematics::DIVISION, (const char*)filename, true));
       
       // Setup the phenotype...
@@ -7018,6 +7085,282 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   return true;
 }
 
+bool cPopulation::SaveCheckpoint(const cString& filename, cAvidaContext& ctx, bool background)
+{
+  // Only one checkpoint write may be outstanding; wait for the previous one before reusing its slot
+  if (m_checkpoint_thread) {
+    m_checkpoint_thread->Join();
+    if (!m_checkpoint_thread->WasSuccessful()) {
+      ctx.Driver().Feedback().Warning("failed to write checkpoint '%s'", (const char*)m_checkpoint_thread->GetFilename());
+    }
+    delete m_checkpoint_thread;
+    m_checkpoint_thread = NULL;
+  }
+  
+  // Refuse configurations whose state the checkpoint cannot carry, rather than write one that resumes inexactly
+  if (deme_array.GetSize() > 1) {
+    ctx.Driver().Feedback().Error("checkpoints do not support worlds with multiple demes (deme state is not saved)");
+    return false;
+  }
+  if (birth_chamber.MayHoldOffspring()) {
+    ctx.Driver().Feedback().Error("checkpoints do not support sexual or waiting births (the birth chamber is not saved)");
+    return false;
+  }
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (cell_array[i].IsOccupied() && !cell_array[i].GetOrganism()->GetHardware().SupportsCheckpoint()) {
+      ctx.Driver().Feedback().Error("checkpoints do not support hardware type %d (its execution state is not saved)",
+                                    cell_array[i].GetOrganism()->GetHardware().GetType());
+      return false;
+    }
+  }
+  
+  // Bring output files up to date with the state being saved
+  Output::Manager::Of(m_world->GetNewWorld())->FlushAll();
+  
+  cCheckpointWriter* ckp = new cCheckpointWriter;
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_HEADER);
+  ckp->WriteInt(world_x);
+  ckp->WriteInt(world_y);
+  ckp->WriteInt(cell_array.GetSize());
+  ckp->WriteInt(m_world->GetStats().GetUpdate());
+  ckp->EndSection();
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_STATS);
+  m_world->GetStats().SaveState(*ckp);
+  ckp->EndSection();
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_EVENTS);
+  m_world->GetEventsList()->SaveState(*ckp);
+  ckp->EndSection();
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_RESOURCES);
+  ckp->WriteInt(resource_count.GetSize());
+  for (int i = 0; i < resource_count.GetSize(); i++) {
+    const bool spatial = resource_count.IsSpatialResource(i);
+    ckp->WriteBool(spatial);
+    if (!spatial) {
+      ckp->WriteDouble(resource_count.Get(ctx, i));
+    } else {
+      const cSpatialResCount& sp_res = resource_count.GetSpatialResource(i);
+      ckp->WriteInt(sp_res.GetSize());
+      for (int j = 0; j < sp_res.GetSize(); j++) ckp->WriteDouble(sp_res.GetAmount(j));
+    }
+  }
+  ckp->EndSection();
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_CELLS);
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    const cPopulationCell& cell = cell_array[i];
+    ckp->WriteIntArray(cell.m_inputs);
+    ckp->WriteInt(cell.m_cell_data.contents);
+    ckp->WriteInt(cell.m_cell_data.org_id);
+    ckp->WriteInt(cell.m_cell_data.update);
+    ckp->WriteInt(cell.m_cell_data.territory);
+    ckp->WriteInt(cell.m_cell_data.current);
+    ckp->WriteInt(cell.m_cell_data.forager);
+    ckp->WriteInt(cell.m_visits);
+    ckp->WriteInt(cell.m_connections.GetSize() ? cell.m_connections.GetFirst()->GetID() : -1);
+  }
+  ckp->EndSection();
+  
+  // Genotypes of all living organisms, indexed in order of first appearance
+  Apto::Map<int, int> genotype_index;
+  Apto::Array<Systematics::GroupPtr> genotypes;
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (!cell_array[i].IsOccupied()) continue;
+    Systematics::GroupPtr genotype = cell_array[i].GetOrganism()->SystematicsGroup("genotype");
+    if (genotype == NULL || genotype_index.Has(genotype->ID())) continue;
+    genotype_index.Set(genotype->ID(), genotypes.GetSize());
+    genotypes.Push(genotype);
+  }
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_GENOTYPES);
+  ckp->WriteInt(genotypes.GetSize());
+  for (int i = 0; i < genotypes.GetSize(); i++) {
+    ckp->WriteString(genotypes[i]->Properties().Get(s_prop_id_genome).StringValue());
+    ckp->WriteInt(genotypes[i]->Properties().Get(s_prop_id_update_born).IntValue());
+    ckp->WriteInt(genotypes[i]->Depth());
+  }
+  ckp->EndSection();
+  
+  ckp->BeginSection(CHECKPOINT_SECTION_ORGANISMS);
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (!cell_array[i].IsOccupied()) continue;
+    cOrganism* org = cell_array[i].GetOrganism();
+    Systematics::GroupPtr genotype = org->SystematicsGroup("genotype");
+    if (genotype == NULL) continue;
+    
+    ckp->WriteInt(i);
+    ckp->WriteInt(genotype_index.Get(genotype->ID()));
+    ckp->WriteInt(org->GetLineageLabel());
+    org->SaveState(*ckp);
+  }
+  ckp->WriteInt(-1);
+  ckp->EndSection();
+  
+  // The random number generator is deliberately left alone: saving must not change the course of the run, and the
+  // generator does not expose its internal state for serialization (see LoadCheckpoint)
+  
+  if (background) {
+    m_checkpoint_thread = new cCheckpointFlushThread(ckp, filename);
+    m_checkpoint_thread->Start();
+    return true;
+  }
+  
+  const bool success = ckp->WriteToFile(filename);
+  delete ckp;
+  return success;
+}
+
+
+bool cPopulation::LoadCheckpoint(const cString& filename, cAvidaContext& ctx, bool allow_inexact)
+{
+  // Checkpoints do not carry the generator state or the full systematics, so never resume as if they did
+  if (!allow_inexact) {
+    ctx.Driver().Feedback().Error("checkpoint '%s' cannot be resumed exactly: the random number state, genotype IDs and "
+                                  "historic genotypes are not saved (use inexact=1 to resume anyway)", (const char*)filename);
+    return false;
+  }
+  
+  // Make sure any checkpoint still being written has landed on disk
+  if (m_checkpoint_thread) {
+    m_checkpoint_thread->Join();
+    delete m_checkpoint_thread;
+    m_checkpoint_thread = NULL;
+  }
+  
+  cCheckpointReader ckp;
+  if (!ckp.Open(filename)) {
+    ctx.Driver().Feedback().Error("unable to open checkpoint '%s'", (const char*)filename);
+    return false;
+  }
+  
+  unsigned int tag = 0;
+  if (!ckp.NextSection(tag) || tag != CHECKPOINT_SECTION_HEADER) return false;
+  const int ckp_world_x = ckp.ReadInt();
+  const int ckp_world_y = ckp.ReadInt();
+  const int ckp_num_cells = ckp.ReadInt();
+  if (ckp_world_x != world_x || ckp_world_y != world_y || ckp_num_cells != cell_array.GetSize()) {
+    ctx.Driver().Feedback().Error("checkpoint '%s' was saved with a %dx%d world", (const char*)filename, ckp_world_x, ckp_world_y);
+    return false;
+  }
+  ckp.ReadInt(); // update, restored with the stats
+  
+  for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx);
+  
+  Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
+  Systematics::ArbiterPtr bgm = classmgr->ArbiterForRole("genotype");
+  Apto::Array<Systematics::GroupPtr> genotypes;
+  
+  while (ckp.NextSection(tag)) {
+    if (tag == CHECKPOINT_SECTION_STATS) {
+      if (!m_world->GetStats().LoadState(ckp)) {
+        ctx.Driver().Feedback().Error("checkpoint '%s' stats do not match this configuration", (const char*)filename);
+        return false;
+      }
+    } else if (tag == CHECKPOINT_SECTION_EVENTS) {
+      m_world->GetEventsList()->LoadState(ckp, ctx.Driver().Feedback());
+    } else if (tag == CHECKPOINT_SECTION_RESOURCES) {
+      const int num_res = ckp.ReadInt();
+      if (num_res != resource_count.GetSize()) return false;
+      
+      Apto::Array<double> cell_res(num_res);
+      cell_res.SetAll(0.0);
+      Apto::Array<Apto::Array<double> > spatial_amounts(num_res);
+      for (int i = 0; i < num_res; i++) {
+        if (!ckp.ReadBool()) {
+          resource_count.Set(ctx, i, ckp.ReadDouble());
+        } else {
+          const int num_cells = ckp.ReadInt();
+          spatial_amounts[i].Resize(num_cells);
+          for (int j = 0; j < num_cells; j++) spatial_amounts[i][j] = ckp.ReadDouble();
+        }
+      }
+      for (int cell_id = 0; cell_id < cell_array.GetSize(); cell_id++) {
+        for (int i = 0; i < num_res; i++) {
+          if (cell_id < spatial_amounts[i].GetSize()) cell_res[i] = spatial_amounts[i][cell_id];
+        }
+        resource_count.SetCellResources(cell_id, cell_res);
+      }
+    } else if (tag == CHECKPOINT_SECTION_CELLS) {
+      for (int i = 0; i < cell_array.GetSize(); i++) {
+        cPopulationCell& cell = cell_array[i];
+        ckp.ReadIntArray(cell.m_inputs);
+        cell.m_cell_data.contents = ckp.ReadInt();
+        cell.m_cell_data.org_id = ckp.ReadInt();
+        cell.m_cell_data.update = ckp.ReadInt();
+        cell.m_cell_data.territory = ckp.ReadInt();
+        cell.m_cell_data.current = ckp.ReadInt();
+        cell.m_cell_data.forager = ckp.ReadInt();
+        cell.m_visits = ckp.ReadInt();
+        const int faced_id = ckp.ReadInt();
+        if (faced_id >= 0 && faced_id < cell_array.GetSize()) cell.Rotate(cell_array[faced_id]);
+      }
+    } else if (tag == CHECKPOINT_SECTION_GENOTYPES) {
+      const int num_genotypes = ckp.ReadInt();
+      genotypes.Resize(num_genotypes);
+      for (int i = 0; i < num_genotypes; i++) {
+        // Genome strings take the form "hw_type,inst_set,sequence"
+        cString genome_str = ckp.ReadString();
+        Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props(new Apto::Map<Apto::String, Apto::String>);
+        props->Set("hw_type", (const char*)genome_str.Pop(','));
+        props->Set("inst_set", (const char*)genome_str.Pop(','));
+        props->Set("sequence", (const char*)genome_str);
+        props->Set("src_args", (const char*)filename);
+        props->Set("update_born", Apto::AsStr(ckp.ReadInt()));
+        props->Set("depth", Apto::AsStr(ckp.ReadInt()));
+        props->Set("parents", "");
+        genotypes[i] = bgm->LegacyLoad(&props);
+      }
+    } else if (tag == CHECKPOINT_SECTION_ORGANISMS) {
+      for (int cell_id = ckp.ReadInt(); cell_id >= 0 && ckp.Good(); cell_id = ckp.ReadInt()) {
+        const int genotype_id = ckp.ReadInt();
+        const int lineage_label = ckp.ReadInt();
+        if (cell_id >= cell_array.GetSize() || genotype_id < 0 || genotype_id >= genotypes.GetSize()) return false;
+        
+        Systematics::GroupPtr bg = genotypes[genotype_id];
+        Genome mg(bg->Properties().Get(s_prop_id_genome));
+        cOrganism* new_organism = new cOrganism(m_world, ctx, mg, -1, Systematics::Source(Systematics::DIVISION, (const char*)filename, true));
+        
+        InstructionSequencePtr seq;
+        seq.DynamicCastFrom(mg.Representation());
+        new_organism->GetPhenotype().SetupInject(*seq);
+        
+        Systematics::RoleClassificationHints hints;
+        hints["genotype"]["id"] = Apto::FormatStr("%d", bg->ID());
+        Systematics::UnitPtr unit(new_organism);
+        new_organism->AddReference(); // creating new smart pointer to org, explicitly add reference
+        classmgr->ClassifyNewUnit(unit, &hints);
+        
+        new_organism->SetCCladeLabel(-1);
+        new_organism->SetLineageLabel(lineage_label);
+        new_organism->MutationRates().Copy(cell_array[cell_id].MutationRates());
+        
+        if (!ActivateOrganism(ctx, new_organism, cell_array[cell_id], true, true)) continue;
+        
+        // Overwrite the freshly injected state with the saved one
+        if (!new_organism->LoadState(ckp)) {
+          ctx.Driver().Feedback().Error("corrupt organism state in checkpoint '%s'", (const char*)filename);
+          return false;
+        }
+        AdjustSchedule(cell_array[cell_id], new_organism->GetPhenotype().GetMerit());
+      }
+    }
+    
+    if (!ckp.Good()) {
+      ctx.Driver().Feedback().Error("corrupt checkpoint '%s'", (const char*)filename);
+      return false;
+    }
+  }
+  
+  ctx.Driver().Feedback().Warning("checkpoint '%s' restored inexactly; the random number sequence is not continued and "
+                                  "genotypes were renumbered", (const char*)filename);
+  
+  sync_events = true;
+  return true;
+}
+
 /**
  * This function loads a genome from a given file, and initializes
  * a cpu with it.
@@ -7936,6 +8279,7 @@ void cPopulation::CompeteOrganisms(cAvidaContext& ctx, int competition_type, int
   double total_fitness = 0;
   int num_cells = GetSize();
   Apto::Array<double> org_fitness(num_cells);
+  org_fitness.SetAll(0.0);   // empty cells never win a draw
   
   double lowest_fitness = -1.0;
   double average_fitness = 0;
@@ -8127,21 +8471,27 @@ void cPopulation::CompeteOrganisms(cAvidaContext& ctx, int competition_type, int
   }
   
   // Pick which orgs should be in the next generation. (Filling all cells)
+  cFitnessSelector selector;
+  selector.SetWeights(&org_fitness[0], num_cells);
+  const bool use_alias = (m_world->GetConfig().PROPORTIONAL_SAMPLER.Get() == 1);
+  
   Apto::Array<int> new_orgs(num_cells);
+  new_orgs.SetAll(-1);
   for (int i = 0; i < num_cells; i++) {
-    double birth_choice = (double) ctx.GetRandom().GetDouble(total_fitness);
-    double test_total = 0;
-    for (int test_org = 0; test_org < num_cells; test_org++) {
-      test_total += org_fitness[test_org];
-      if (birth_choice < test_total) {
-        new_orgs[i] = test_org;
-        if (m_world->GetVerbosity() >= VERBOSE_DETAILS) cout << "Propagating from cell " << test_org << " to " << i << endl;
-        if ((highest_fitness_copied == -1.0) || (org_fitness[test_org] > highest_fitness_copied)) highest_fitness_copied = org_fitness[test_org];
-        if ((lowest_fitness_copied == -1.0) || (org_fitness[test_org] < lowest_fitness_copied)) lowest_fitness_copied = org_fitness[test_org];
-        average_fitness_copied += org_fitness[test_org];
-        break;
-      }
+    int test_org = -1;
+    if (use_alias) {
+      test_org = selector.SelectAlias(ctx.GetRandom());
+    } else {
+      double birth_choice = (double) ctx.GetRandom().GetDouble(total_fitness);
+      test_org = selector.FindPosition(birth_choice);
     }
+    if (test_org < 0) continue;
+    
+    new_orgs[i] = test_org;
+    if (m_world->GetVerbosity() >= VERBOSE_DETAILS) cout << "Propagating from cell " << test_org << " to " << i << endl;
+    if ((highest_fitness_copied == -1.0) || (org_fitness[test_org] > highest_fitness_copied)) highest_fitness_copied = org_fitness[test_org];
+    if ((lowest_fitness_copied == -1.0) || (org_fitness[test_org] < lowest_fitness_copied)) lowest_fitness_copied = org_fitness[test_org];
+    average_fitness_copied += org_fitness[test_org];
   }
   // average assumes we fill all cells.
   average_fitness_copied /= num_cells;
@@ -8150,7 +8500,7 @@ void cPopulation::CompeteOrganisms(cAvidaContext& ctx, int competition_type, int
   Apto::Array<int> org_count(num_cells);
   org_count.SetAll(0);
   for (int i = 0; i < num_cells; i++) {
-    org_count[new_orgs[i]]++;
+    if (new_orgs[i] >= 0) org_count[new_orgs[i]]++;
   }
   
   // Reset organism phenotypes that have successfully divided! Must do before injecting children.
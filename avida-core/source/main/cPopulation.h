@@ -28,6 +28,7 @@
 #include "cBirthChamber.h"
 #include "cDeme.h"
 #include "cOrgInterface.h"
+#include "cOrgSpatialIndex.h"
 #include "cPopulationInterface.h"
 #include "cResourceCount.h"
 #include "cString.h"
@@ -39,6 +40,7 @@
 
 
 class cAvidaContext;
+class cCheckpointFlushThread;
 class cCodeLabel;
 class cEnvironment;
 class cLineage;
@@ -79,6 +81,7 @@ private:
   
   // Keep list of live organisms
   Apto::Array<cOrganism*, Apto::Smart> live_org_list;
+  cOrgSpatialIndex m_org_index;        // Tile counts of organisms and avatars, kept current by the cells
   
   Apto::Array<cPopulationOrgStatProviderPtr> m_org_stat_providers;
   
@@ -115,6 +118,7 @@ private:
  
   // Outside interactions...
   bool sync_events;   // Do we need to sync up the event list with population?
+  cCheckpointFlushThread* m_checkpoint_thread;  // Background writer for the most recent checkpoint, if any
 	
   // Group formation information
   std::map<int, int> m_groups; //<! Maps the group id to the number of orgs in the group
@@ -280,6 +284,8 @@ public:
   bool LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset=0, int lineage_offset=0,
                       bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
   bool SaveFlameData(const cString& filename);
+  bool SaveCheckpoint(const cString& filename, cAvidaContext& ctx, bool background = true);
+  bool LoadCheckpoint(const cString& filename, cAvidaContext& ctx, bool allow_inexact = false);
   
   void SetMiniTraceQueue(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void AppendMiniTraces(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
@@ -330,6 +336,8 @@ public:
   void SetResource(cAvidaContext& ctx, const cString res_name, double new_level);
   double GetResource(cAvidaContext& ctx, int id) const { return resource_count.Get(ctx, id); }
   cResourceCount& GetResourceCount() { return resource_count; }
+  cOrgSpatialIndex& GetOrgSpatialIndex() { return m_org_index; }
+  const cOrgSpatialIndex& GetOrgSpatialIndex() const { return m_org_index; }
   void SetResourceInflow(const cString res_name, double new_level);
   void SetResourceOutflow(const cString res_name, double new_level);
   
@@ -488,6 +496,7 @@ private:
   void PrintMiniTraceSuccess(const int exec_success);
 
   int PlaceAvatar(cAvidaContext& ctx, cOrganism* parent);
+  cOrganism* DrawRandLiveOrg(cAvidaContext& ctx, cOrganism* org, bool (*is_target)(cOrganism*));
   
   inline void AdjustSchedule(const cPopulationCell& cell, const cMerit& merit);
   
@@ -39,6 +39,7 @@ using namespace std;
 
 cPopulationCell::cPopulationCell(const cPopulationCell& in_cell)
 : m_world(in_cell.m_world)
+, m_org_index(in_cell.m_org_index)
 , m_organism(in_cell.m_organism)
 , m_hardware(in_cell.m_hardware)
 , m_inputs(in_cell.m_inputs)
@@ -69,6 +70,7 @@ void cPopulationCell::operator=(const cPopulationCell& in_cell)
 {
 	if (this != &in_cell) {
 		m_world = in_cell.m_world;
+		m_org_index = in_cell.m_org_index;
 		m_organism = in_cell.m_organism;
 		m_hardware = in_cell.m_hardware;
 		m_inputs = in_cell.m_inputs;
@@ -267,6 +269,7 @@ void cPopulationCell::InsertOrganism(cOrganism* new_org, cAvidaContext& ctx)
   // Adjust this cell's attributes to account for the new organism.
   m_organism = new_org;
   m_hardware = &new_org->GetHardware();
+  if (m_org_index) m_org_index->Add(cOrgSpatialIndex::ORGANISMS, m_cell_id);
   m_world->GetStats().AddSpeculativeWaste(m_spec_state);
   m_spec_state = 0;
 	
@@ -303,6 +306,7 @@ cOrganism * cPopulationCell::RemoveOrganism(cAvidaContext& ctx)
   }
   m_organism = NULL;
   m_hardware = NULL;
+  if (m_org_index) m_org_index->Remove(cOrgSpatialIndex::ORGANISMS, m_cell_id);
   return out_organism;
 }
 
@@ -330,6 +334,7 @@ double cPopulationCell::UptakeCellEnergy(double frac_to_uptake, cAvidaContext& c
 void cPopulationCell::AddPredAV(cAvidaContext& ctx, cOrganism* org)
 {
   m_av_pred.Push(org);
+  if (m_org_index) m_org_index->Add(cOrgSpatialIndex::PREDATOR_AVATARS, m_cell_id);
   // Swaps the added avatar into a random position in the array
   int loc = ctx.GetRandom().GetUInt(0, m_av_pred.GetSize());
   cOrganism* exist_org = m_av_pred[loc];
@@ -342,6 +347,7 @@ void cPopulationCell::AddPredAV(cAvidaContext& ctx, cOrganism* org)
 void cPopulationCell::AddPreyAV(cAvidaContext& ctx, cOrganism* org)
 {
   m_av_prey.Push(org);
+  if (m_org_index) m_org_index->Add(cOrgSpatialIndex::PREY_AVATARS, m_cell_id);
   // Swaps the added avatar into a random position in the array
   int loc = ctx.GetRandom().GetUInt(0, m_av_prey.GetSize());
   cOrganism* exist_org = m_av_prey[loc];
@@ -360,6 +366,7 @@ void cPopulationCell::RemovePredAV(cOrganism* org)
   exist_org->SetAVInIndex(org->GetAVInIndex());
   m_av_pred.Swap(org->GetAVInIndex(), last);
   m_av_pred.Pop();
+  if (m_org_index) m_org_index->Remove(cOrgSpatialIndex::PREDATOR_AVATARS, m_cell_id);
 }
 
 // Removes the organism from the cell's output avatars (prey)
@@ -372,6 +379,7 @@ void cPopulationCell::RemovePreyAV(cOrganism* org)
   exist_org->SetAVOutIndex(org->GetAVOutIndex());
   m_av_prey.Swap(org->GetAVOutIndex(), last);
   m_av_prey.Pop();
+  if (m_org_index) m_org_index->Remove(cOrgSpatialIndex::PREY_AVATARS, m_cell_id);
 }
 
 // Returns whether a cell has an output AV that the org will be able to receive messages from.
@@ -36,6 +36,7 @@
 class cHardwareBase;
 class cPopulation;
 class cOrganism;
+class cOrgSpatialIndex;
 class cPopulationCell;
 class cWorld;
 
@@ -48,6 +49,7 @@ class cPopulationCell
 
 private:
   cWorld* m_world;
+  cOrgSpatialIndex* m_org_index;            // Population index notified of the occupants of this cell, if any
 
   cOrganism* m_organism;                    // The occupent of this cell.
   cHardwareBase* m_hardware;
@@ -86,7 +88,7 @@ private:
 public:
   typedef std::set<cPopulationCell*> neighborhood_type; //!< Type for cell neighborhoods.
 
-  cPopulationCell() : m_world(NULL), m_organism(NULL), m_hardware(NULL), m_mut_rates(NULL), m_migrant(false), m_can_input(false), m_can_output(false), m_hgt(0) { ; }
+  cPopulationCell() : m_world(NULL), m_org_index(NULL), m_organism(NULL), m_hardware(NULL), m_mut_rates(NULL), m_migrant(false), m_can_input(false), m_can_output(false), m_hgt(0) { ; }
   cPopulationCell(const cPopulationCell& in_cell);
   ~cPopulationCell() { delete m_mut_rates; delete m_hgt; }
 
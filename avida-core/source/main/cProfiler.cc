@@ -0,0 +1,189 @@
+/*
+ *  cProfiler.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cProfiler.h"
+
+#include "apto/platform.h"
+#include "avida/output/File.h"
+
+#include "cStats.h"
+#include "cWorld.h"
+
+#include <cassert>
+
+#if APTO_PLATFORM(WINDOWS)
+# include <windows.h>
+#elif defined(__APPLE__)
+# include <mach/mach_time.h>
+#else
+# include <time.h>
+#endif
+
+
+static const char* s_phase_names[NUM_PROFILE_PHASES] = {
+  "events",
+  "pre_update",
+  "stats",
+  "instructions",
+  "post_update",
+  "output",
+  "data_manager"
+};
+
+
+cInstProfile::cInstProfile(const cInstSet& inst_set, int sample_rate)
+  : m_inst_set(inst_set), m_sample_rate(sample_rate), m_sample_countdown(sample_rate)
+{
+  const int num_inst = inst_set.GetSize();
+  m_count.Resize(num_inst);
+  m_cycles.Resize(num_inst);
+  m_sampled.Resize(num_inst);
+  m_sampled_time.Resize(num_inst);
+  clear();
+}
+
+void cInstProfile::clear()
+{
+  m_count.SetAll(0);
+  m_cycles.SetAll(0);
+  m_sampled.SetAll(0);
+  m_sampled_time.SetAll(0.0);
+}
+
+
+
+cProfiler::cProfiler(cWorld* world, int level, int sample_rate)
+  : m_world(world), m_level(level), m_sample_rate(sample_rate), m_update_start(0)
+{
+  if (m_level < PROFILE_OFF) m_level = PROFILE_OFF;
+  BeginUpdate();
+}
+
+cProfiler::~cProfiler()
+{
+  for (int i = 0; i < m_inst_profiles.GetSize(); i++) delete m_inst_profiles[i];
+}
+
+
+unsigned long long cProfiler::Now()
+{
+#if APTO_PLATFORM(WINDOWS)
+  static LARGE_INTEGER freq = { 0 };
+  if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+  LARGE_INTEGER count;
+  QueryPerformanceCounter(&count);
+  return (unsigned long long)((double)count.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#elif defined(__APPLE__)
+  static mach_timebase_info_data_t timebase = { 0, 0 };
+  if (timebase.denom == 0) mach_timebase_info(&timebase);
+  return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+
+const char* cProfiler::PhaseName(int phase)
+{
+  assert(phase >= 0 && phase < NUM_PROFILE_PHASES);
+  return s_phase_names[phase];
+}
+
+
+void cProfiler::BeginUpdate()
+{
+  for (int i = 0; i < NUM_PROFILE_PHASES; i++) {
+    m_phase_start[i] = 0;
+    m_phase_time[i] = 0.0;
+  }
+  if (m_level) m_update_start = Now();
+}
+
+
+void cProfiler::EndUpdate()
+{
+  if (!m_level) return;
+  
+  cStats::profiling_stats_t pf;
+  double accounted = 0.0;
+  for (int i = 0; i < NUM_PROFILE_PHASES; i++) {
+    pf[s_phase_names[i]] = m_phase_time[i];
+    accounted += m_phase_time[i];
+  }
+  const double total = (Now() - m_update_start) * 1.0e-9;
+  pf["update"] = total;
+  pf["other"] = (total > accounted) ? (total - accounted) : 0.0;
+  m_world->GetStats().ProfilingData(pf);
+  
+  BeginUpdate();
+}
+
+
+cInstProfile* cProfiler::GetInstProfile(const cInstSet& inst_set)
+{
+  if (m_level < PROFILE_INSTRUCTIONS) return NULL;
+  
+  for (int i = 0; i < m_inst_profiles.GetSize(); i++) {
+    if (&m_inst_profiles[i]->GetInstSet() == &inst_set) return m_inst_profiles[i];
+  }
+  
+  cInstProfile* profile = new cInstProfile(inst_set, m_sample_rate);
+  m_inst_profiles.Push(profile);
+  return profile;
+}
+
+
+void cProfiler::PrintInstructionProfile(const cString& filename)
+{
+  Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
+  
+  df->WriteComment("Instruction execution profile");
+  df->WriteComment("One row per instruction; values accumulate between successive prints");
+  df->WriteTimeStamp();
+  
+  const int update = m_world->GetStats().GetUpdate();
+  for (int p = 0; p < m_inst_profiles.GetSize(); p++) {
+    cInstProfile& profile = *m_inst_profiles[p];
+    const cInstSet& is = profile.GetInstSet();
+    
+    long long total_count = 0;
+    for (int i = 0; i < profile.m_count.GetSize(); i++) total_count += profile.m_count[i];
+    
+    for (int i = 0; i < profile.m_count.GetSize(); i++) {
+      const double mean_time = (profile.m_sampled[i]) ? profile.m_sampled_time[i] / profile.m_sampled[i] : 0.0;
+      
+      df->Write(update, "Update");
+      df->Write((const char*)is.GetInstSetName(), "Instruction Set");
+      df->Write(is.GetHardwareType(), "Hardware Type");
+      df->Write((const char*)is.GetName(i), "Instruction");
+      df->Write((double)profile.m_count[i], "Executions");
+      df->Write((total_count) ? (double)profile.m_count[i] / total_count : 0.0, "Fraction of Executions");
+      df->Write((double)profile.m_cycles[i], "CPU Cycles");
+      df->Write((double)profile.m_sampled[i], "Timed Samples");
+      df->Write(mean_time * 1.0e9, "Mean Sampled Time (ns)");
+      df->Write(mean_time * profile.m_count[i], "Estimated Total Time (s)");
+      df->Endl();
+    }
+    
+    profile.clear();
+  }
+}
@@ -0,0 +1,196 @@
+/*
+ *  cProfiler.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cProfiler_h
+#define cProfiler_h
+
+#include "apto/core.h"
+#include "avida/core/World.h"
+
+#include "cInstSet.h"
+#include "cString.h"
+
+class cWorld;
+
+
+// Profiling levels (PROFILE_LEVEL)
+enum eProfileLevel {
+  PROFILE_OFF = 0,
+  PROFILE_PHASES,         // Wall time of each phase of the update loop
+  PROFILE_INSTRUCTIONS    // Phases, plus per-instruction execution counts and cycle costs
+};
+
+// Phases of the update loop timed by the profiler
+enum eProfilePhase {
+  PROFILE_PHASE_EVENTS = 0,
+  PROFILE_PHASE_PRE_UPDATE,
+  PROFILE_PHASE_STATS,
+  PROFILE_PHASE_INSTRUCTIONS,
+  PROFILE_PHASE_POST_UPDATE,
+  PROFILE_PHASE_OUTPUT,
+  PROFILE_PHASE_DATA_MANAGER,
+  NUM_PROFILE_PHASES
+};
+
+
+// Per instruction set execution histogram.  Every execution is counted; when sampling is enabled, one in every
+// sample_rate executions of the instruction set is also timed.
+class cInstProfile
+{
+  friend class cProfiler;
+private:
+  const cInstSet& m_inst_set;
+  const int m_sample_rate;
+  int m_sample_countdown;
+  
+  Apto::Array<long long> m_count;
+  Apto::Array<long long> m_cycles;
+  Apto::Array<long long> m_sampled;
+  Apto::Array<double> m_sampled_time;
+  
+  cInstProfile(const cInstSet& inst_set, int sample_rate);
+  
+  void clear();
+  
+public:
+  inline unsigned long long Begin(const Instruction& inst);
+  inline void End(const Instruction& inst, unsigned long long start);
+  
+  const cInstSet& GetInstSet() const { return m_inst_set; }
+};
+
+
+// Times a single instruction execution, when the executing hardware has a profile attached
+class cInstProfileTimer
+{
+private:
+  cInstProfile* m_profile;
+  const Instruction m_inst;
+  unsigned long long m_start;
+  
+public:
+  inline cInstProfileTimer(cInstProfile* profile, const Instruction& inst)
+    : m_profile(profile), m_inst(inst), m_start(0) { if (m_profile) m_start = m_profile->Begin(m_inst); }
+  inline ~cInstProfileTimer() { if (m_start) m_profile->End(m_inst, m_start); }
+};
+
+
+class cProfiler
+{
+private:
+  cWorld* m_world;
+  int m_level;
+  int m_sample_rate;
+  
+  unsigned long long m_phase_start[NUM_PROFILE_PHASES];
+  double m_phase_time[NUM_PROFILE_PHASES];
+  unsigned long long m_update_start;
+  
+  Apto::Array<cInstProfile*> m_inst_profiles;
+  
+  
+  cProfiler(); // @not_implemented
+  cProfiler(const cProfiler&); // @not_implemented
+  cProfiler& operator=(const cProfiler&); // @not_implemented
+  
+public:
+  cProfiler(cWorld* world, int level, int sample_rate);
+  ~cProfiler();
+  
+  // Monotonic clock, in nanoseconds
+  static unsigned long long Now();
+  static const char* PhaseName(int phase);
+  
+  bool IsEnabled() const { return m_level > PROFILE_OFF; }
+  bool ProfilesInstructions() const { return m_level >= PROFILE_INSTRUCTIONS; }
+  
+  // Update loop phases; a phase may be started and stopped several times within an update
+  void BeginUpdate();
+  inline void BeginPhase(int phase) { if (m_level) m_phase_start[phase] = Now(); }
+  inline void EndPhase(int phase) { if (m_level) m_phase_time[phase] += (Now() - m_phase_start[phase]) * 1.0e-9; }
+  
+  // Hands the phase times for this update to cStats (see cStats::PrintProfilingData)
+  void EndUpdate();
+  
+  // Returns the histogram for the supplied instruction set, or NULL when instructions are not being profiled
+  cInstProfile* GetInstProfile(const cInstSet& inst_set);
+  
+  // Writes the instruction histograms accumulated since the last call, one row per instruction
+  void PrintInstructionProfile(const cString& filename);
+};
+
+
+inline unsigned long long cInstProfile::Begin(const Instruction& inst)
+{
+  const int op = inst.GetOp();
+  m_count[op]++;
+  m_cycles[op] += 1 + m_inst_set.GetAddlTimeCost(inst);
+  
+  if (m_sample_rate <= 0 || --m_sample_countdown > 0) return 0;
+  m_sample_countdown = m_sample_rate;
+  return cProfiler::Now();
+}
+
+inline void cInstProfile::End(const Instruction& inst, unsigned long long start)
+{
+  const int op = inst.GetOp();
+  m_sampled[op]++;
+  m_sampled_time[op] += (cProfiler::Now() - start) * 1.0e-9;
+}
+
+
+// Times the enclosing scope as part of the given phase
+class cProfilePhaseTimer
+{
+private:
+  cProfiler& m_profiler;
+  const int m_phase;
+  
+public:
+  inline cProfilePhaseTimer(cProfiler& profiler, int phase) : m_profiler(profiler), m_phase(phase)
+  {
+    m_profiler.BeginPhase(m_phase);
+  }
+  inline ~cProfilePhaseTimer() { m_profiler.EndPhase(m_phase); }
+};
+
+
+// Times the data manager's facet update, and only that, when passed to World::PerformUpdate
+class cProfileDataManagerTimer : public Avida::WorldUpdateObserver
+{
+private:
+  cProfiler& m_profiler;
+  Avida::WorldFacetPtr m_data_manager;
+  
+public:
+  inline cProfileDataManagerTimer(cProfiler& profiler, Avida::WorldFacetPtr data_manager)
+    : m_profiler(profiler), m_data_manager(data_manager) { ; }
+  
+  void FacetUpdateStarting(Avida::WorldFacetPtr facet)
+  {
+    if (facet == m_data_manager) m_profiler.BeginPhase(PROFILE_PHASE_DATA_MANAGER);
+  }
+  void FacetUpdateFinished(Avida::WorldFacetPtr facet)
+  {
+    if (facet == m_data_manager) m_profiler.EndPhase(PROFILE_PHASE_DATA_MANAGER);
+  }
+};
+
+#endif
@@ -25,20 +25,22 @@
 
 #include <climits>
 #include <cassert>
+#include "cBitArray.h"
 #include "cCellBox.h"
+#include "cReaction.h"
 
 #ifndef tList_h
 #include "tList.h"
 #endif
 
-class cReaction;
-
 
 class cReactionRequisite
 {
 private:
   tList<cReaction> prior_reaction_list;
   tList<cReaction> prior_noreaction_list;
+  cBitArray reaction_mask;     // Reaction IDs in prior_reaction_list, for word-at-a-time tests
+  cBitArray noreaction_mask;   // Reaction IDs in prior_noreaction_list
   int min_task_count;
   int max_task_count;
   int min_reaction_count;
@@ -53,6 +55,11 @@ private:
   cReactionRequisite(const cReactionRequisite&); // @not_implemented
   cReactionRequisite& operator=(const cReactionRequisite&);
 
+  static void addToMask(cBitArray& mask, int id) {
+    if (id >= mask.GetSize()) mask.Resize(id + 1);
+    mask.Set(id, true);
+  }
+
 public:
   cReactionRequisite() : min_task_count(0) , max_task_count(INT_MAX),
     min_reaction_count(0) , max_reaction_count(INT_MAX),
@@ -61,6 +68,8 @@ public:
 
   const tList<cReaction>& GetReactions() const { return prior_reaction_list; }
   const tList<cReaction>& GetNoReactions() const { return prior_noreaction_list; }
+  const cBitArray& GetReactionMask() const { return reaction_mask; }
+  const cBitArray& GetNoReactionMask() const { return noreaction_mask; }
   int GetMinTaskCount() const { return min_task_count; }
   int GetMaxTaskCount() const { return max_task_count; }
   int GetMinReactionCount() const { return min_reaction_count; }
@@ -73,9 +82,11 @@ public:
 
   void AddReaction(cReaction* in_reaction) {
     prior_reaction_list.PushRear(in_reaction);
+    addToMask(reaction_mask, in_reaction->GetID());
   }
   void AddNoReaction(cReaction* in_reaction) {
     prior_noreaction_list.PushRear(in_reaction);
+    addToMask(noreaction_mask, in_reaction->GetID());
   }
   void SetMinTaskCount(int min) { min_task_count = min; }
   void SetMaxTaskCount(int max) { max_task_count = max; }
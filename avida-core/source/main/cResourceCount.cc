@@ -166,6 +166,9 @@ void cResourceCount::SetSize(int num_resources)
   curr_grid_res_cnt.ResizeClear(num_resources);
   curr_spatial_res_cnt.ResizeClear(num_resources);
   cell_lists.ResizeClear(num_resources);
+  m_occupancy_sat.ResizeClear(num_resources);
+  m_occupancy_valid.ResizeClear(num_resources);
+  m_occupancy_valid.SetAll(false);
   resource_name.SetAll("");
   resource_initial.SetAll(0.0);
   resource_count.SetAll(0.0);
@@ -193,6 +196,7 @@ void cResourceCount::SetCellResources(int cell_id, const Apto::Array<double> & r
      if (!IsSpatialResource(i)) {
         // Set global quantity of resource
     } else {
+      if (res[i] > 0) m_occupancy_valid[i] = false;
       spatial_resource_count[i]->SetCellAmount(cell_id, res[i]);
 
       /* Ideally the state of the cell's resource should not be set till
@@ -354,6 +358,7 @@ void cResourceCount::Setup(cWorld* world, const int& res_index, const cString& n
   spatial_resource_count[res_index]->SetOutflowX2(in_outflowX2);
   spatial_resource_count[res_index]->SetOutflowY1(in_outflowY1);
   spatial_resource_count[res_index]->SetOutflowY2(in_outflowY2);
+  m_occupancy_valid[res_index] = false;
 }
 
 void cResourceCount::SetGradientCount(cAvidaContext& ctx, cWorld* world, const int& res_id, const int& peakx, const int& peaky,
@@ -414,6 +419,7 @@ void cResourceCount::SetGradientCount(cAvidaContext& ctx, cWorld* world, const i
   spatial_resource_count[res_id]->SetGradDeathOdds(death_odds);
   
   spatial_resource_count[res_id]->ResetGradRes(ctx, worldx, worldy);
+  m_occupancy_valid[res_id] = false;
 }
 
 void cResourceCount::SetGradientPlatInflow(const int& res_id, const double& inflow) 
@@ -471,6 +477,7 @@ void cResourceCount::SetProbabilisticResource(cAvidaContext& ctx, const int& res
   assert(res_id >= 0 && res_id < resource_count.GetSize());
   assert(spatial_resource_count[res_id]->GetSize() > 0);
   spatial_resource_count[res_id]->SetProbabilisticResource(ctx, initial, inflow, outflow, lambda, theta, x, y, count);
+  m_occupancy_valid[res_id] = false;
 }
 
 /*
@@ -668,6 +675,7 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
       spatial_resource_count[i]->State(cell_id);
       if(spatial_resource_count[i]->Element(cell_id).GetAmount() != temp){
         spatial_resource_count[i]->SetModified(true);
+        if (temp <= 0) m_occupancy_valid[i] = false;
       }
       assert(spatial_resource_count[i]->Element(cell_id).GetAmount() >= 0.0);
     }
@@ -694,6 +702,7 @@ void cResourceCount::Set(cAvidaContext& ctx, int res_id, double new_level)
     for(int i = 0; i < spatial_resource_count[res_id]->GetSize(); i++) {
       spatial_resource_count[res_id]->SetCellAmount(i, new_level/spatial_resource_count[res_id]->GetSize());
     }
+    m_occupancy_valid[res_id] = false;
   }
 }
 
@@ -703,6 +712,7 @@ void cResourceCount::ResizeSpatialGrids(int in_x, int in_y)
     spatial_resource_count[i]->ResizeClear(in_x, in_y, geometry[i]);
     curr_spatial_res_cnt[i].Resize(in_x * in_y);
   }
+  invalidateOccupancy();
 }
 
 int cResourceCount::GetCurrPeakX(cAvidaContext& ctx, int res_id) const
@@ -747,6 +757,48 @@ int cResourceCount::GetMaxUsedX(int res_id)
   return spatial_resource_count[res_id]->GetMaxUsedX();
 }
 
+bool cResourceCount::HasResourceInArea(int res_id, int min_x, int min_y, int max_x, int max_y) const
+{
+  if (!IsSpatialResource(res_id)) return resource_count[res_id] > 0;
+
+  const cSpatialResCount* sp_res = spatial_resource_count[res_id];
+  if (min_x < 0) min_x = 0;
+  if (min_y < 0) min_y = 0;
+  if (max_x > sp_res->GetX() - 1) max_x = sp_res->GetX() - 1;
+  if (max_y > sp_res->GetY() - 1) max_y = sp_res->GetY() - 1;
+  if (min_x > max_x || min_y > max_y) return false;
+
+  if (!m_occupancy_valid[res_id]) buildOccupancyTable(res_id);
+
+  const Apto::Array<int>& sat = m_occupancy_sat[res_id];
+  const int stride = sp_res->GetX() + 1;
+  const int occupied = sat[(max_y + 1) * stride + max_x + 1] - sat[min_y * stride + max_x + 1]
+                     - sat[(max_y + 1) * stride + min_x] + sat[min_y * stride + min_x];
+  return occupied > 0;
+}
+
+void cResourceCount::buildOccupancyTable(int res_id) const
+{
+  // sat[(y + 1) * stride + (x + 1)] holds the number of occupied cells in the rectangle (0, 0) - (x, y)
+  const cSpatialResCount* sp_res = spatial_resource_count[res_id];
+  const int worldx = sp_res->GetX();
+  const int worldy = sp_res->GetY();
+  const int stride = worldx + 1;
+
+  Apto::Array<int>& sat = m_occupancy_sat[res_id];
+  sat.ResizeClear(stride * (worldy + 1));
+  for (int x = 0; x < stride; x++) sat[x] = 0;
+  for (int y = 0; y < worldy; y++) {
+    int row_count = 0;
+    sat[(y + 1) * stride] = 0;
+    for (int x = 0; x < worldx; x++) {
+      if (sp_res->GetAmount(y * worldx + x) > 0) row_count++;
+      sat[(y + 1) * stride + x + 1] = sat[y * stride + x + 1] + row_count;
+    }
+  }
+  m_occupancy_valid[res_id] = true;
+}
+
 int cResourceCount::GetMaxUsedY(int res_id)
 {
   return spatial_resource_count[res_id]->GetMaxUsedY();
@@ -829,6 +881,7 @@ void cResourceCount::DoNonSpatialUpdates(cAvidaContext& ctx, const int res_id, i
 
 void cResourceCount::DoSpatialUpdates(cAvidaContext& ctx, const int res_id, int num_updates) const
 {
+  if (num_updates > 0) m_occupancy_valid[res_id] = false;
   for (int kk=0; kk < num_updates; kk++){
     spatial_resource_count[res_id]->UpdateCount(ctx);  //Only for Gradient Resources
     spatial_resource_count[res_id]->Source(inflow_rate[res_id]);  
@@ -856,6 +909,7 @@ void cResourceCount::ReinitializeResources(cAvidaContext& ctx, double additional
       spatial_resource_count[i]->RateAll(additional_resource);
       spatial_resource_count[i]->StateAll();
     }
+    m_occupancy_valid[i] = false;
 
   } //End going through the resources
 }
@@ -75,6 +75,11 @@ private:
   int verbosity;
   Apto::Array< Apto::Array<int> > cell_lists;
 
+  // Summed-area tables counting the cells of each spatial resource that hold any of it, built on demand.  Cells that
+  // are emptied leave a table valid (it only overcounts); the table is discarded whenever a cell may gain resource.
+  mutable Apto::Array< Apto::Array<int> > m_occupancy_sat;
+  mutable Apto::Array<bool> m_occupancy_valid;
+
   // Setup the update process to use lazy evaluation...
   mutable double update_time;     // Portion of an update compleated...
   mutable double spatial_update_time;
@@ -86,6 +91,9 @@ private:
   void DoNonSpatialUpdates(cAvidaContext& ctx, const int res_id, int num_steps) const;
   void DoSpatialUpdates(cAvidaContext& ctx, const int res_id, int num_updates) const;
 
+  void buildOccupancyTable(int res_id) const;
+  void invalidateOccupancy() const { m_occupancy_valid.SetAll(false); }
+
   // A few constants to describe update process...
   static const double UPDATE_STEP;   // Fraction of an update per step
   static const double EPSILON;       // Tolorance for round off errors
@@ -192,6 +200,9 @@ public:
   int GetMinUsedY(int res_id);
   int GetMaxUsedX(int res_id);
   int GetMaxUsedY(int res_id);
+
+  // Returns false only if no cell within the (inclusive) rectangle holds any of the resource
+  bool HasResourceInArea(int res_id, int min_x, int min_y, int max_x, int max_y) const;
   
   void SetSpatialUpdate(int update) { m_spatial_update = update; }
   void UpdateGlobalResources(cAvidaContext& ctx) { DoUpdates(ctx, true); }
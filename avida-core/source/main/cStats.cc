@@ -29,6 +29,7 @@
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
 
+#include "cCheckpoint.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
@@ -55,6 +56,8 @@
 using namespace Avida;
 using namespace AvidaTools;
 
+static const PropertyKey s_prop_id_genome("genome");
+
 
 cStats::cStats(cWorld* world)
 : m_world(world)
@@ -132,6 +135,12 @@ cStats::cStats(cWorld* world)
   tasks_host_last.Resize(num_tasks);
   tasks_parasite_current.Resize(num_tasks);
   tasks_parasite_last.Resize(num_tasks);
+  tasks_host_current.SetAll(0);
+  tasks_host_last.SetAll(0);
+  tasks_parasite_current.SetAll(0);
+  tasks_parasite_last.SetAll(0);
+  m_task_touched.Resize(num_tasks);
+  m_task_touched.SetAll(false);
   
   task_cur_quality.Resize(num_tasks);
   task_last_quality.Resize(num_tasks);
@@ -186,6 +195,8 @@ cStats::cStats(cWorld* world)
   m_reaction_cur_add_reward.SetAll(0.0);
   m_reaction_last_add_reward.SetAll(0.0);
   m_reaction_exe_count.SetAll(0);
+  m_reaction_touched.Resize(num_reactions);
+  m_reaction_touched.SetAll(false);
   
   
   resource_count.Resize( m_world->GetNumResources() );
@@ -466,37 +477,56 @@ void cStats::NotifyData(Update current_update, Data::DataRetrievalFunctor retrie
   m_threshold_genotypes = retrieve_data("systematics.genotype.current_threshold")->IntValue();
 }
 
+bool cStats::SupportsConcurrentNotify() const
+{
+  // NotifyData only records into its own genotype counters
+  return true;
+}
+
 
 
 void cStats::ZeroTasks()
 {
-  task_cur_count.SetAll(0);
-  task_last_count.SetAll(0);
-  task_test_count.SetAll(0);
-  
-  tasks_host_current.SetAll(0);
-  tasks_host_last.SetAll(0);
-  tasks_parasite_current.SetAll(0);
-  tasks_parasite_last.SetAll(0);
-  
-  task_cur_quality.SetAll(0);
-  task_last_quality.SetAll(0);
-  task_last_max_quality.SetAll(0);
-  task_cur_max_quality.SetAll(0);
-  task_internal_cur_count.SetAll(0);
-  task_internal_cur_quality.SetAll(0);
-  task_internal_cur_max_quality.SetAll(0);
-  task_internal_last_count.SetAll(0);
-  task_internal_last_quality.SetAll(0);
-  task_internal_last_max_quality.SetAll(0);
+  // Only entries written since the last call can be nonzero
+  for (int i = 0; i < m_touched_task_ids.GetSize(); i++) {
+    const int j = m_touched_task_ids[i];
+    task_cur_count[j] = 0;
+    task_last_count[j] = 0;
+    task_test_count[j] = 0;
+    
+    tasks_host_current[j] = 0;
+    tasks_host_last[j] = 0;
+    tasks_parasite_current[j] = 0;
+    tasks_parasite_last[j] = 0;
+    
+    task_cur_quality[j] = 0;
+    task_last_quality[j] = 0;
+    task_last_max_quality[j] = 0;
+    task_cur_max_quality[j] = 0;
+    task_internal_cur_count[j] = 0;
+    task_internal_cur_quality[j] = 0;
+    task_internal_cur_max_quality[j] = 0;
+    task_internal_last_count[j] = 0;
+    task_internal_last_quality[j] = 0;
+    task_internal_last_max_quality[j] = 0;
+    
+    m_task_touched[j] = false;
+  }
+  m_touched_task_ids.Resize(0);
 }
 
 void cStats::ZeroReactions()
 {
-  m_reaction_cur_count.SetAll(0);
-  m_reaction_last_count.SetAll(0);
-  m_reaction_cur_add_reward.SetAll(0);
-  m_reaction_last_add_reward.SetAll(0);
+  for (int i = 0; i < m_touched_reaction_ids.GetSize(); i++) {
+    const int j = m_touched_reaction_ids[i];
+    m_reaction_cur_count[j] = 0;
+    m_reaction_last_count[j] = 0;
+    m_reaction_cur_add_reward[j] = 0;
+    m_reaction_last_add_reward[j] = 0;
+    
+    m_reaction_touched[j] = false;
+  }
+  m_touched_reaction_ids.Resize(0);
 }
 
 void cStats::ZeroMessageInst()
@@ -567,6 +597,106 @@ void cStats::RecordBirth(bool breed_true)
   else num_breed_in++;
 }
 
+void cStats::SaveState(cCheckpointWriter& ckp) const
+{
+  ckp.WriteInt(m_update);
+  ckp.WriteInt(last_update);
+  ckp.WriteDouble(avida_time);
+  rave_true_replication_rate.SaveState(ckp);
+  ckp.WriteDouble(max_viable_fitness);
+  
+  ckp.WriteInt(num_births);
+  ckp.WriteInt(cumulative_births);
+  ckp.WriteInt(num_deaths);
+  ckp.WriteInt(num_breed_in);
+  ckp.WriteInt(num_breed_true);
+  ckp.WriteInt(num_breed_true_creatures);
+  ckp.WriteInt(num_executed);
+  ckp.WriteInt(tot_organisms);
+  ckp.WriteInt(tot_executed);
+  
+  ckp.WriteIntArray(new_task_count);
+  ckp.WriteIntArray(prev_task_count);
+  ckp.WriteIntArray(cur_task_count);
+  ckp.WriteIntArray(new_reaction_count);
+  
+  ckp.WriteInt(num_kabooms);
+  ckp.WriteInt(num_kabooms_pre);
+  ckp.WriteInt(num_kabooms_post);
+  ckp.WriteInt(num_kaboom_kills);
+  ckp.WriteInt(num_sa_kin);
+  ckp.WriteInt(num_sa_notkin);
+  ckp.WriteInt(num_nsa_kin);
+  ckp.WriteInt(num_nsa_notkin);
+  ckp.WriteDouble(sum_perc_lyse);
+  ckp.WriteDouble(sum_cpu_cycles);
+  ckp.WriteIntArray(hd_list);
+  ckp.WriteInt(num_stop_explode);
+  ckp.WriteInt(ave_threshold_ub);
+  ckp.WriteInt(num_quorum);
+  ckp.WriteInt(juv_killed);
+  ckp.WriteInt(num_guard_fail);
+  
+  ckp.WriteInt(num_resamplings);
+  ckp.WriteInt(num_failedResamplings);
+  ckp.WriteInt(num_orgs_replicated);
+  ckp.WriteInt(num_migrations);
+  ckp.WriteInt(m_spec_total);
+  ckp.WriteInt(m_spec_num);
+  ckp.WriteInt(m_spec_waste);
+}
+
+bool cStats::LoadState(cCheckpointReader& ckp)
+{
+  m_update = ckp.ReadInt();
+  last_update = ckp.ReadInt();
+  avida_time = ckp.ReadDouble();
+  if (!rave_true_replication_rate.LoadState(ckp)) return false;
+  max_viable_fitness = ckp.ReadDouble();
+  
+  num_births = ckp.ReadInt();
+  cumulative_births = ckp.ReadInt();
+  num_deaths = ckp.ReadInt();
+  num_breed_in = ckp.ReadInt();
+  num_breed_true = ckp.ReadInt();
+  num_breed_true_creatures = ckp.ReadInt();
+  num_executed = ckp.ReadInt();
+  tot_organisms = ckp.ReadInt();
+  tot_executed = ckp.ReadInt();
+  
+  ckp.ReadIntArray(new_task_count);
+  ckp.ReadIntArray(prev_task_count);
+  ckp.ReadIntArray(cur_task_count);
+  ckp.ReadIntArray(new_reaction_count);
+  
+  num_kabooms = ckp.ReadInt();
+  num_kabooms_pre = ckp.ReadInt();
+  num_kabooms_post = ckp.ReadInt();
+  num_kaboom_kills = ckp.ReadInt();
+  num_sa_kin = ckp.ReadInt();
+  num_sa_notkin = ckp.ReadInt();
+  num_nsa_kin = ckp.ReadInt();
+  num_nsa_notkin = ckp.ReadInt();
+  sum_perc_lyse = ckp.ReadDouble();
+  sum_cpu_cycles = ckp.ReadDouble();
+  ckp.ReadIntArray(hd_list);
+  num_stop_explode = ckp.ReadInt();
+  ave_threshold_ub = ckp.ReadInt();
+  num_quorum = ckp.ReadInt();
+  juv_killed = ckp.ReadInt();
+  num_guard_fail = ckp.ReadInt();
+  
+  num_resamplings = ckp.ReadInt();
+  num_failedResamplings = ckp.ReadInt();
+  num_orgs_replicated = ckp.ReadInt();
+  num_migrations = ckp.ReadInt();
+  m_spec_total = ckp.ReadInt();
+  m_spec_num = ckp.ReadInt();
+  m_spec_waste = ckp.ReadInt();
+  
+  return ckp.Good();
+}
+
 void cStats::ProcessUpdate()
 {
   // Increment the "avida_time"
@@ -589,30 +719,37 @@ void cStats::ProcessUpdate()
   tot_executed += num_executed;
   num_executed = 0;
   
-  task_cur_count.SetAll(0);
-  task_last_count.SetAll(0);
-  task_test_count.SetAll(0);
-  task_cur_quality.SetAll(0);
-  task_last_quality.SetAll(0);
-  task_cur_max_quality.SetAll(0);
-  task_last_max_quality.SetAll(0);
-  task_exe_count.SetAll(0);
-  
-  task_internal_cur_count.SetAll(0);
-  task_internal_last_count.SetAll(0);
-  task_internal_cur_quality.SetAll(0);
-  task_internal_last_quality.SetAll(0);
-  task_internal_cur_max_quality.SetAll(0);
-  task_internal_last_max_quality.SetAll(0);
+  // The touched entry lists are kept, ZeroTasks and ZeroReactions clear the remaining arrays at the next stats pass
+  for (int i = 0; i < m_touched_task_ids.GetSize(); i++) {
+    const int j = m_touched_task_ids[i];
+    task_cur_count[j] = 0;
+    task_last_count[j] = 0;
+    task_test_count[j] = 0;
+    task_cur_quality[j] = 0;
+    task_last_quality[j] = 0;
+    task_cur_max_quality[j] = 0;
+    task_last_max_quality[j] = 0;
+    task_exe_count[j] = 0;
+    
+    task_internal_cur_count[j] = 0;
+    task_internal_last_count[j] = 0;
+    task_internal_cur_quality[j] = 0;
+    task_internal_last_quality[j] = 0;
+    task_internal_cur_max_quality[j] = 0;
+    task_internal_last_max_quality[j] = 0;
+  }
   
   sense_last_count.SetAll(0);
   sense_last_exe_count.SetAll(0);
   
-  m_reaction_cur_count.SetAll(0);
-  m_reaction_last_count.SetAll(0);
-  m_reaction_cur_add_reward.SetAll(0.0);
-  m_reaction_last_add_reward.SetAll(0.0);
-  m_reaction_exe_count.SetAll(0);
+  for (int i = 0; i < m_touched_reaction_ids.GetSize(); i++) {
+    const int j = m_touched_reaction_ids[i];
+    m_reaction_cur_count[j] = 0;
+    m_reaction_last_count[j] = 0;
+    m_reaction_cur_add_reward[j] = 0.0;
+    m_reaction_last_add_reward[j] = 0.0;
+    m_reaction_exe_count[j] = 0;
+  }
   
   max_fitness = 0.0;
   
@@ -5095,7 +5232,7 @@ void cStats::UpdateTopNavTrace(cOrganism* org, bool force_update)
     topid = org->GetID();
     topbirthud = org->GetPhenotype().GetUpdateBorn();
     toprepro = org->GetPhenotype().GetNumExecs();
-    topgenome = Genome(org->SystematicsGroup("genotype")->Properties().Get("genome"));
+    topgenome = Genome(org->SystematicsGroup("genotype")->Properties().Get(s_prop_id_genome));
     
     Apto::Array<char, Apto::Smart> trace = org->GetHardware().GetMicroTrace();
     Apto::Array<int, Apto::Smart> traceloc = org->GetHardware().GetNavTraceLoc();
@@ -51,6 +51,8 @@
 #include <set>
 #include <utility>
 
+class cCheckpointReader;
+class cCheckpointWriter;
 class cWorld;
 class cOrganism;
 class cOrgMessage;
@@ -266,6 +268,12 @@ private:
   Apto::Array<double> m_reaction_cur_add_reward;
   Apto::Array<double> m_reaction_last_add_reward;
   Apto::Array<int> m_reaction_exe_count;
+  
+  // Task and reaction entries written since the last ZeroTasks / ZeroReactions, so only those need zeroing
+  Apto::Array<int> m_touched_task_ids;
+  Apto::Array<bool> m_task_touched;
+  Apto::Array<int> m_touched_reaction_ids;
+  Apto::Array<bool> m_reaction_touched;
 
   Apto::Array<double> resource_count;
   Apto::Array<int> resource_geometry;
@@ -413,6 +421,15 @@ private:
   int toprepro;
   bool firstnavtrace;
   Genome topgenome;
+  
+  inline void touchTask(int task_num)
+  {
+    if (!m_task_touched[task_num]) { m_task_touched[task_num] = true; m_touched_task_ids.Push(task_num); }
+  }
+  inline void touchReaction(int reaction)
+  {
+    if (!m_reaction_touched[reaction]) { m_reaction_touched[reaction] = true; m_touched_reaction_ids.Push(reaction); }
+  }
     
 public:
   cStats(cWorld* world);
@@ -435,10 +452,18 @@ public:
   // Data::Recorder
   Data::ConstDataSetPtr RequestedData() const;
   void NotifyData(Update current_update, Data::DataRetrievalFunctor retrieve_data);
+  bool SupportsConcurrentNotify() const;
   
   // cStats
   void ProcessUpdate();
 
+  // Checkpointing - the counters and running values carried from one update to the next.  The per-update sums are
+  // rebuilt by the population each update and are not saved.  Neither are the accumulators that belong to particular
+  // print actions and are cleared when printed (instruction execution maps, deme, flow rate, mating and navigation
+  // trace stats); they restart from zero in a resumed run.
+  void SaveState(cCheckpointWriter& ckp) const;
+  bool LoadState(cCheckpointReader& ckp);
+
   inline void SetCurrentUpdate(int new_update) { m_update = new_update; }
   inline void IncCurrentUpdate() { m_update++; }
 
@@ -656,24 +681,26 @@ public:
   void AddNumCellsScannedAtKill(long num) { sum_cells_scanned_at_kill.Add(num); }
   void IncNumMigrations() { num_migrations++; }
 
-  void AddCurTask(int task_num) { task_cur_count[task_num]++; }
-  void AddCurHostTask(int task_num) { tasks_host_current[task_num]++; }
-  void AddCurParasiteTask(int task_num) { tasks_parasite_current[task_num]++; }
+  void AddCurTask(int task_num) { touchTask(task_num); task_cur_count[task_num]++; }
+  void AddCurHostTask(int task_num) { touchTask(task_num); tasks_host_current[task_num]++; }
+  void AddCurParasiteTask(int task_num) { touchTask(task_num); tasks_parasite_current[task_num]++; }
 
   void AddCurTaskQuality(int task_num, double quality)
   {
+	  touchTask(task_num);
 	  task_cur_quality[task_num] += quality;
 	  if (quality > task_cur_max_quality[task_num]) task_cur_max_quality[task_num] = quality;
   }
-  void AddLastTask(int task_num) { task_last_count[task_num]++; }
-  void AddTestTask(int task_num) { task_test_count[task_num]++; }
-  void AddLastHostTask(int task_num) { tasks_host_last[task_num]++; }
-  void AddLastParasiteTask(int task_num) { tasks_parasite_last[task_num]++; }
+  void AddLastTask(int task_num) { touchTask(task_num); task_last_count[task_num]++; }
+  void AddTestTask(int task_num) { touchTask(task_num); task_test_count[task_num]++; }
+  void AddLastHostTask(int task_num) { touchTask(task_num); tasks_host_last[task_num]++; }
+  void AddLastParasiteTask(int task_num) { touchTask(task_num); tasks_parasite_last[task_num]++; }
   
   bool ShouldCollectEnvTestStats() const { return m_collect_env_test_stats; }
 
   void AddLastTaskQuality(int task_num, double quality)
   {
+	  touchTask(task_num);
 	  task_last_quality[task_num] += quality;
 	  if (quality > task_last_max_quality[task_num]) task_last_max_quality[task_num] = quality;
   }
@@ -683,31 +710,33 @@ public:
 	  cur_task_count[task_num] += cur_tasks;
   }
   void AddNewReactionCount(int reaction_num) {new_reaction_count[reaction_num]++; }
-  void IncTaskExeCount(int task_num, int task_count) { task_exe_count[task_num] += task_count; }
+  void IncTaskExeCount(int task_num, int task_count) { touchTask(task_num); task_exe_count[task_num] += task_count; }
   void ZeroTasks();
 
   void AddLastSense(int) { /*sense_last_count[res_comb_index]++;*/ }
   void IncLastSenseExeCount(int, int) { /*sense_last_exe_count[res_comb_index]+= count;*/ }
 
   // internal resource bins and use of internal resources
-  void AddCurInternalTask(int task_num) { task_internal_cur_count[task_num]++; }
+  void AddCurInternalTask(int task_num) { touchTask(task_num); task_internal_cur_count[task_num]++; }
   void AddCurInternalTaskQuality(int task_num, double quality)
   {
+  	touchTask(task_num);
   	task_internal_cur_quality[task_num] += quality;
   	if(quality > task_internal_cur_max_quality[task_num])	task_internal_cur_max_quality[task_num] = quality;
   }
-  void AddLastInternalTask(int task_num) { task_internal_last_count[task_num]++; }
+  void AddLastInternalTask(int task_num) { touchTask(task_num); task_internal_last_count[task_num]++; }
   void AddLastInternalTaskQuality(int task_num, double quality)
   {
+  	touchTask(task_num);
   	task_internal_last_quality[task_num] += quality;
   	if(quality > task_internal_last_max_quality[task_num]) task_internal_last_max_quality[task_num] = quality;
   }
 
-  void AddCurReaction(int reaction) { m_reaction_cur_count[reaction]++; }
-  void AddLastReaction(int reaction) { m_reaction_last_count[reaction]++; }
-  void AddCurReactionAddReward(int reaction, double reward) { m_reaction_cur_add_reward[reaction] += reward; }
-  void AddLastReactionAddReward(int reaction, double reward) { m_reaction_last_add_reward[reaction] += reward; }
-  void IncReactionExeCount(int reaction, int count) { m_reaction_exe_count[reaction] += count; }
+  void AddCurReaction(int reaction) { touchReaction(reaction); m_reaction_cur_count[reaction]++; }
+  void AddLastReaction(int reaction) { touchReaction(reaction); m_reaction_last_count[reaction]++; }
+  void AddCurReactionAddReward(int reaction, double reward) { touchReaction(reaction); m_reaction_cur_add_reward[reaction] += reward; }
+  void AddLastReactionAddReward(int reaction, double reward) { touchReaction(reaction); m_reaction_last_add_reward[reaction] += reward; }
+  void IncReactionExeCount(int reaction, int count) { touchReaction(reaction); m_reaction_exe_count[reaction] += count; }
   void ZeroReactions();
 
   void SetResources(const Apto::Array<double> &_in) { resource_count = _in; }
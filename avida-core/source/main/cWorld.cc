@@ -40,6 +40,7 @@
 #include "cMigrationMatrix.h"  
 #include "cInstSet.h"
 #include "cPopulation.h"
+#include "cProfiler.h"
 #include "cStats.h"
 #include "cTestCPU.h"
 #include "cUserFeedback.h"
@@ -51,7 +52,7 @@ using namespace AvidaTools;
 
 cWorld::cWorld(cAvidaConfig* cfg, const cString& wd)
   : m_working_dir(wd), m_analyze(NULL), m_conf(cfg), m_ctx(NULL)
-  , m_env(NULL), m_event_list(NULL), m_hw_mgr(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_driver(NULL), m_data_mgr(NULL)
+  , m_env(NULL), m_event_list(NULL), m_hw_mgr(NULL), m_pop(NULL), m_stats(NULL), m_mig_mat(NULL), m_profiler(NULL), m_driver(NULL), m_data_mgr(NULL)
   , m_own_driver(false)
 {
 }
@@ -81,6 +82,7 @@ cWorld::~cWorld()
   delete m_hw_mgr; m_hw_mgr = NULL;
 
   delete m_mig_mat; 
+  delete m_profiler; m_profiler = NULL;
   
   // Delete Last
   delete m_conf; m_conf = NULL;
@@ -106,7 +108,7 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   // Initialize new API-based data structures here for now
   {
     // Data Manager
-    m_data_mgr = Data::ManagerPtr(new Data::Manager);
+    m_data_mgr = Data::ManagerPtr(new Data::Manager(m_conf->DATA_UPDATE_THREADS.Get()));
     m_data_mgr->AttachTo(new_world);
     
     // Environment
@@ -114,7 +116,7 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
     
     // Output Manager
     Apto::String opath = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->DATA_DIR.Get()), Apto::String(m_working_dir));
-    Output::ManagerPtr(new Output::Manager(opath))->AttachTo(new_world);
+    Output::ManagerPtr(new Output::Manager(opath, m_conf->OUTPUT_BUFFER_SIZE.Get() * 1024))->AttachTo(new_world);
   }
   
 
@@ -145,12 +147,21 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   // Systematics
   Systematics::ManagerPtr systematics(new Systematics::Manager);
   systematics->AttachTo(new_world);
-  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get())));
+  Apto::String historic_store;
+  if (m_conf->HISTORIC_GENOTYPE_STORE.Get().GetSize()) {
+    Apto::String data_dir = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->DATA_DIR.Get()), Apto::String(m_working_dir));
+    Apto::FileSystem::MkDir(data_dir);
+    historic_store = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->HISTORIC_GENOTYPE_STORE.Get()), data_dir);
+  }
+  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get(),
+                                                                                        m_conf->HISTORIC_GENOTYPE_MEMORY.Get(), historic_store)));
 
   
   // Setup Stats Object
   m_stats = Apto::SmartPtr<cStats, Apto::InternalRCObject>(new cStats(this));
   Data::Manager::Of(m_new_world)->AttachRecorder(m_stats);
+  
+  m_profiler = new cProfiler(this, m_conf->PROFILE_LEVEL.Get(), m_conf->PROFILE_SAMPLE_RATE.Get());
 
   
   // Initialize the hardware manager, loading all of the instruction sets
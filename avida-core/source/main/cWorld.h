@@ -42,6 +42,7 @@ class cOrganism;
 class cPopulation;
 class cMerit;
 class cPopulationCell;
+class cProfiler;
 class cStats;
 class cTestCPU;
 class cUserFeedback;
@@ -65,6 +66,7 @@ protected:
   Apto::SmartPtr<cPopulation, Apto::InternalRCObject> m_pop;
   Apto::SmartPtr<cStats, Apto::InternalRCObject> m_stats;
   cMigrationMatrix* m_mig_mat;  
+  cProfiler* m_profiler;
   WorldDriver* m_driver;
   
   Data::ManagerPtr m_data_mgr;
@@ -95,6 +97,7 @@ public:
   cHardwareManager& GetHardwareManager() { return *m_hw_mgr; }
   cMigrationMatrix& GetMigrationMatrix(){ return *m_mig_mat; };
   cPopulation& GetPopulation() { return *m_pop; }
+  cProfiler& GetProfiler() { return *m_profiler; }
   Apto::Random& GetRandom() { return m_rng; }
   cStats& GetStats() { return *m_stats; }
   WorldDriver& GetDriver() { return *m_driver; }
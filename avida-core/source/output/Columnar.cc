@@ -0,0 +1,765 @@
+/*
+ *  output/Columnar.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/Columnar.h"
+
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+
+static const char COLUMNAR_MAGIC[8] = { 'A', 'V', 'D', 'C', 'O', 'L', '0', '1' };
+
+static const unsigned int COLUMNAR_RECORD_HEAD = 0x44414548; // "HEAD"
+static const unsigned int COLUMNAR_RECORD_BLOCK = 0x4B434C42; // "BLCK"
+static const unsigned int COLUMNAR_RECORD_INDEX = 0x58444E49; // "INDX"
+static const unsigned int COLUMNAR_RECORD_TAIL = 0x4C494154; // "TAIL"
+
+static const int COLUMNAR_RECORD_PREFIX = 8;  // tag + payload length
+static const int COLUMNAR_TAIL_SIZE = COLUMNAR_RECORD_PREFIX + 8;
+
+
+// Encoding Helpers
+// --------------------------------------------------------------------------------------------------------------
+//
+// All multi-byte values are stored little endian, independent of the host.
+
+static void putU32(std::vector<unsigned char>& buf, unsigned int value)
+{
+  for (int i = 0; i < 4; i++) buf.push_back((unsigned char)(value >> (8 * i)));
+}
+
+static void putU64(std::vector<unsigned char>& buf, unsigned long long value)
+{
+  for (int i = 0; i < 8; i++) buf.push_back((unsigned char)(value >> (8 * i)));
+}
+
+static void putVarint(std::vector<unsigned char>& buf, unsigned long long value)
+{
+  while (value >= 0x80) {
+    buf.push_back((unsigned char)(value | 0x80));
+    value >>= 7;
+  }
+  buf.push_back((unsigned char)value);
+}
+
+static inline unsigned long long zigzag(long long value)
+{
+  return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+}
+
+static inline long long unzigzag(unsigned long long value)
+{
+  return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+static void putString(std::vector<unsigned char>& buf, const Apto::String& str)
+{
+  putVarint(buf, str.GetSize());
+  const char* data = str;
+  buf.insert(buf.end(), data, data + str.GetSize());
+}
+
+static inline unsigned long long doubleBits(double value)
+{
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static inline double bitsDouble(unsigned long long bits)
+{
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+
+class cByteReader
+{
+private:
+  const unsigned char* m_cur;
+  const unsigned char* m_end;
+  bool m_error;
+
+public:
+  cByteReader(const unsigned char* data, size_t size) : m_cur(data), m_end(data + size), m_error(false) { ; }
+  cByteReader(const std::vector<unsigned char>& buf)
+    : m_cur(buf.size() ? &buf[0] : NULL), m_end(m_cur + buf.size()), m_error(false) { ; }
+
+  bool Good() const { return !m_error; }
+  const unsigned char* Position() const { return m_cur; }
+
+  unsigned char Byte()
+  {
+    if (m_cur >= m_end) { m_error = true; return 0; }
+    return *m_cur++;
+  }
+
+  unsigned long long Fixed(int num_bytes)
+  {
+    if (m_end - m_cur < num_bytes) { m_error = true; return 0; }
+    unsigned long long value = 0;
+    for (int i = 0; i < num_bytes; i++) value |= (unsigned long long)m_cur[i] << (8 * i);
+    m_cur += num_bytes;
+    return value;
+  }
+
+  unsigned long long Varint()
+  {
+    unsigned long long value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const unsigned char b = Byte();
+      value |= (unsigned long long)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return value;
+    }
+    m_error = true;
+    return 0;
+  }
+
+  Apto::String String()
+  {
+    const unsigned long long len = Varint();
+    if (m_error || (unsigned long long)(m_end - m_cur) < len) { m_error = true; return Apto::String(""); }
+    std::string str((const char*)m_cur, len);
+    m_cur += len;
+    return Apto::String(str.c_str());
+  }
+
+  void Skip(unsigned long long len)
+  {
+    if ((unsigned long long)(m_end - m_cur) < len) { m_error = true; return; }
+    m_cur += len;
+  }
+};
+
+
+static bool isUpdateColumn(const char* descr)
+{
+  const char* name = "update";
+  for (; *descr && *name; descr++, name++) if (tolower(*descr) != *name) return false;
+  return (*descr == '\0' && *name == '\0');
+}
+
+static Apto::String formatDouble(double value)
+{
+  // Match the default stream formatting used by the text data files
+  std::ostringstream str;
+  str << value;
+  return Apto::String(str.str().c_str());
+}
+
+
+
+// ColumnarEncoder
+// --------------------------------------------------------------------------------------------------------------
+
+struct Avida::Output::ColumnarEncoder::Column
+{
+  ColumnType type;
+  Apto::String descr;
+  Apto::String format;
+
+  Apto::Array<long long> ints;
+  Apto::Array<double> doubles;
+  Apto::Array<Apto::String> strings;
+
+  Column(ColumnType in_type) : type(in_type)
+  {
+    switch (type) {
+      case COLUMN_INT:    ints.Resize(COLUMNAR_BLOCK_ROWS); break;
+      case COLUMN_DOUBLE: doubles.Resize(COLUMNAR_BLOCK_ROWS); break;
+      case COLUMN_STRING: strings.Resize(COLUMNAR_BLOCK_ROWS); break;
+    }
+  }
+};
+
+
+Avida::Output::ColumnarEncoder::ColumnarEncoder(std::ostream& out)
+  : m_out(out), m_offset(0), m_update_col(-1), m_columns_fixed(false), m_cur_col(0), m_block_rows(0), m_total_rows(0)
+  , m_header_written(false)
+{
+  m_out.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+  m_offset = sizeof(COLUMNAR_MAGIC);
+}
+
+Avida::Output::ColumnarEncoder::~ColumnarEncoder()
+{
+  for (int i = 0; i < m_columns.GetSize(); i++) delete m_columns[i];
+}
+
+
+void Avida::Output::ColumnarEncoder::Int(long long value)
+{
+  Column* col = nextColumn(COLUMN_INT);
+  if (!col) return;
+
+  switch (col->type) {
+    case COLUMN_INT:    col->ints[m_block_rows] = value; break;
+    case COLUMN_DOUBLE: col->doubles[m_block_rows] = (double)value; break;
+    case COLUMN_STRING: col->strings[m_block_rows] = Apto::FormatStr("%lld", value); break;
+  }
+}
+
+void Avida::Output::ColumnarEncoder::Double(double value)
+{
+  Column* col = nextColumn(COLUMN_DOUBLE);
+  if (!col) return;
+
+  switch (col->type) {
+    case COLUMN_INT:    col->ints[m_block_rows] = (long long)value; break;
+    case COLUMN_DOUBLE: col->doubles[m_block_rows] = value; break;
+    case COLUMN_STRING: col->strings[m_block_rows] = formatDouble(value); break;
+  }
+}
+
+void Avida::Output::ColumnarEncoder::String(const char* value)
+{
+  Column* col = nextColumn(COLUMN_STRING);
+  if (!col) return;
+
+  switch (col->type) {
+    case COLUMN_INT:    col->ints[m_block_rows] = atoll(value); break;
+    case COLUMN_DOUBLE: col->doubles[m_block_rows] = atof(value); break;
+    case COLUMN_STRING: col->strings[m_block_rows] = value; break;
+  }
+}
+
+
+void Avida::Output::ColumnarEncoder::DescribeColumn(const char* descr, const char* format)
+{
+  if (m_columns_fixed || m_columns.GetSize() == 0) return;
+
+  Column* col = m_columns[m_columns.GetSize() - 1];
+  col->descr = descr;
+  col->format = format;
+
+  if (m_update_col == -1) {
+    if (isUpdateColumn(descr) || isUpdateColumn(format)) m_update_col = m_columns.GetSize() - 1;
+  }
+}
+
+
+void Avida::Output::ColumnarEncoder::SetHeader(const Apto::String& filetype, const Apto::String& format,
+                                               const Apto::String& comments)
+{
+  m_filetype = filetype;
+  m_format = format;
+  m_comments = comments;
+}
+
+
+void Avida::Output::ColumnarEncoder::EndRow()
+{
+  // Rows that supply fewer values than there are columns are padded with empty values
+  for (; m_cur_col < m_columns.GetSize(); m_cur_col++) {
+    Column* col = m_columns[m_cur_col];
+    switch (col->type) {
+      case COLUMN_INT:    col->ints[m_block_rows] = 0; break;
+      case COLUMN_DOUBLE: col->doubles[m_block_rows] = 0.0; break;
+      case COLUMN_STRING: col->strings[m_block_rows] = ""; break;
+    }
+  }
+
+  m_columns_fixed = true;
+  m_cur_col = 0;
+  m_block_rows++;
+  m_total_rows++;
+
+  if (m_block_rows == COLUMNAR_BLOCK_ROWS) writeBlock();
+}
+
+
+void Avida::Output::ColumnarEncoder::Flush()
+{
+  writeBlock();
+}
+
+
+void Avida::Output::ColumnarEncoder::Close()
+{
+  // The header can only be written once the first row has defined the columns
+  if (m_total_rows == 0) return;
+
+  writeBlock();
+  writeIndex();
+}
+
+
+Avida::Output::ColumnarEncoder::Column* Avida::Output::ColumnarEncoder::nextColumn(ColumnType type)
+{
+  if (m_cur_col >= m_columns.GetSize()) {
+    // Values beyond the columns defined by the first row are dropped
+    if (m_columns_fixed) return NULL;
+    m_columns.Push(new Column(type));
+  }
+  return m_columns[m_cur_col++];
+}
+
+
+void Avida::Output::ColumnarEncoder::writeHeader()
+{
+  std::vector<unsigned char> payload;
+  putString(payload, m_filetype);
+  putString(payload, m_format);
+  putString(payload, m_comments);
+  putVarint(payload, zigzag(m_update_col));
+  putVarint(payload, m_columns.GetSize());
+  for (int i = 0; i < m_columns.GetSize(); i++) {
+    payload.push_back((unsigned char)m_columns[i]->type);
+    putString(payload, m_columns[i]->descr);
+    putString(payload, m_columns[i]->format);
+  }
+  writeRecord(COLUMNAR_RECORD_HEAD, payload);
+  m_header_written = true;
+}
+
+
+void Avida::Output::ColumnarEncoder::writeBlock()
+{
+  if (m_block_rows == 0) return;
+  if (!m_header_written) writeHeader();
+
+  BlockIndex entry;
+  entry.offset = m_offset;
+  entry.first_row = m_total_rows - m_block_rows;
+  entry.first_update = entry.first_row;
+  entry.last_update = m_total_rows - 1;
+  if (m_update_col >= 0) {
+    const Column* col = m_columns[m_update_col];
+    if (col->type == COLUMN_INT) {
+      entry.first_update = col->ints[0];
+      entry.last_update = col->ints[m_block_rows - 1];
+    } else if (col->type == COLUMN_DOUBLE) {
+      entry.first_update = (long long)col->doubles[0];
+      entry.last_update = (long long)col->doubles[m_block_rows - 1];
+    }
+  }
+
+  std::vector<unsigned char> payload;
+  std::vector<unsigned char> col_data;
+  putVarint(payload, m_block_rows);
+  putVarint(payload, zigzag(entry.first_update));
+  putVarint(payload, zigzag(entry.last_update));
+
+  for (int c = 0; c < m_columns.GetSize(); c++) {
+    const Column* col = m_columns[c];
+    col_data.clear();
+
+    switch (col->type) {
+      case COLUMN_INT:
+      {
+        // Successive values in a time series are usually close, store zigzag encoded deltas
+        unsigned long long prev = 0;
+        for (int r = 0; r < m_block_rows; r++) {
+          const unsigned long long cur = (unsigned long long)col->ints[r];
+          putVarint(col_data, zigzag((long long)(cur - prev)));
+          prev = cur;
+        }
+        break;
+      }
+      case COLUMN_DOUBLE:
+      {
+        // XOR against the previous value clears the shared sign, exponent and high mantissa bytes; store only the
+        // significant low order bytes, prefixed by their count
+        unsigned long long prev = 0;
+        for (int r = 0; r < m_block_rows; r++) {
+          const unsigned long long bits = doubleBits(col->doubles[r]);
+          unsigned long long diff = bits ^ prev;
+          int num_bytes = 0;
+          for (unsigned long long d = diff; d; d >>= 8) num_bytes++;
+          col_data.push_back((unsigned char)num_bytes);
+          for (int b = 0; b < num_bytes; b++, diff >>= 8) col_data.push_back((unsigned char)diff);
+          prev = bits;
+        }
+        break;
+      }
+      case COLUMN_STRING:
+        for (int r = 0; r < m_block_rows; r++) putString(col_data, col->strings[r]);
+        break;
+    }
+
+    putVarint(payload, col_data.size());
+    payload.insert(payload.end(), col_data.begin(), col_data.end());
+  }
+
+  writeRecord(COLUMNAR_RECORD_BLOCK, payload);
+  m_index.Push(entry);
+  m_block_rows = 0;
+}
+
+
+void Avida::Output::ColumnarEncoder::writeIndex()
+{
+  const long long index_offset = m_offset;
+
+  std::vector<unsigned char> payload;
+  putVarint(payload, m_total_rows);
+  putVarint(payload, m_index.GetSize());
+  for (int i = 0; i < m_index.GetSize(); i++) {
+    putU64(payload, m_index[i].offset);
+    putVarint(payload, m_index[i].first_row);
+    putVarint(payload, zigzag(m_index[i].first_update));
+    putVarint(payload, zigzag(m_index[i].last_update));
+  }
+  writeRecord(COLUMNAR_RECORD_INDEX, payload);
+
+  payload.clear();
+  putU64(payload, index_offset);
+  writeRecord(COLUMNAR_RECORD_TAIL, payload);
+}
+
+
+void Avida::Output::ColumnarEncoder::writeRecord(unsigned int tag, const std::vector<unsigned char>& payload)
+{
+  std::vector<unsigned char> prefix;
+  putU32(prefix, tag);
+  putU32(prefix, payload.size());
+  m_out.write((const char*)&prefix[0], prefix.size());
+  if (payload.size()) m_out.write((const char*)&payload[0], payload.size());
+  m_offset += prefix.size() + payload.size();
+}
+
+
+
+// ColumnarReader
+// --------------------------------------------------------------------------------------------------------------
+
+Avida::Output::ColumnarReader::ColumnarReader() : m_file_size(0), m_update_col(-1), m_num_rows(0), m_cur_block(-1), m_block_rows(0), m_cur_row(-1)
+{
+}
+
+
+bool Avida::Output::ColumnarReader::Open(const Apto::String& path)
+{
+  m_in.open((const char*)path, std::ios::in | std::ios::binary);
+  if (!m_in.good()) return false;
+
+  m_in.seekg(0, std::ios::end);
+  m_file_size = m_in.tellg();
+  m_in.seekg(0, std::ios::beg);
+
+  char magic[sizeof(COLUMNAR_MAGIC)];
+  m_in.read(magic, sizeof(magic));
+  if (m_in.fail() || memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0) return false;
+
+  // The header immediately follows the magic
+  unsigned int tag = 0;
+  std::vector<unsigned char> payload;
+  if (!readRecord(sizeof(COLUMNAR_MAGIC), tag, payload) || tag != COLUMNAR_RECORD_HEAD) return false;
+  if (!parseHeader(payload)) return false;
+
+  // Use the trailing index if the file ended cleanly, otherwise reconstruct it from the block records
+  if (!readIndex() && !scanRecords()) return false;
+
+  Rewind();
+  return true;
+}
+
+
+void Avida::Output::ColumnarReader::Rewind()
+{
+  m_cur_block = -1;
+  m_block_rows = 0;
+  m_cur_row = -1;
+}
+
+
+
+
+bool Avida::Output::ColumnarReader::SeekUpdate(long long update)
+{
+  // Find the first block that extends to (or past) the requested update
+  int lo = 0;
+  int hi = m_blocks.GetSize();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (m_blocks[mid].last_update < update) lo = mid + 1;
+    else hi = mid;
+  }
+
+  if (lo == m_blocks.GetSize() || !loadBlock(lo)) {
+    m_cur_block = m_blocks.GetSize();
+    m_block_rows = 0;
+    m_cur_row = -1;
+    return false;
+  }
+
+  int row = 0;
+  while (row < m_block_rows - 1 && rowUpdate(row) < update) row++;
+  m_cur_row = row - 1;
+  return true;
+}
+
+
+bool Avida::Output::ColumnarReader::NextRow()
+{
+  if (m_cur_row + 1 < m_block_rows) {
+    m_cur_row++;
+    return true;
+  }
+
+  if (m_cur_block + 1 >= m_blocks.GetSize() || !loadBlock(m_cur_block + 1)) return false;
+  m_cur_row = 0;
+  return (m_block_rows > 0);
+}
+
+
+long long Avida::Output::ColumnarReader::IntValue(int col) const
+{
+  assert(m_cur_row >= 0 && m_cur_row < m_block_rows);
+  switch (m_columns[col].type) {
+    case COLUMN_INT:    return m_ints[col][m_cur_row];
+    case COLUMN_DOUBLE: return (long long)m_doubles[col][m_cur_row];
+    case COLUMN_STRING: return atoll((const char*)m_strings[col][m_cur_row]);
+  }
+  return 0;
+}
+
+double Avida::Output::ColumnarReader::DoubleValue(int col) const
+{
+  assert(m_cur_row >= 0 && m_cur_row < m_block_rows);
+  switch (m_columns[col].type) {
+    case COLUMN_INT:    return (double)m_ints[col][m_cur_row];
+    case COLUMN_DOUBLE: return m_doubles[col][m_cur_row];
+    case COLUMN_STRING: return atof((const char*)m_strings[col][m_cur_row]);
+  }
+  return 0.0;
+}
+
+Apto::String Avida::Output::ColumnarReader::StringValue(int col) const
+{
+  assert(m_cur_row >= 0 && m_cur_row < m_block_rows);
+  switch (m_columns[col].type) {
+    case COLUMN_INT:    return Apto::FormatStr("%lld", m_ints[col][m_cur_row]);
+    case COLUMN_DOUBLE: return formatDouble(m_doubles[col][m_cur_row]);
+    case COLUMN_STRING: return m_strings[col][m_cur_row];
+  }
+  return Apto::String("");
+}
+
+
+bool Avida::Output::ColumnarReader::WriteText(std::ostream& out, long long first_update)
+{
+  // Same layout as Output::File::Endl produces for the first row of a text data file
+  if (m_filetype != "") out << "#filetype " << m_filetype << std::endl;
+  if (m_format != "") out << "#format " << m_format << std::endl;
+  out << m_comments << std::endl;
+
+  if (first_update >= 0) {
+    if (!SeekUpdate(first_update)) return out.good();
+  } else {
+    Rewind();
+  }
+
+  while (NextRow()) {
+    for (int c = 0; c < m_columns.GetSize(); c++) {
+      switch (m_columns[c].type) {
+        case COLUMN_INT:    out << m_ints[c][m_cur_row] << " "; break;
+        case COLUMN_DOUBLE: out << m_doubles[c][m_cur_row] << " "; break;
+        case COLUMN_STRING: out << m_strings[c][m_cur_row] << " "; break;
+      }
+    }
+    out << "\n";
+  }
+
+  return out.good();
+}
+
+
+bool Avida::Output::ColumnarReader::readIndex()
+{
+  if (m_file_size < (long long)sizeof(COLUMNAR_MAGIC) + COLUMNAR_TAIL_SIZE) return false;
+
+  unsigned int tag = 0;
+  std::vector<unsigned char> payload;
+  if (!readRecord(m_file_size - COLUMNAR_TAIL_SIZE, tag, payload) || tag != COLUMNAR_RECORD_TAIL) return false;
+
+  cByteReader tail(payload);
+  const long long index_offset = tail.Fixed(8);
+  if (!tail.Good() || !readRecord(index_offset, tag, payload) || tag != COLUMNAR_RECORD_INDEX) return false;
+
+  cByteReader index(payload);
+  m_num_rows = index.Varint();
+  const unsigned long long num_blocks = index.Varint();
+  if (!index.Good() || num_blocks > payload.size()) return false;
+
+  m_blocks.ResizeClear((int)num_blocks);
+  for (int i = 0; i < m_blocks.GetSize(); i++) {
+    m_blocks[i].offset = index.Fixed(8);
+    m_blocks[i].first_row = index.Varint();
+    m_blocks[i].first_update = unzigzag(index.Varint());
+    m_blocks[i].last_update = unzigzag(index.Varint());
+  }
+  return index.Good();
+}
+
+
+bool Avida::Output::ColumnarReader::scanRecords()
+{
+  m_blocks.ResizeClear(0);
+  m_num_rows = 0;
+
+  // Walk the record chain, stopping at the first truncated or damaged record
+  long long offset = sizeof(COLUMNAR_MAGIC);
+  unsigned int tag = 0;
+  std::vector<unsigned char> payload;
+  while (offset + COLUMNAR_RECORD_PREFIX <= m_file_size && readRecord(offset, tag, payload)) {
+    if (tag == COLUMNAR_RECORD_BLOCK) {
+      cByteReader block(payload);
+      BlockInfo info;
+      info.offset = offset;
+      info.first_row = m_num_rows;
+      const long long rows = block.Varint();
+      info.first_update = unzigzag(block.Varint());
+      info.last_update = unzigzag(block.Varint());
+      if (!block.Good()) break;
+
+      m_blocks.Push(info);
+      m_num_rows += rows;
+    }
+    offset += COLUMNAR_RECORD_PREFIX + payload.size();
+  }
+
+  return true;
+}
+
+
+bool Avida::Output::ColumnarReader::parseHeader(const std::vector<unsigned char>& payload)
+{
+  cByteReader header(payload);
+  m_filetype = header.String();
+  m_format = header.String();
+  m_comments = header.String();
+  m_update_col = (int)unzigzag(header.Varint());
+
+  const unsigned long long num_cols = header.Varint();
+  if (!header.Good() || num_cols > payload.size()) return false;
+
+  m_columns.ResizeClear((int)num_cols);
+  for (int i = 0; i < m_columns.GetSize(); i++) {
+    const int type = header.Byte();
+    if (type < COLUMN_INT || type > COLUMN_STRING) return false;
+    m_columns[i].type = (ColumnType)type;
+    m_columns[i].descr = header.String();
+    m_columns[i].format = header.String();
+  }
+  if (m_update_col >= m_columns.GetSize()) m_update_col = -1;
+
+  m_ints.ResizeClear(m_columns.GetSize());
+  m_doubles.ResizeClear(m_columns.GetSize());
+  m_strings.ResizeClear(m_columns.GetSize());
+
+  return header.Good();
+}
+
+
+bool Avida::Output::ColumnarReader::loadBlock(int block_id)
+{
+  if (block_id == m_cur_block) return true;
+
+  unsigned int tag = 0;
+  std::vector<unsigned char> payload;
+  if (!readRecord(m_blocks[block_id].offset, tag, payload) || tag != COLUMNAR_RECORD_BLOCK) return false;
+
+  cByteReader block(payload);
+  const unsigned long long num_rows = block.Varint();
+  block.Varint(); // first update
+  block.Varint(); // last update
+  if (!block.Good() || num_rows > payload.size()) return false;
+  const int rows = (int)num_rows;
+
+  for (int c = 0; c < m_columns.GetSize(); c++) {
+    const unsigned long long col_len = block.Varint();
+    if (!block.Good()) return false;
+    cByteReader col(block.Position(), (size_t)col_len);
+    block.Skip(col_len);
+    if (!block.Good()) return false;
+
+    switch (m_columns[c].type) {
+      case COLUMN_INT:
+      {
+        m_ints[c].ResizeClear(rows);
+        unsigned long long prev = 0;
+        for (int r = 0; r < rows; r++) {
+          prev += (unsigned long long)unzigzag(col.Varint());
+          m_ints[c][r] = (long long)prev;
+        }
+        break;
+      }
+      case COLUMN_DOUBLE:
+      {
+        m_doubles[c].ResizeClear(rows);
+        unsigned long long prev = 0;
+        for (int r = 0; r < rows; r++) {
+          const int num_bytes = col.Byte();
+          if (num_bytes > 8) return false;
+          prev ^= col.Fixed(num_bytes);
+          m_doubles[c][r] = bitsDouble(prev);
+        }
+        break;
+      }
+      case COLUMN_STRING:
+        m_strings[c].ResizeClear(rows);
+        for (int r = 0; r < rows; r++) m_strings[c][r] = col.String();
+        break;
+    }
+    if (!col.Good()) return false;
+  }
+
+  m_cur_block = block_id;
+  m_block_rows = rows;
+  m_cur_row = -1;
+  return true;
+}
+
+
+long long Avida::Output::ColumnarReader::rowUpdate(int row) const
+{
+  if (m_update_col < 0) return m_blocks[m_cur_block].first_row + row;
+  switch (m_columns[m_update_col].type) {
+    case COLUMN_INT:    return m_ints[m_update_col][row];
+    case COLUMN_DOUBLE: return (long long)m_doubles[m_update_col][row];
+    default:            break;
+  }
+  return m_blocks[m_cur_block].first_row + row;
+}
+
+
+bool Avida::Output::ColumnarReader::readRecord(long long offset, unsigned int& tag, std::vector<unsigned char>& payload)
+{
+  unsigned char prefix[COLUMNAR_RECORD_PREFIX];
+  m_in.clear();
+  m_in.seekg(offset, std::ios::beg);
+  m_in.read((char*)prefix, sizeof(prefix));
+  if (m_in.fail()) return false;
+
+  cByteReader reader(prefix, sizeof(prefix));
+  tag = (unsigned int)reader.Fixed(4);
+  const unsigned int len = (unsigned int)reader.Fixed(4);
+  if (offset + COLUMNAR_RECORD_PREFIX + (long long)len > m_file_size) return false;
+
+  payload.resize(len);
+  if (len) m_in.read((char*)&payload[0], len);
+  return !m_in.fail();
+}
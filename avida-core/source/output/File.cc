@@ -25,9 +25,12 @@
 #include "avida/output/File.h"
 
 #include "avida/core/Feedback.h"
+#include "avida/output/Columnar.h"
 #include "avida/output/Manager.h"
 
+#include <cstring>
 #include <ctime>
+#include <iostream>
 
 
 Avida::Output::FilePtr Avida::Output::File::createWithPath(World* world, Apto::String path, bool append, Feedback* feedback)
@@ -89,18 +92,44 @@ Avida::Output::FilePtr Avida::Output::File::StaticWithPath(World* world, Apto::S
 
 
 Avida::Output::File::File(World* world, const OutputID& name, bool append)
-  : Socket(world, name), m_descr_written(false), m_num_cols(0)
+  : Socket(world, name), m_descr_written(false), m_num_cols(0), m_columnar(NULL)
+  , m_reported_text_only(false)
 {
-  m_fp.open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
-  assert(m_fp.good());
+  // Files named with the columnar extension are written in the binary columnar format.  Each columnar file carries
+  // its own header and index, so appending to an existing one is not supported.
+  const int ext_len = strlen(COLUMNAR_FILE_EXTENSION);
+  const bool columnar = (name.GetSize() > ext_len &&
+                         strcmp((const char*)name + name.GetSize() - ext_len, COLUMNAR_FILE_EXTENSION) == 0);
+  if (columnar) append = false;
+
+  // Route the stream through the batching buffer, which hands full blocks to the manager's writer thread (if any)
+  static_cast<std::ios&>(m_fp).rdbuf(&m_buf);
+  if (!m_buf.Open(name, append, Manager::Of(world)->OutputWriter(), columnar)) {
+    m_fp.setstate(std::ios::failbit);
+    return;
+  }
+
+  if (columnar) m_columnar = new ColumnarEncoder(m_fp);
 }
 
-Avida::Output::File::~File() { ; }
+Avida::Output::File::~File()
+{
+  if (m_columnar) {
+    m_columnar->Close();
+    delete m_columnar;
+  }
+  m_buf.Close();
+}
 
 
 
 void Avida::Output::File::Write(double x, const char* descr, const char* format)
 {
+  if (m_columnar) {
+    m_columnar->Double(x);
+    WriteColumnDesc(descr, format);
+    return;
+  }
   if (!m_descr_written) {
     m_data << x << " ";
     WriteColumnDesc(descr, format);
@@ -112,6 +141,11 @@ void Avida::Output::File::Write(double x, const char* descr, const char* format)
 
 void Avida::Output::File::Write(int i, const char* descr, const char* format)
 {
+  if (m_columnar) {
+    m_columnar->Int(i);
+    WriteColumnDesc(descr, format);
+    return;
+  }
   if (!m_descr_written) {
     m_data << i << " ";
     WriteColumnDesc(descr, format);
@@ -123,6 +157,11 @@ void Avida::Output::File::Write(int i, const char* descr, const char* format)
 
 void Avida::Output::File::Write(long i, const char* descr, const char* format)
 {
+  if (m_columnar) {
+    m_columnar->Int(i);
+    WriteColumnDesc(descr, format);
+    return;
+  }
   if (!m_descr_written) {
     m_data << i << " ";
     WriteColumnDesc(descr, format);
@@ -133,6 +172,11 @@ void Avida::Output::File::Write(long i, const char* descr, const char* format)
 
 void Avida::Output::File::Write(unsigned int i, const char* descr, const char*)
 {
+  if (m_columnar) {
+    m_columnar->Int(i);
+    WriteColumnDesc(descr);
+    return;
+  }
   if (!m_descr_written) {
     m_data << i << " ";
     WriteColumnDesc(descr);
@@ -144,6 +188,11 @@ void Avida::Output::File::Write(unsigned int i, const char* descr, const char*)
 
 void Avida::Output::File::Write(const char* data_str, const char* descr, const char* format)
 {
+  if (m_columnar) {
+    m_columnar->String(data_str);
+    WriteColumnDesc(descr, format);
+    return;
+  }
   if (!m_descr_written) {
     m_data << data_str << " ";
     WriteColumnDesc(descr, format);
@@ -155,6 +204,12 @@ void Avida::Output::File::Write(const char* data_str, const char* descr, const c
 void Avida::Output::File::Write(Apto::Array<int> list, const char* descr, const char* format)
 {
   //Anya is trying to make a commant to write vectors for Kaboom data
+  if (m_columnar) {
+    // Each element occupies its own column, matching the text layout
+    for (int i = 0; i < (int)list.GetSize(); i++) m_columnar->Int(list[i]);
+    WriteColumnDesc(descr, format);
+    return;
+  }
   if (!m_descr_written) {
     for (int i=0; i< (int)list.GetSize();i++) {
       m_data << list[i] << " ";
@@ -168,14 +223,49 @@ void Avida::Output::File::Write(Apto::Array<int> list, const char* descr, const
 }
 
 
+void Avida::Output::File::WriteAnonymous(double x)
+{
+  if (m_columnar) m_columnar->Double(x);
+  else m_fp << x << " ";
+}
+
+void Avida::Output::File::WriteAnonymous(int i)
+{
+  if (m_columnar) m_columnar->Int(i);
+  else m_fp << i << " ";
+}
+
+void Avida::Output::File::WriteAnonymous(long i)
+{
+  if (m_columnar) m_columnar->Int(i);
+  else m_fp << i << " ";
+}
+
+void Avida::Output::File::WriteAnonymous(const char* data_str)
+{
+  if (m_columnar) m_columnar->String(data_str);
+  else m_fp << data_str << " ";
+}
+
+
 void Avida::Output::File::WriteBlockElement(double x, int element, int x_size)
 {
+  if (m_columnar) {
+    rejectTextOnly("WriteBlockElement");
+    return;
+  }
+
   m_fp << x << " ";
   if (((element + 1) % x_size) == 0) m_fp << "\n";
 }
 
 void Avida::Output::File::WriteBlockElement(int i, int element, int x_size)
 {
+  if (m_columnar) {
+    rejectTextOnly("WriteBlockElement");
+    return;
+  }
+
   m_fp << i << " ";
   if (((element + 1) % x_size) == 0) m_fp << "\n";
 }
@@ -187,6 +277,7 @@ void Avida::Output::File::WriteColumnDesc(const char* descr, const char* format)
     m_descr += Apto::FormatStr("# %2d: %s\n", m_num_cols, descr);
     Apto::String formatstr(format);
     if (formatstr != "") m_format += formatstr + " ";
+    if (m_columnar) m_columnar->DescribeColumn(descr, format);
   }
 }
 
@@ -203,10 +294,24 @@ void Avida::Output::File::WriteRawComment(const char* comment)
 
 void Avida::Output::File::WriteRaw(const char* str)
 {
+  if (m_columnar) {
+    rejectTextOnly("WriteRaw");
+    return;
+  }
   m_fp << str << "\n";
 }
 
 
+// Block and raw output have no columns to store them in.  The data cannot be kept, so say so rather than drop it.
+void Avida::Output::File::rejectTextOnly(const char* method)
+{
+  if (m_reported_text_only) return;
+  m_reported_text_only = true;
+  std::cerr << "error: " << method << " output cannot be stored in columnar data file '" << (const char*)m_output_id
+            << "'; use a text data file for this output" << std::endl;
+}
+
+
 
 
 void Avida::Output::File::WriteTimeStamp()
@@ -220,7 +325,8 @@ void Avida::Output::File::WriteTimeStamp()
 void Avida::Output::File::FlushComments()
 {
   if (!m_descr_written) {
-    m_fp << m_descr;
+    if (m_columnar) m_columnar->SetHeader(m_filetype, m_format, m_descr);
+    else m_fp << m_descr;
     m_descr = "";
     
     m_descr_written = true;
@@ -231,6 +337,16 @@ void Avida::Output::File::FlushComments()
 
 void Avida::Output::File::Endl()
 {
+  if (m_columnar) {
+    if (!m_descr_written) {
+      m_columnar->SetHeader(m_filetype, m_format, m_descr);
+      m_descr = "";
+      m_descr_written = true;
+    }
+    m_columnar->EndRow();
+    return;
+  }
+  
   if (!m_descr_written) {
     // Handle filetype and format first
     if (m_filetype != "") m_fp << "#filetype " << m_filetype << std::endl;
@@ -254,5 +370,6 @@ void Avida::Output::File::Endl()
 
 void Avida::Output::File::Flush()
 {
-  m_fp.flush();
+  if (m_columnar) m_columnar->Flush();
+  m_buf.Flush();
 }
@@ -25,8 +25,13 @@
 #include "avida/output/Manager.h"
 
 #include "avida/output/Socket.h"
+#include "avida/output/Writer.h"
 
-Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
+
+static const size_t ASYNC_BLOCK_SIZE = 64 * 1024;
+
+
+Avida::Output::Manager::Manager(const Apto::String& output_path, int async_buffer_size) : m_world(NULL)
 {
   m_output_path = output_path;
   m_output_path.Trim();
@@ -38,9 +43,17 @@ Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
     if (dir_tail != '\\' && dir_tail != '/') m_output_path += "/";
     Apto::FileSystem::MkDir(Apto::String(m_output_path));
   }
+  
+  if (async_buffer_size > 0) {
+    m_writer = WriterPtr(new Writer(ASYNC_BLOCK_SIZE, async_buffer_size));
+    m_writer->Start();
+  }
 }
 
-Avida::Output::Manager::~Manager() { ; }
+Avida::Output::Manager::~Manager()
+{
+  if (m_writer) m_writer->Shutdown();
+}
 
 
 Avida::Output::OutputID Avida::Output::Manager::OutputIDFromPath(Apto::String path) const
@@ -112,6 +125,8 @@ void Avida::Output::Manager::FlushAll()
     (*it.Get())->Flush();
   }
   m_mutex.Unlock();
+  
+  if (m_writer) m_writer->Drain();
 }
 
 
@@ -0,0 +1,274 @@
+/*
+ *  output/Writer.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/Writer.h"
+
+#include <cassert>
+
+
+Avida::Output::Writer::Writer(size_t block_size, size_t max_pending_bytes)
+  : m_block_size(block_size), m_max_pending((max_pending_bytes > block_size) ? (max_pending_bytes / block_size) : 1)
+  , m_head(NULL), m_tail(NULL), m_pending(0), m_busy_fp(NULL), m_shutdown(false)
+{
+  assert(block_size > 0);
+}
+
+Avida::Output::Writer::~Writer()
+{
+  Shutdown();
+  for (int i = 0; i < m_free_data.GetSize(); i++) delete [] m_free_data[i];
+}
+
+
+char* Avida::Output::Writer::AcquireBlock()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  const int num_free = m_free_data.GetSize();
+  if (num_free == 0) return new char[m_block_size];
+
+  char* data = m_free_data[num_free - 1];
+  m_free_data.Resize(num_free - 1);
+  return data;
+}
+
+
+void Avida::Output::Writer::Submit(std::FILE* fp, char* data, size_t size)
+{
+  enqueue(fp, data, size, false);
+}
+
+
+void Avida::Output::Writer::Close(std::FILE* fp)
+{
+  enqueue(fp, NULL, 0, true);
+}
+
+
+void Avida::Output::Writer::Drain()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  while (m_head || m_busy_fp) m_drain_cond.Wait(m_mutex);
+}
+
+
+void Avida::Output::Writer::Drain(std::FILE* fp)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  while (hasPending(fp)) m_drain_cond.Wait(m_mutex);
+}
+
+
+void Avida::Output::Writer::Shutdown()
+{
+  m_mutex.Lock();
+  if (m_shutdown) {
+    m_mutex.Unlock();
+    return;
+  }
+  m_shutdown = true;
+  m_work_cond.Signal();
+  m_mutex.Unlock();
+
+  Join();
+}
+
+
+void Avida::Output::Writer::enqueue(std::FILE* fp, char* data, size_t size, bool close)
+{
+  Block* block = new Block;
+  block->fp = fp;
+  block->data = data;
+  block->size = size;
+  block->close = close;
+  block->next = NULL;
+
+  Apto::MutexAutoLock lock(m_mutex);
+
+  // After shutdown there is no thread to hand off to, perform the write directly
+  if (m_shutdown) {
+    if (size) fwrite(data, 1, size, fp);
+    if (close) fclose(fp);
+    releaseData(data);
+    delete block;
+    return;
+  }
+
+  // Bound the memory held by pending writes, wait for the writer to catch up
+  if (data) {
+    while (m_pending >= m_max_pending) m_drain_cond.Wait(m_mutex);
+    m_pending++;
+  }
+
+  if (m_tail) m_tail->next = block;
+  else m_head = block;
+  m_tail = block;
+
+  m_work_cond.Signal();
+}
+
+
+void Avida::Output::Writer::releaseData(char* data)
+{
+  // Caller must hold m_mutex.  Retain enough blocks to refill the pending queue without allocating.
+  if (!data) return;
+  if (m_free_data.GetSize() <= m_max_pending) m_free_data.Push(data);
+  else delete [] data;
+}
+
+
+bool Avida::Output::Writer::hasPending(std::FILE* fp) const
+{
+  // Caller must hold m_mutex
+  if (m_busy_fp == fp) return true;
+  for (Block* block = m_head; block; block = block->next) if (block->fp == fp) return true;
+  return false;
+}
+
+
+void Avida::Output::Writer::Run()
+{
+  m_mutex.Lock();
+  while (true) {
+    while (!m_head && !m_shutdown) m_work_cond.Wait(m_mutex);
+    if (!m_head) break;
+
+    Block* block = m_head;
+    m_head = block->next;
+    if (!m_head) m_tail = NULL;
+    m_busy_fp = block->fp;
+    m_mutex.Unlock();
+
+    // Perform the actual I/O without holding the lock, so that the simulation thread can keep submitting
+    if (block->size) fwrite(block->data, 1, block->size, block->fp);
+    if (block->close) fclose(block->fp);
+
+    m_mutex.Lock();
+    if (block->data) m_pending--;
+    releaseData(block->data);
+    delete block;
+    m_busy_fp = NULL;
+    m_drain_cond.Broadcast();
+  }
+  m_mutex.Unlock();
+}
+
+
+
+Avida::Output::FileBuffer::~FileBuffer()
+{
+  Close();
+}
+
+
+bool Avida::Output::FileBuffer::Open(const char* path, bool append, WriterPtr writer, bool binary)
+{
+  Close();
+
+  if (binary) m_fp = fopen(path, (append) ? "ab" : "wb");
+  else m_fp = fopen(path, (append) ? "a" : "w");
+  if (!m_fp) return false;
+
+  m_writer = writer;
+  if (m_writer) {
+    // Blocks are written whole, stdio buffering would only add another copy
+    setvbuf(m_fp, NULL, _IONBF, 0);
+    m_block_size = m_writer->BlockSize();
+    m_block = m_writer->AcquireBlock();
+  } else {
+    m_block_size = BUFSIZ;
+    m_block = new char[m_block_size];
+  }
+  setp(m_block, m_block + m_block_size);
+
+  return true;
+}
+
+
+void Avida::Output::FileBuffer::Close()
+{
+  if (!m_fp) return;
+
+  submitBlock();
+  if (m_writer) {
+    // Hand the unused block back to the writer for reuse, then close once everything queued has been written
+    m_writer->Submit(m_fp, m_block, 0);
+    m_writer->Close(m_fp);
+    m_writer = WriterPtr(NULL);
+  } else {
+    fclose(m_fp);
+    delete [] m_block;
+  }
+
+  m_fp = NULL;
+  m_block = NULL;
+  setp(NULL, NULL);
+}
+
+
+void Avida::Output::FileBuffer::Flush()
+{
+  if (!m_fp) return;
+
+  submitBlock();
+  if (m_writer) m_writer->Drain(m_fp);
+  else fflush(m_fp);
+}
+
+
+Avida::Output::FileBuffer::int_type Avida::Output::FileBuffer::overflow(int_type c)
+{
+  if (!m_fp) return traits_type::eof();
+
+  submitBlock();
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+
+int Avida::Output::FileBuffer::sync()
+{
+  if (!m_fp) return -1;
+
+  // Asynchronous buffers only write on full blocks and explicit flushes, so that per-line std::endl stays cheap
+  if (!m_writer) {
+    submitBlock();
+    fflush(m_fp);
+  }
+  return 0;
+}
+
+
+void Avida::Output::FileBuffer::submitBlock()
+{
+  const size_t size = pptr() - pbase();
+  if (size == 0) return;
+
+  if (m_writer) {
+    m_writer->Submit(m_fp, m_block, size);
+    m_block = m_writer->AcquireBlock();
+  } else {
+    fwrite(m_block, 1, size, m_fp);
+  }
+  setp(m_block, m_block + m_block_size);
+}
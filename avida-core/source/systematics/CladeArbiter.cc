@@ -195,6 +195,12 @@ Apto::String Avida::Systematics::CladeArbiter::DescribeProvidedValue(const Data:
   return rtn;
 }
 
+bool Avida::Systematics::CladeArbiter::IsThreadSafe() const
+{
+  // Updating only reads this arbiter's own clades, and retrieval only reads the values stashed by the update
+  return true;
+}
+
 
 
 
@@ -31,6 +31,8 @@
 #include "cTestCPU.h"
 #include "cWorld.h"
 
+static const Avida::PropertyKey s_prop_id_genome("genome");
+
 const Apto::String Avida::Systematics::GenomeTestMetrics::ObjectKey("Avida::Systematics::GenomeTestMetrics");
 
 
@@ -40,7 +42,7 @@ Avida::Systematics::GenomeTestMetrics::GenomeTestMetrics(cWorld* world, cAvidaCo
   Apto::SmartPtr<cTestCPU> testcpu(world->GetHardwareManager().CreateTestCPU(ctx));
   
   cCPUTestInfo test_info;
-  testcpu->TestGenome(ctx, test_info, Genome(g->Properties().Get("genome").StringValue()));
+  testcpu->TestGenome(ctx, test_info, Genome(g->Properties().Get(s_prop_id_genome).StringValue()));
   
   m_is_viable = test_info.IsViable();
   
@@ -69,7 +71,7 @@ Avida::Systematics::GenomeTestMetricsPtr Avida::Systematics::GenomeTestMetrics::
                                                                                            GroupPtr g)
 {
   GenomeTestMetricsPtr metrics = g->GetData<GenomeTestMetrics>();
-  if (!metrics && g->Properties().Has("genome")) {
+  if (!metrics && g->Properties().Has(s_prop_id_genome)) {
     metrics = GenomeTestMetricsPtr(new GenomeTestMetrics(world, ctx, g));
     assert(metrics);
     g->AttachData(metrics);
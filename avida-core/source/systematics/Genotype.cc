@@ -33,57 +33,97 @@
 #include "cStringList.h"
 #include "cStringUtil.h"
 
+#include <string>
 
-static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_copied_size("last_copied_size");
-static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_executed_size("last_executed_size");
-static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_gestation_time("last_gestation_time");
-static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_metabolic_rate("last_metabolic_rate");
-static const Apto::BasicString<Apto::ThreadSafe> s_unit_prop_name_last_fitness("last_fitness");
+
+static const Avida::PropertyKey s_unit_prop_name_last_copied_size("last_copied_size");
+static const Avida::PropertyKey s_unit_prop_name_last_executed_size("last_executed_size");
+static const Avida::PropertyKey s_unit_prop_name_last_gestation_time("last_gestation_time");
+static const Avida::PropertyKey s_unit_prop_name_last_metabolic_rate("last_metabolic_rate");
+static const Avida::PropertyKey s_unit_prop_name_last_fitness("last_fitness");
 
 
 static Avida::PropertyDescriptionMap s_prop_desc_map;
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_genome("genome");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_src_transmission_type("src_transmission_type");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_name("name");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_parents("parents");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_threshold("threshold");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_update_born("update_born");
+static const Avida::PropertyKey s_prop_name_genome("genome");
+static const Avida::PropertyKey s_prop_name_src_transmission_type("src_transmission_type");
+static const Avida::PropertyKey s_prop_name_name("name");
+static const Avida::PropertyKey s_prop_name_parents("parents");
+static const Avida::PropertyKey s_prop_name_threshold("threshold");
+static const Avida::PropertyKey s_prop_name_update_born("update_born");
+
+static const Avida::PropertyKey s_prop_name_ave_copy_size("ave_copy_size");
+static const Avida::PropertyKey s_prop_name_ave_exe_size("ave_exe_size");
+static const Avida::PropertyKey s_prop_name_ave_gestation_time("ave_gestation_time");
+static const Avida::PropertyKey s_prop_name_ave_repro_rate("ave_repro_rate");
+static const Avida::PropertyKey s_prop_name_ave_metabolic_rate("ave_metabolic_rate");
+static const Avida::PropertyKey s_prop_name_ave_fitness("ave_fitness");
+
+static const Avida::PropertyKey s_prop_name_max_fitness("max_fitness");
+
+static const Avida::PropertyKey s_prop_name_recent_births("recent_births");
+static const Avida::PropertyKey s_prop_name_recent_deaths("recent_deaths");
+static const Avida::PropertyKey s_prop_name_recent_breed_true("recent_breed_true");
+static const Avida::PropertyKey s_prop_name_recent_breed_in("recent_breed_in");
+static const Avida::PropertyKey s_prop_name_recent_breed_out("recent_breed_out");
+static const Avida::PropertyKey s_prop_name_recent_gestation_count("recent_gestation_count");
+
+static const Avida::PropertyKey s_prop_name_total_organisms("total_organisms");
+static const Avida::PropertyKey s_prop_name_last_births("last_births");
+static const Avida::PropertyKey s_prop_name_last_deaths("last_deaths");
+static const Avida::PropertyKey s_prop_name_last_breed_true("last_breed_true");
+static const Avida::PropertyKey s_prop_name_last_breed_in("last_breed_in");
+static const Avida::PropertyKey s_prop_name_last_breed_out("last_breed_out");
+static const Avida::PropertyKey s_prop_name_last_gestation_count("last_gestation_count");
+
+static const Avida::PropertyKey s_prop_name_last_birth_cell("last_birth_cell");
+static const Avida::PropertyKey s_prop_name_last_group_id("last_group_id");
+static const Avida::PropertyKey s_prop_name_last_forager_type("last_forager_type");
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_copy_size("ave_copy_size");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_exe_size("ave_exe_size");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_gestation_time("ave_gestation_time");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_repro_rate("ave_repro_rate");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_metabolic_rate("ave_metabolic_rate");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_ave_fitness("ave_fitness");
+static const Avida::PropertyKey s_prop_name_total_gestation_count("total_gestation_count");
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_max_fitness("max_fitness");
+static const Avida::PropertyKey s_genome_prop_name_instset("instset");
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_births("recent_births");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_deaths("recent_deaths");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_breed_true("recent_breed_true");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_breed_in("recent_breed_in");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_breed_out("recent_breed_out");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_recent_gestation_count("recent_gestation_count");
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_total_organisms("total_organisms");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_births("last_births");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_deaths("last_deaths");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_breed_true("last_breed_true");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_breed_in("last_breed_in");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_breed_out("last_breed_out");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_gestation_count("last_gestation_count");
+// Historic Record Packing
+// --------------------------------------------------------------------------------------------------------------
+
+// Records may decode relative to their first parent's record, but never through more than this many ancestors
+static const int MAX_RECORD_DELTA_DEPTH = 16;
+
+// Rough per-property cost of a built property map, used when estimating historic genotype footprints
+static const int PROPERTY_FOOTPRINT = 64;
+
+static void packInt(Avida::Systematics::HistoricGenotypeStore::Record& record, int value)
+{
+  for (int i = 0; i < 4; i++) record.Push((static_cast<unsigned int>(value) >> (8 * i)) & 0xFF);
+}
+
+static void packString(Avida::Systematics::HistoricGenotypeStore::Record& record, const Apto::String& str)
+{
+  packInt(record, str.GetSize());
+  for (int i = 0; i < str.GetSize(); i++) record.Push(static_cast<unsigned char>(str[i]));
+}
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_birth_cell("last_birth_cell");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_group_id("last_group_id");
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_last_forager_type("last_forager_type");
+static int unpackInt(const Avida::Systematics::HistoricGenotypeStore::Record& record, int& pos)
+{
+  unsigned int value = 0;
+  for (int i = 0; i < 4; i++) value |= static_cast<unsigned int>(record[pos++]) << (8 * i);
+  return static_cast<int>(value);
+}
 
-static const Apto::BasicString<Apto::ThreadSafe> s_prop_name_total_gestation_count("total_gestation_count");
+static Apto::String unpackString(const Avida::Systematics::HistoricGenotypeStore::Record& record, int& pos)
+{
+  const int length = unpackInt(record, pos);
+  std::string str;
+  for (int i = 0; i < length; i++) str += static_cast<char>(record[pos++]);
+  return Apto::String(str.c_str());
+}
 
 
 void Avida::Systematics::Genotype::Initialize()
 {
-#define DEFINE_PROP(NAME, DESC) s_prop_desc_map.Set(s_prop_name_ ## NAME, DESC);
+#define DEFINE_PROP(NAME, DESC) s_prop_desc_map.Set(s_prop_name_ ## NAME.ID(), DESC);
   DEFINE_PROP(genome, "Genome");
   DEFINE_PROP(src_transmission_type, "Source Transmission Type");
   DEFINE_PROP(name, "Name");
@@ -147,6 +187,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_last_forager_type(-1)
   , m_task_counts(mgr->NumEnvironmentActionTriggers())
   , m_prop_map(NULL)
+  , m_compact(false)
+  , m_record_delta_depth(0)
+  , m_record_length(0)
+  , m_record_offset(-1)
 {
   AddActiveReference();
   if (parents) {
@@ -202,6 +246,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 , m_last_forager_type(-1)
 , m_task_counts(mgr->NumEnvironmentActionTriggers())
 , m_prop_map(NULL)
+, m_compact(false)
+, m_record_delta_depth(0)
+, m_record_length(0)
+, m_record_offset(-1)
 {
   Apto::Map<Apto::String, Apto::String>& props = *(*static_cast<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >*>(prop_p));
   
@@ -254,6 +302,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 Avida::Systematics::Genotype::~Genotype()
 {  
   delete m_prop_map;
+  releaseRecord();
 }
 
 Avida::Systematics::RoleID Avida::Systematics::Genotype::Role() const
@@ -319,8 +368,18 @@ void Avida::Systematics::Genotype::RemoveUnit()
 }
 
 
+// Historic genotypes may be expanded on whichever thread first asks for their properties, so expansion and the lazy
+// property map setup both happen under the arbiter's historic mutex. Active genotypes are never compacted, and with
+// compaction disabled no genotype is, so those skip the mutex.
 const Avida::PropertyMap& Avida::Systematics::Genotype::Properties() const
 {
+  if (m_active || !m_mgr->compactsHistoric()) {
+    if (!m_prop_map) setupPropertyMap();
+    return *m_prop_map;
+  }
+  
+  Apto::MutexAutoLock lock(m_mgr->m_historic_mutex);
+  if (m_compact) const_cast<Genotype*>(this)->expandRecord();
   if (!m_prop_map) setupPropertyMap();
   return *m_prop_map;
 }
@@ -343,12 +402,21 @@ bool Avida::Systematics::Genotype::Serialize(ArchivePtr) const
 
 bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
 {
+  Apto::MutexAutoLock lock(m_mgr->m_historic_mutex);
+  
+  // Compacted genotypes are written straight from their record, without being expanded
+  Source src(m_src);
+  Genome compact_genome;
+  Apto::String compact_name;
+  if (m_compact) unpackRecord(compact_genome, compact_name, src.arguments);
+  const Genome& genome = (m_compact) ? compact_genome : m_genome;
+  
   Avida::Output::File& df = *static_cast<Avida::Output::File*>(dfp);
   df.Write(m_id, "ID", "id");
   
-  df.Write(m_src.AsString(), "Source", "src");
+  df.Write(src.AsString(), "Source", "src");
   
-  df.Write(m_src.arguments.GetSize() ? (const char*)m_src.arguments : "(none)", "Source Args", "src_args");
+  df.Write(src.arguments.GetSize() ? (const char*)src.arguments : "(none)", "Source Args", "src_args");
   
   cString str("");
   if (m_parents.GetSize()) {
@@ -363,7 +431,7 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   df.Write(m_total_organisms, "Total number of organisms that ever existed", "total_units");
   
   ConstInstructionSequencePtr seq;
-  seq.DynamicCastFrom(m_genome.Representation());
+  seq.DynamicCastFrom(genome.Representation());
   df.Write(seq->GetSize(), "Genome Length", "length");
   
   df.Write(m_merit.Average(), "Average Merit", "merit");
@@ -374,7 +442,7 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   df.Write(m_update_born, "Update Born", "update_born");
   df.Write(m_update_deactivated, "Update Deactivated", "update_deactivated");
   df.Write(m_depth, "Phylogenetic Depth", "depth");
-  m_genome.LegacySave(dfp);
+  genome.LegacySave(dfp);
   
   return false;
 }
@@ -478,15 +546,201 @@ void Avida::Systematics::Genotype::UpdateReset()
 }
 
 
+int Avida::Systematics::Genotype::HistoricFootprint() const
+{
+  int bytes = sizeof(Genotype) + m_parents.GetSize() * sizeof(GenotypePtr);
+  if (m_compact) return bytes + m_record.GetSize();
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_genome.Representation());
+  if (seq) bytes += sizeof(InstructionSequence) + seq->GetSize();
+  bytes += m_name.GetSize() + m_parent_str.GetSize() + m_src.arguments.GetSize();
+  bytes += m_task_counts.GetSize() * sizeof(Apto::Stat::Accumulator<int>);
+  if (m_prop_map) bytes += m_prop_map->GetSize() * PROPERTY_FOOTPRINT;
+  
+  return bytes;
+}
+
+
+const Avida::Genome& Avida::Systematics::Genotype::GroupGenome() const
+{
+  // Called on every birth, so only possibly compacted genotypes take the historic mutex (see Properties)
+  if (m_active || !m_mgr->compactsHistoric()) return m_genome;
+  
+  Apto::MutexAutoLock lock(m_mgr->m_historic_mutex);
+  if (m_compact) const_cast<Genotype*>(this)->expandRecord();
+  return m_genome;
+}
+
+
+void Avida::Systematics::Genotype::Compact(HistoricGenotypeStore* store)
+{
+  Apto::MutexAutoLock lock(m_mgr->m_historic_mutex);
+  if (m_compact || m_active) return;
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_genome.Representation());
+  if (!seq) return;
+  
+  HistoricGenotypeStore::Record record;
+  packInt(record, m_genome.HardwareType());
+  packString(record, m_genome.Properties().Get(s_genome_prop_name_instset).StringValue());
+  packString(record, m_name);
+  packString(record, m_src.arguments);
+  
+  // Encode the sequence as the single span that differs from the first parent's, when that parent is already compact
+  InstructionSequence parent_seq;
+  const bool use_delta = (m_parents.GetSize() && m_parents[0]->m_compact &&
+                          m_parents[0]->m_record_delta_depth < MAX_RECORD_DELTA_DEPTH && m_parents[0]->historicSequence(parent_seq));
+  
+  int prefix = 0;
+  int suffix = 0;
+  if (use_delta) {
+    const int max_common = (seq->GetSize() < parent_seq.GetSize()) ? seq->GetSize() : parent_seq.GetSize();
+    while (prefix < max_common && (*seq)[prefix] == parent_seq[prefix]) prefix++;
+    while (suffix < max_common - prefix &&
+           (*seq)[seq->GetSize() - 1 - suffix] == parent_seq[parent_seq.GetSize() - 1 - suffix]) suffix++;
+  }
+  
+  record.Push(use_delta ? 1 : 0);
+  if (use_delta) {
+    packInt(record, prefix);
+    packInt(record, suffix);
+  }
+  packInt(record, seq->GetSize() - prefix - suffix);
+  for (int i = prefix; i < seq->GetSize() - suffix; i++) record.Push((*seq)[i].GetOp());
+  
+  releaseRecord();
+  m_record_delta_depth = (use_delta) ? m_parents[0]->m_record_delta_depth + 1 : 0;
+  m_record_length = record.GetSize();
+  if (store && store->IsOpen()) m_record_offset = store->Append(record);
+  if (m_record_offset < 0) m_record = record;
+  
+  delete m_prop_map;
+  m_prop_map = NULL;
+  m_genome = Genome();
+  m_name = "";
+  m_parent_str = "";
+  m_src.arguments = "";
+  m_task_counts.ResizeClear(0);
+  m_compact = true;
+}
+
+
+void Avida::Systematics::Genotype::Expand()
+{
+  Apto::MutexAutoLock lock(m_mgr->m_historic_mutex);
+  expandRecord();
+}
+
+
+void Avida::Systematics::Genotype::expandRecord()
+{
+  if (!m_compact) return;
+  
+  if (!unpackRecord(m_genome, m_name, m_src.arguments)) {
+    assert(false);
+    return;
+  }
+  
+  m_parent_str = "";
+  for (int i = 0; i < m_parents.GetSize(); i++) {
+    if (i > 0) m_parent_str += ",";
+    m_parent_str += Apto::AsStr(m_parents[i]->ID());
+  }
+  m_task_counts.ResizeClear(m_mgr->NumEnvironmentActionTriggers());
+  
+  m_compact = false;
+  releaseRecord();
+  m_mgr->m_historic_reexpanded++;
+}
+
+
+bool Avida::Systematics::Genotype::readRecord(HistoricGenotypeStore::Record& record) const
+{
+  if (m_record_offset >= 0) return m_mgr->m_historic_store->Read(m_record_offset, record);
+  
+  record = m_record;
+  return true;
+}
+
+
+void Avida::Systematics::Genotype::releaseRecord()
+{
+  if (m_record_offset >= 0) m_mgr->m_historic_store->Release(m_record_offset, m_record_length);
+  
+  m_record.ResizeClear(0);
+  m_record_offset = -1;
+  m_record_length = 0;
+  m_record_delta_depth = 0;
+}
+
+
+bool Avida::Systematics::Genotype::historicSequence(InstructionSequence& seq) const
+{
+  if (!m_compact) {
+    ConstInstructionSequencePtr cur_seq;
+    cur_seq.DynamicCastFrom(m_genome.Representation());
+    if (!cur_seq) return false;
+    seq = *cur_seq;
+    return true;
+  }
+  
+  Genome genome;
+  Apto::String name, src_args;
+  if (!unpackRecord(genome, name, src_args)) return false;
+  
+  ConstInstructionSequencePtr cur_seq;
+  cur_seq.DynamicCastFrom(genome.Representation());
+  seq = *cur_seq;
+  return true;
+}
+
+
+bool Avida::Systematics::Genotype::unpackRecord(Genome& genome, Apto::String& name, Apto::String& src_args) const
+{
+  HistoricGenotypeStore::Record record;
+  if (!readRecord(record)) return false;
+  
+  int pos = 0;
+  const int hw_type = unpackInt(record, pos);
+  const Apto::String inst_set = unpackString(record, pos);
+  name = unpackString(record, pos);
+  src_args = unpackString(record, pos);
+  
+  const bool use_delta = (record[pos++] != 0);
+  int prefix = 0;
+  int suffix = 0;
+  InstructionSequence parent_seq;
+  if (use_delta) {
+    prefix = unpackInt(record, pos);
+    suffix = unpackInt(record, pos);
+    if (!m_parents.GetSize() || !m_parents[0]->historicSequence(parent_seq)) return false;
+  }
+  const int span = unpackInt(record, pos);
+  
+  InstructionSequence* seq = new InstructionSequence(prefix + span + suffix);
+  for (int i = 0; i < prefix; i++) (*seq)[i] = parent_seq[i];
+  for (int i = 0; i < span; i++) (*seq)[prefix + i].SetOp(record[pos++]);
+  for (int i = 0; i < suffix; i++) (*seq)[prefix + span + i] = parent_seq[parent_seq.GetSize() - suffix + i];
+  
+  HashPropertyMap prop_map;
+  cHardwareManager::SetupPropertyMap(prop_map, inst_set);
+  genome = Genome(hw_type, prop_map, GeneticRepresentationPtr(seq));
+  return true;
+}
+
+
 void Avida::Systematics::Genotype::setupPropertyMap() const
 {
   if (m_prop_map) return;
 
-  m_prop_map = new HashPropertyMap();
+  SlotPropertyMap* prop_map = new SlotPropertyMap();
+  m_prop_map = prop_map;
   
-#define ADD_FUN_PROP(NAME, TYPE, VAL) m_prop_map->Define(PropertyPtr(new FunctorProperty<TYPE>(s_prop_name_ ## NAME, s_prop_desc_map, FunctorProperty<TYPE>::VAL)));
-#define ADD_REF_PROP(NAME, TYPE, VAL) m_prop_map->Define(PropertyPtr(new ReferenceProperty<TYPE>(s_prop_name_ ## NAME, s_prop_desc_map, const_cast<TYPE&>(VAL))));
-#define ADD_STR_PROP(NAME, VAL) m_prop_map->Define(PropertyPtr(new StringProperty(s_prop_name_ ## NAME, s_prop_desc_map, VAL)));
+#define ADD_FUN_PROP(NAME, TYPE, VAL) prop_map->Define(s_prop_name_ ## NAME, PropertyPtr(new FunctorProperty<TYPE>(s_prop_name_ ## NAME.ID(), s_prop_desc_map, FunctorProperty<TYPE>::VAL)));
+#define ADD_REF_PROP(NAME, TYPE, VAL) prop_map->Define(s_prop_name_ ## NAME, PropertyPtr(new ReferenceProperty<TYPE>(s_prop_name_ ## NAME.ID(), s_prop_desc_map, const_cast<TYPE&>(VAL))));
+#define ADD_STR_PROP(NAME, VAL) prop_map->Define(s_prop_name_ ## NAME, PropertyPtr(new StringProperty(s_prop_name_ ## NAME.ID(), s_prop_desc_map, VAL)));
   
   ADD_FUN_PROP(genome, Apto::String, GetFunctor(&m_genome, &Genome::AsString));
   ADD_STR_PROP(src_transmission_type, (int)m_src.transmission_type);
@@ -527,7 +781,7 @@ void Avida::Systematics::Genotype::setupPropertyMap() const
 
   // Collect all relevant action trigger counts
   for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
-    m_prop_map->Define(PropertyPtr(new FunctorProperty<double>(m_mgr->EnvironmentActionTriggerAverageIDs()[i], s_prop_desc_map, FunctorProperty<double>::GetFunctor(&m_task_counts[i], &Apto::Stat::Accumulator<int>::Mean))));
+    prop_map->Define(PropertyPtr(new FunctorProperty<double>(m_mgr->EnvironmentActionTriggerAverageIDs()[i], s_prop_desc_map, FunctorProperty<double>::GetFunctor(&m_task_counts[i], &Apto::Stat::Accumulator<int>::Mean))));
   }
   
 #undef ADD_FUN_PROP
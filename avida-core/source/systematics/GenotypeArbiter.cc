@@ -36,11 +36,15 @@
 #include <cmath>
 
 
-Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class)
+Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class,
+                                                     int historic_memory, const Apto::String& historic_store_path)
   : Arbiter(role)
   , m_threshold(threshold)
   , m_disable_class(disable_class)
+  , m_historic_memory(historic_memory)
   , m_active_sz(1)
+  , m_historic_store(NULL)
+  , m_historic_reexpanded(0)
   , m_coalescent(NULL)
   , m_best(0)
   , m_next_id(1)
@@ -60,6 +64,9 @@ Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID&
     m_env_action_count[idx] = Apto::FormatStr("environment.triggers.%s.count", (const char*)*it.Get());
   }
   setupProvidedData(world);
+  
+  // Without a usable store file, compacted records simply stay in memory
+  if (m_historic_memory > 0 && historic_store_path.GetSize()) m_historic_store = new HistoricGenotypeStore(historic_store_path);
 }
 
 Avida::Systematics::GenotypeArbiter::~GenotypeArbiter()
@@ -73,6 +80,8 @@ Avida::Systematics::GenotypeArbiter::~GenotypeArbiter()
   
   assert(m_historic.GetSize() == 0);
   assert(m_best == 0);
+  
+  delete m_historic_store;
 }
 
 
@@ -100,6 +109,8 @@ void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context&, Update current
 
   Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
   while (list_it.Next() != NULL) if (!(*list_it.Get())->ReferenceCount()) removeGenotype(*list_it.Get());
+  
+  if (m_historic_memory > 0) compactHistoric();
 }
 
 void Avida::Systematics::GenotypeArbiter::PrintListStatus()
@@ -308,6 +319,7 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
       while (list_it.Next() != NULL) {
         if ((*list_it.Get())->ID() == gid) {
           found = *list_it.Get();
+          found->Expand();
           seq.DynamicCastFrom(found->GroupGenome().Representation());
           assert(seq);
           
@@ -559,6 +571,35 @@ void Avida::Systematics::GenotypeArbiter::updateCoalescent()
 }
 
 
+void Avida::Systematics::GenotypeArbiter::compactHistoric()
+{
+  // The most recently deactivated genotypes stay expanded within the memory budget. The rest are compacted oldest
+  // first, so that each is usually encoded relative to an already compacted parent.
+  const long long budget = static_cast<long long>(m_historic_memory) * 1024;
+  long long used = 0;
+  
+  // Deactivated genotypes are pushed on the front of the historic list, so after a pass every genotype behind the
+  // first compacted one is compacted too. Only when some were expanded again since does the whole list need a scan.
+  Apto::Array<GenotypePtr> to_compact;
+  m_historic_mutex.Lock();
+  const bool full_scan = (m_historic_reexpanded > 0);
+  m_historic_reexpanded = 0;
+  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) {
+    GenotypePtr genotype = *list_it.Get();
+    if (genotype->IsCompact()) {
+      if (full_scan) continue;
+      break;
+    }
+    used += genotype->HistoricFootprint();
+    if (used > budget) to_compact.Push(genotype);
+  }
+  m_historic_mutex.Unlock();
+  
+  for (int i = to_compact.GetSize() - 1; i >= 0; i--) to_compact[i]->Compact(m_historic_store);
+}
+
+
 inline Avida::Systematics::GenotypeArbiterPtr Avida::Systematics::GenotypeArbiter::thisPtr()
 {
   AddReference(); // Explicitly add reference for newly created SmartPtr
@@ -0,0 +1,131 @@
+/*
+ *  systematics/HistoricGenotypeStore.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/systematics/HistoricGenotypeStore.h"
+
+
+Avida::Systematics::HistoricGenotypeStore::HistoricGenotypeStore(const Apto::String& path)
+  : m_path(path), m_file(NULL), m_size(0), m_live_bytes(0), m_live_records(0)
+{
+  m_file = fopen((const char*)m_path, "w+b");
+}
+
+Avida::Systematics::HistoricGenotypeStore::~HistoricGenotypeStore()
+{
+  if (m_file) {
+    fclose(m_file);
+    remove((const char*)m_path);
+  }
+}
+
+
+long long Avida::Systematics::HistoricGenotypeStore::Append(const Record& record)
+{
+  if (!m_file) return -1;
+  
+  // Each record is prefixed by its length, little endian
+  const unsigned int length = record.GetSize();
+  unsigned char header[4];
+  for (int i = 0; i < 4; i++) header[i] = (length >> (8 * i)) & 0xFF;
+  
+  // First fit into released space, falling back to the end of the file
+  int slot = 0;
+  while (slot < m_free.GetSize() && m_free[slot].length < 4 + length) slot++;
+  const long long offset = (slot < m_free.GetSize()) ? m_free[slot].offset : m_size;
+  
+  if (fseek(m_file, offset, SEEK_SET) != 0) return -1;
+  if (fwrite(header, 1, 4, m_file) != 4) return -1;
+  if (length && fwrite(&record[0], 1, length, m_file) != length) return -1;
+  
+  if (slot < m_free.GetSize()) {
+    m_free[slot].offset += 4 + length;
+    m_free[slot].length -= 4 + length;
+    if (!m_free[slot].length) {
+      for (int i = slot + 1; i < m_free.GetSize(); i++) m_free[i - 1] = m_free[i];
+      m_free.Resize(m_free.GetSize() - 1);
+    }
+  } else {
+    m_size += 4 + length;
+  }
+  m_live_bytes += 4 + length;
+  m_live_records++;
+  return offset;
+}
+
+
+bool Avida::Systematics::HistoricGenotypeStore::Read(long long offset, Record& record) const
+{
+  if (!m_file || offset < 0 || offset >= m_size) return false;
+  
+  // Repositioning also satisfies stdio's requirement between a write and a following read
+  if (fseek(m_file, offset, SEEK_SET) != 0) return false;
+  
+  unsigned char header[4];
+  if (fread(header, 1, 4, m_file) != 4) return false;
+  unsigned int length = 0;
+  for (int i = 0; i < 4; i++) length |= static_cast<unsigned int>(header[i]) << (8 * i);
+  
+  record.ResizeClear(length);
+  if (length && fread(&record[0], 1, length, m_file) != length) return false;
+  return true;
+}
+
+
+void Avida::Systematics::HistoricGenotypeStore::Release(long long offset, int length)
+{
+  if (offset < 0) return;
+  m_live_bytes -= 4 + length;
+  m_live_records--;
+  freeExtent(offset, 4 + length);
+}
+
+
+void Avida::Systematics::HistoricGenotypeStore::freeExtent(long long offset, long long length)
+{
+  int slot = 0;
+  while (slot < m_free.GetSize() && m_free[slot].offset < offset) slot++;
+  
+  // Merge with the neighbouring free extents where they touch, otherwise insert in offset order
+  const bool join_prev = (slot > 0 && m_free[slot - 1].offset + m_free[slot - 1].length == offset);
+  const bool join_next = (slot < m_free.GetSize() && offset + length == m_free[slot].offset);
+  if (join_prev && join_next) {
+    m_free[slot - 1].length += length + m_free[slot].length;
+    for (int i = slot + 1; i < m_free.GetSize(); i++) m_free[i - 1] = m_free[i];
+    m_free.Resize(m_free.GetSize() - 1);
+    slot--;
+  } else if (join_prev) {
+    m_free[--slot].length += length;
+  } else if (join_next) {
+    m_free[slot].offset = offset;
+    m_free[slot].length += length;
+  } else {
+    m_free.Resize(m_free.GetSize() + 1);
+    for (int i = m_free.GetSize() - 1; i > slot; i--) m_free[i] = m_free[i - 1];
+    m_free[slot].offset = offset;
+    m_free[slot].length = length;
+  }
+  
+  // Space freed at the end of the file is simply overwritten by later appends
+  if (slot == m_free.GetSize() - 1 && m_free[slot].offset + m_free[slot].length == m_size) {
+    m_size = m_free[slot].offset;
+    m_free.Resize(slot);
+  }
+}
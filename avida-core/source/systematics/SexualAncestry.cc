@@ -27,6 +27,8 @@
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 
+static const Avida::PropertyKey s_prop_id_parents("parents");
+
 const Apto::String Avida::Systematics::SexualAncestry::ObjectKey("Avida::Systematics::SexualAncestry");
 
 Avida::Systematics::SexualAncestry::SexualAncestry(GroupPtr g)
@@ -39,11 +41,11 @@ Avida::Systematics::SexualAncestry::SexualAncestry(GroupPtr g)
   m_ancestor_ids[4] = -1;
   m_ancestor_ids[5] = -1;
   
-  if (!g->Properties().Has("parents")) return;
+  if (!g->Properties().Has(s_prop_id_parents)) return;
   
   ArbiterPtr arbiter = g->Arbiter();
   Apto::Array<GroupPtr> parents;
-  Apto::String parent_str(g->Properties().Get("parents").StringValue());
+  Apto::String parent_str(g->Properties().Get(s_prop_id_parents).StringValue());
   while (parent_str.GetSize()) {
     parents.Push(arbiter->Group(Apto::StrAs(parent_str.Pop(','))));
   }
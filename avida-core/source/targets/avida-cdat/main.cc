@@ -0,0 +1,90 @@
+/*
+ *  targets/avida-cdat/main.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Converts a columnar data file (.cdat) back into the standard text data file format
+
+#include "avida/output/Columnar.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+static void printUsage(const char* name)
+{
+  std::cerr << "usage: " << name << " input.cdat [output.dat] [-u first_update]" << std::endl;
+  std::cerr << "  Writes the data file in text format to output.dat, or standard output if not specified." << std::endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+  const char* input = NULL;
+  const char* output = NULL;
+  long long first_update = -1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+      first_update = atoll(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      printUsage(argv[0]);
+      return 1;
+    } else if (!input) {
+      input = argv[i];
+    } else if (!output) {
+      output = argv[i];
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!input) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  Avida::Output::ColumnarReader reader;
+  if (!reader.Open(input)) {
+    std::cerr << "error: unable to read columnar data file '" << input << "'" << std::endl;
+    return 1;
+  }
+
+  bool success = false;
+  if (output) {
+    std::ofstream fp(output);
+    if (!fp.good()) {
+      std::cerr << "error: unable to open '" << output << "' for writing" << std::endl;
+      return 1;
+    }
+    success = reader.WriteText(fp, first_update);
+  } else {
+    success = reader.WriteText(std::cout, first_update);
+  }
+
+  if (!success) {
+    std::cerr << "error: failed writing text output" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ *  targets/avida-trace/main.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Converts a binary mini trace (.trcb) back into the text mini trace format
+
+#include "cMiniTrace.h"
+
+#include <fstream>
+#include <iostream>
+
+
+static void printUsage(const char* name)
+{
+  std::cerr << "usage: " << name << " input.trcb [output.trc]" << std::endl;
+  std::cerr << "  Writes the mini trace in text format to output.trc, or standard output if not specified." << std::endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3 || argv[1][0] == '-') {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const char* input = argv[1];
+  const char* output = (argc == 3) ? argv[2] : NULL;
+
+  std::ifstream in(input, std::ios::in | std::ios::binary);
+  if (!in.good()) {
+    std::cerr << "error: unable to open '" << input << "'" << std::endl;
+    return 1;
+  }
+
+  bool success = false;
+  if (output) {
+    std::ofstream fp(output);
+    if (!fp.good()) {
+      std::cerr << "error: unable to open '" << output << "' for writing" << std::endl;
+      return 1;
+    }
+    success = cMiniTrace::DecodeBinary(in, fp);
+  } else {
+    success = cMiniTrace::DecodeBinary(in, std::cout);
+  }
+
+  if (!success) {
+    std::cerr << "error: '" << input << "' is not a complete binary mini trace" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -20,6 +20,8 @@
 
 #include "cTextViewerDriver_Base.h"
 
+#include "avida/output/Manager.h"
+
 #include "cAnalyze.h"
 #include "cString.h"
 #include "cStringList.h"
@@ -40,6 +42,7 @@ cTextViewerDriver_Base::~cTextViewerDriver_Base()
 
 void cTextViewerDriver_Base::Abort(AbortCondition condition)
 {
+  Output::Manager::Of(m_world->GetNewWorld())->FlushAll();
   exit(condition);
 }
 
@@ -26,6 +26,7 @@
 
 #include "avida/core/Context.h"
 #include "avida/core/World.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Group.h"
 
 #include "cAnalyze.h"
@@ -35,6 +36,7 @@
 #include "cOrganism.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
+#include "cProfiler.h"
 #include "cStats.h"
 #include "cWorld.h"
 
@@ -68,6 +70,7 @@ void Avida2Driver::Run()
     cAnalyze& analyze = m_world->GetAnalyze();
     analyze.RunFile(m_world->GetConfig().ANALYZE_FILE.Get());
     if (m_world->GetConfig().ANALYZE_MODE.Get() == 2) analyze.RunInteractive();
+    Output::Manager::Of(m_new_world)->FlushAll();
     return;
   }
   
@@ -87,20 +90,28 @@ void Avida2Driver::Run()
   
   cAvidaContext& ctx = m_world->GetDefaultContext();
   Avida::Context new_ctx(this, &m_world->GetRandom());
+  cProfiler& profiler = m_world->GetProfiler();
+  cProfileDataManagerTimer data_manager_timer(profiler, m_new_world->DataManager());
   
   while (!m_done) {
+    profiler.BeginPhase(PROFILE_PHASE_EVENTS);
     m_world->GetEvents(ctx);
+    profiler.EndPhase(PROFILE_PHASE_EVENTS);
     if(m_done == true) break;
     
     // Increment the Update.
     stats.IncCurrentUpdate();
     
+    profiler.BeginPhase(PROFILE_PHASE_PRE_UPDATE);
     population.ProcessPreUpdate();
+    profiler.EndPhase(PROFILE_PHASE_PRE_UPDATE);
 
     // Handle all data collection for previous update.
     if (stats.GetUpdate() > 0) {
       // Tell the stats object to do update calculations and printing.
+      profiler.BeginPhase(PROFILE_PHASE_STATS);
       stats.ProcessUpdate();
+      profiler.EndPhase(PROFILE_PHASE_STATS);
     }
     
     // Process the update.
@@ -108,20 +119,25 @@ void Avida2Driver::Run()
     const int UD_size = m_world->CalculateUpdateSize();
     const double step_size = 1.0 / (double) UD_size;
     
+    profiler.BeginPhase(PROFILE_PHASE_INSTRUCTIONS);
     for (int i = 0; i < UD_size; i++) {
       if(population.GetNumOrganisms() == 0) {
         break;
       }
       (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
     }
+    profiler.EndPhase(PROFILE_PHASE_INSTRUCTIONS);
     
     // end of update stats...
+    profiler.BeginPhase(PROFILE_PHASE_POST_UPDATE);
     population.ProcessPostUpdate(ctx);
     
 		m_world->ProcessPostUpdate(ctx);
+    profiler.EndPhase(PROFILE_PHASE_POST_UPDATE);
         
     // No viewer; print out status for this update....
     if (m_world->GetVerbosity() > VERBOSE_SILENT) {
+      cProfilePhaseTimer output_timer(profiler, PROFILE_PHASE_OUTPUT);
       cout.setf(ios::left);
       cout.setf(ios::showpoint);
       cout << "UD: " << setw(6) << stats.GetUpdate() << "  ";
@@ -145,6 +161,7 @@ void Avida2Driver::Run()
     
     // Do Point Mutations
     if (point_mut_prob > 0 ) {
+      cProfilePhaseTimer mutation_timer(profiler, PROFILE_PHASE_POST_UPDATE);
       for (int i = 0; i < population.GetSize(); i++) {
         if (population.GetCell(i).IsOccupied()) {
           int num_mut = population.GetCell(i).GetOrganism()->GetHardware().PointMutate(ctx);
@@ -153,17 +170,23 @@ void Avida2Driver::Run()
       }
     }
     
-    m_new_world->PerformUpdate(new_ctx, stats.GetUpdate());
+    m_new_world->PerformUpdate(new_ctx, stats.GetUpdate(), profiler.IsEnabled() ? &data_manager_timer : NULL);
+    
+    profiler.EndUpdate();
     
     // Exit conditons...
     if((population.GetNumOrganisms()==0) && m_world->AllowsEarlyExit()) {
 			m_done = true;
 		}
   }
+  
+  // Output files may be held by objects that are never destroyed, make sure buffered data reaches disk
+  Output::Manager::Of(m_new_world)->FlushAll();
 }
 
 void Avida2Driver::Abort(Avida::AbortCondition condition)
 {
+  Output::Manager::Of(m_new_world)->FlushAll();
   exit(condition);
 }
 
@@ -308,6 +308,112 @@ protected:
     ReportTestResult("Chained Bitwise Operations", ((~ba & ~ba2).CountBits() == 31));
     ReportTestResult("++operator", ((++(~ba & ~ba2)).CountBits() == 30));
     ReportTestResult("operator++", (((~ba & ~ba2)++).CountBits() == 31));
+
+    ReportTestResult("CountBitsAND", (ba.CountBitsAND(ba2) == 8));
+    ReportTestResult("CountBitsXOR", (ba.CountBitsXOR(ba2) == 35));
+    ReportTestResult("IsSubsetOf", ((ba & ba2).IsSubsetOf(ba) && !ba.IsSubsetOf(ba2)));
+    ReportTestResult("HasOverlap", (ba.HasOverlap(ba2) && !ba.HasOverlap(~ba)));
+
+    cBitArray mask(16);
+    mask[3] = true;
+    mask[13] = true;
+    ReportTestResult("IsSubsetOf (shorter mask)", (mask.IsSubsetOf(ba) && !mask.IsSubsetOf(ba2)));
+    ReportTestResult("HasOverlap (shorter mask)", (mask.HasOverlap(ba) && !mask.HasOverlap(~ba)));
+
+    ReportTestResult("FindBit1", (ba.FindBit1() == 3 && ba.FindBit1(4) == 8 && ba.FindBit1(70) == 73 && ba.FindBit1(74) == -1));
+    Apto::Array<int> ones = ba.GetOnes();
+    ReportTestResult("GetOnes", (ones.GetSize() == 15 && ones[0] == 3 && ones[14] == 73));
+  }
+};
+
+
+#include "avida/output/Columnar.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+class cColumnarTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "Output::Columnar"; }
+protected:
+  void RunTests()
+  {
+    using namespace Avida::Output;
+    
+    // A flush after the first 101 rows, a full block, then the rest at close: three blocks in all
+    const char* path = "unit-tests-columnar.cdat";
+    const int num_rows = COLUMNAR_BLOCK_ROWS + 200;
+    writeFile(path, num_rows, true);
+    
+    ColumnarReader reader;
+    bool result = reader.Open(path);
+    ReportTestResult("Open", result);
+    
+    result = (reader.FileType() == "test_data" && reader.NumColumns() == 3 && reader.TypeOfColumn(0) == COLUMN_INT &&
+              reader.TypeOfColumn(1) == COLUMN_DOUBLE && reader.TypeOfColumn(2) == COLUMN_STRING &&
+              reader.ColumnDescription(1) == "Value");
+    ReportTestResult("Header and columns", result);
+    ReportTestResult("Rows and blocks", (reader.NumRows() == num_rows && reader.NumBlocks() == 3));
+    
+    result = true;
+    int rows_read = 0;
+    while (reader.NextRow()) {
+      if (reader.IntValue(0) != rows_read * 10 || reader.DoubleValue(1) != rows_read * 0.5 - 3.0 ||
+          reader.StringValue(2) != ((rows_read % 2) ? "odd" : "even")) {
+        result = false;
+        break;
+      }
+      rows_read++;
+    }
+    ReportTestResult("Row values", (result && rows_read == num_rows));
+    
+    result = (reader.SeekUpdate(20000) && reader.NextRow() && reader.IntValue(0) == 20000);
+    ReportTestResult("SeekUpdate", result);
+    
+    ReportTestResult("Single index record", (countRecords(path, "INDX") == 1 && countRecords(path, "TAIL") == 1));
+    
+    // Without Close there is no index; the reader rebuilds it from the block records
+    writeFile(path, num_rows, false);
+    ColumnarReader unclosed;
+    result = (unclosed.Open(path) && unclosed.NumRows() == num_rows && countRecords(path, "INDX") == 0);
+    ReportTestResult("Unclosed file", result);
+    
+    remove(path);
+  }
+  
+private:
+  void writeFile(const char* path, int num_rows, bool close)
+  {
+    std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    Avida::Output::ColumnarEncoder encoder(out);
+    encoder.SetHeader("test_data", "update value parity", "# Columnar round trip\n");
+    for (int i = 0; i < num_rows; i++) {
+      encoder.Int(i * 10);
+      if (i == 0) encoder.DescribeColumn("Update", "update");
+      encoder.Double(i * 0.5 - 3.0);
+      if (i == 0) encoder.DescribeColumn("Value", "value");
+      encoder.String((i % 2) ? "odd" : "even");
+      if (i == 0) encoder.DescribeColumn("Parity", "parity");
+      encoder.EndRow();
+      if (i == 100) encoder.Flush();
+    }
+    if (close) encoder.Close();
+    else encoder.Flush();
+  }
+  
+  // Walks the record chain following the 8 byte magic, counting records with the given tag
+  int countRecords(const char* path, const char* tag)
+  {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    in.seekg(8);
+    int count = 0;
+    unsigned char prefix[8];
+    while (in.read((char*)prefix, sizeof(prefix))) {
+      if (memcmp(prefix, tag, 4) == 0) count++;
+      const unsigned int length = prefix[4] | (prefix[5] << 8) | (prefix[6] << 16) | ((unsigned int)prefix[7] << 24);
+      in.seekg(length, std::ios::cur);
+    }
+    return count;
   }
 };
 
@@ -333,6 +439,7 @@ int main(int argc, const char* argv[])
   
   TEST(cRawBitArray);
   TEST(cBitArray);
+  TEST(cColumnar);
   
   if (failed == 0)
     cout << "All unit tests passed." << endl;
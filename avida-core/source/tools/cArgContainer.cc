@@ -24,6 +24,7 @@
 #include "avida/core/Feedback.h"
 
 #include "cArgSchema.h"
+#include "cStringIterator.h"
 
 using namespace Avida;
 
@@ -47,7 +48,8 @@ cArgContainer* cArgContainer::Load(cString args, const cArgSchema& schema, Feedb
   Apto::String arg_name;
   bool success = true;
 
-  arg_ent = args.Pop(schema.GetEntrySeparator());
+  cStringTokenizer entries(args, schema.GetEntrySeparator());
+  arg_ent = entries.Next();
   while (arg_ent.GetSize() > 0) {
     arg_name = arg_ent.Pop(schema.GetValueSeparator());
     schema.AdjustArgName(arg_name);
@@ -93,7 +95,7 @@ cArgContainer* cArgContainer::Load(cString args, const cArgSchema& schema, Feedb
       success = false;
       feedback.Error("unrecognized argument: '%s'", static_cast<const char*>(arg_name));
     }
-    arg_ent = args.Pop(schema.GetEntrySeparator());
+    arg_ent = entries.Next();
   }
   
   for (int i = 0; i < set_ints.GetSize(); i++) {
@@ -1,5 +1,32 @@
 #include "cBitArray.h"
 
+
+namespace {
+  inline int countFieldBits(unsigned int v)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0xF0F0F0F) * 0x1010101) >> 24;
+#endif
+  }
+  
+  inline int lowestFieldBit(unsigned int v)
+  {
+    assert(v != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(v);
+#else
+    int pos = 0;
+    while ((v & 1) == 0) { v >>= 1; pos++; }
+    return pos;
+#endif
+  }
+};
+
+
 void cRawBitArray::Copy(const cRawBitArray & in_array, const int num_bits)
 {
   const int num_fields = GetNumFields(num_bits);
@@ -107,36 +134,86 @@ int cRawBitArray::CountBits2(const int num_bits) const
   int bit_count = 0;
   
   for (int i = 0; i < num_fields; i++) {
-    const int  v = bit_fields[i];
-    unsigned int const t1 = v - ((v >> 1) & 0x55555555);
-    unsigned int const t2 = (t1 & 0x33333333) + ((t1 >> 2) & 0x33333333);
-    bit_count += ((t2 + (t2 >> 4) & 0xF0F0F0F) * 0x1010101) >> 24;
+    bit_count += countFieldBits(bit_fields[i]);
   }
   return bit_count;
 }
 
 int cRawBitArray::FindBit1(const int num_bits, const int start_pos) const
 {
-  // @CAO -- There are probably better ways to do this with bit tricks.
-  for (int i = start_pos; i < num_bits; i++) {
-    if (GetBit(i) == true) return i;
+  if (start_pos >= num_bits) return -1;
+  
+  // Skip whole fields of zeros, then take the lowest set bit of the first nonzero one
+  const int num_fields = GetNumFields(num_bits);
+  int field_id = GetField(start_pos);
+  unsigned int field = bit_fields[field_id] & (~0u << GetFieldPos(start_pos));
+  while (field == 0) {
+    if (++field_id == num_fields) return -1;
+    field = bit_fields[field_id];
   }
-
-  return -1;
+  
+  const int pos = (field_id << 5) + lowestFieldBit(field);
+  return (pos < num_bits) ? pos : -1;
 }
 
 Apto::Array<int> cRawBitArray::GetOnes(const int num_bits) const
 {
-  // @CAO -- There are probably better ways to do this with bit tricks.
   Apto::Array<int> out_array(CountBits2(num_bits));
   int cur_pos = 0;
-  for (int i = 0; i < num_bits; i++) {
-    if (GetBit(i) == true) out_array[cur_pos++] = i;
+  const int num_fields = GetNumFields(num_bits);
+  for (int field_id = 0; field_id < num_fields; field_id++) {
+    unsigned int field = bit_fields[field_id];
+    while (field != 0) {
+      out_array[cur_pos++] = (field_id << 5) + lowestFieldBit(field);
+      field &= field - 1;
+    }
   }
 
   return out_array;
 }
 
+int cRawBitArray::CountBitsAND(const cRawBitArray & array2, const int num_bits) const
+{
+  const int num_fields = GetNumFields(num_bits);
+  int bit_count = 0;
+  for (int i = 0; i < num_fields; i++) {
+    bit_count += countFieldBits(bit_fields[i] & array2.bit_fields[i]);
+  }
+  return bit_count;
+}
+
+int cRawBitArray::CountBitsXOR(const cRawBitArray & array2, const int num_bits) const
+{
+  const int num_fields = GetNumFields(num_bits);
+  int bit_count = 0;
+  for (int i = 0; i < num_fields; i++) {
+    bit_count += countFieldBits(bit_fields[i] ^ array2.bit_fields[i]);
+  }
+  return bit_count;
+}
+
+bool cRawBitArray::IsSubsetOf(const cRawBitArray & array2, const int num_bits) const
+{
+  const int num_fields = GetNumFields(num_bits);
+  for (int i = 0; i < num_fields; i++) {
+    if (bit_fields[i] & ~array2.bit_fields[i]) return false;
+  }
+  return true;
+}
+
+// The last field of array2 may hold bits past num_bits, so mask them off
+bool cRawBitArray::HasOverlap(const cRawBitArray & array2, const int num_bits) const
+{
+  const int num_fields = GetNumFields(num_bits);
+  if (num_fields == 0) return false;
+  for (int i = 0; i < num_fields - 1; i++) {
+    if (bit_fields[i] & array2.bit_fields[i]) return true;
+  }
+  const int last_bit = GetFieldPos(num_bits);
+  const unsigned int last_mask = (last_bit > 0) ? ((1u << last_bit) - 1) : ~0u;
+  return (bit_fields[num_fields - 1] & array2.bit_fields[num_fields - 1] & last_mask) != 0;
+}
+
 void cRawBitArray::ShiftLeft(const int num_bits, const int shift_size)
 {
   assert(shift_size > 0);
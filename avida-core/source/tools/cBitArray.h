@@ -45,6 +45,10 @@ using namespace std;
 //  int CountBits()   -- Count 1s -- fast for sparse arrays.
 //  int CountBits2()  -- Count 1s -- fast for arbitary arrays.
 //  int FindBit1(int start_bit)   -- Return pos of first 1 after start_bit 
+//  int CountBitsAND(const cBitArray & array2) const  -- Count 1s in the AND, without building it
+//  int CountBitsXOR(const cBitArray & array2) const  -- Count 1s in the XOR (Hamming distance)
+//  bool IsSubsetOf(const cBitArray & array2) const   -- Is every 1 here also 1 in array2?
+//  bool HasOverlap(const cBitArray & array2) const   -- Is any 1 here also 1 in array2?
 
 // Boolean math functions:
 //  cBitArray NOT() const
@@ -178,6 +182,13 @@ public:
   // Other bit-play
   int FindBit1(const int num_bits, const int start_pos) const;
   Apto::Array<int> GetOnes(const int num_bits) const;
+
+  // Word-at-a-time comparisons against a second array; array2 must hold at least num_bits bits
+  int CountBitsAND(const cRawBitArray & array2, const int num_bits) const;
+  int CountBitsXOR(const cRawBitArray & array2, const int num_bits) const;
+  bool IsSubsetOf(const cRawBitArray & array2, const int num_bits) const;
+  bool HasOverlap(const cRawBitArray & array2, const int num_bits) const;
+
   void ShiftLeft(const int num_bits, const int shift_size); // Helper: call SHIFT with positive number instead
   void ShiftRight(const int num_bits, const int shift_size); // Helper: call SHIFT with negative number instead
 
@@ -309,6 +320,24 @@ public:
     { return bit_array.FindBit1(array_size, start_bit); }
   Apto::Array<int> GetOnes() const { return bit_array.GetOnes(array_size); }
 
+  // Set comparisons, a word at a time...
+  int CountBitsAND(const cBitArray & array2) const {
+    assert(array_size == array2.array_size);
+    return bit_array.CountBitsAND(array2.bit_array, array_size);
+  }
+  int CountBitsXOR(const cBitArray & array2) const {
+    assert(array_size == array2.array_size);
+    return bit_array.CountBitsXOR(array2.bit_array, array_size);
+  }
+  // array2 may be longer than this array (e.g., a mask over the lowest ids)
+  bool IsSubsetOf(const cBitArray & array2) const {
+    assert(array_size <= array2.array_size);
+    return bit_array.IsSubsetOf(array2.bit_array, array_size);
+  }
+  bool HasOverlap(const cBitArray & array2) const {
+    return bit_array.HasOverlap(array2.bit_array, (array_size < array2.array_size) ? array_size : array2.array_size);
+  }
+
   // Boolean math functions...
   cBitArray NOT() const {
     cBitArray out_array;
@@ -0,0 +1,191 @@
+/*
+ *  cCheckpoint.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCheckpoint.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+
+static const char CHECKPOINT_MAGIC[8] = { 'A', 'V', 'I', 'D', 'A', 'C', 'K', 'P' };
+static const unsigned int CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+
+cCheckpointWriter::cCheckpointWriter() : m_section_start(0)
+{
+  // Reserve enough space for a modest population up front to limit regrowth
+  m_buffer.reserve(1 << 20);
+  writeRaw(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  WriteUInt(CHECKPOINT_FORMAT_VERSION);
+  WriteUInt(CHECKPOINT_BYTE_ORDER);
+}
+
+void cCheckpointWriter::BeginSection(unsigned int tag)
+{
+  WriteUInt(tag);
+
+  // Length placeholder, patched in EndSection
+  m_section_start = m_buffer.size();
+  unsigned long long len = 0;
+  writeRaw(&len, sizeof(len));
+}
+
+void cCheckpointWriter::EndSection()
+{
+  assert(m_section_start > 0);
+  unsigned long long len = m_buffer.size() - m_section_start - sizeof(len);
+  memcpy(&m_buffer[m_section_start], &len, sizeof(len));
+  m_section_start = 0;
+}
+
+void cCheckpointWriter::WriteString(const char* str)
+{
+  const int len = (str) ? strlen(str) : 0;
+  WriteInt(len);
+  if (len) writeRaw(str, len);
+}
+
+void cCheckpointWriter::WriteIntArray(const Apto::Array<int>& arr)
+{
+  WriteInt(arr.GetSize());
+  for (int i = 0; i < arr.GetSize(); i++) WriteInt(arr[i]);
+}
+
+void cCheckpointWriter::WriteDoubleArray(const Apto::Array<double>& arr)
+{
+  WriteInt(arr.GetSize());
+  for (int i = 0; i < arr.GetSize(); i++) WriteDouble(arr[i]);
+}
+
+bool cCheckpointWriter::WriteToFile(const cString& filename) const
+{
+  // Write to a temporary file and rename, so that a preempted write never clobbers the previous checkpoint
+  cString tmp_filename(filename);
+  tmp_filename += ".tmp";
+
+  ofstream fp((const char*)tmp_filename, ios::out | ios::binary | ios::trunc);
+  if (!fp.good()) return false;
+
+  fp.write(&m_buffer[0], m_buffer.size());
+  fp.close();
+  if (fp.fail()) return false;
+
+  return (rename((const char*)tmp_filename, (const char*)filename) == 0);
+}
+
+
+
+bool cCheckpointReader::Open(const cString& filename)
+{
+  ifstream fp((const char*)filename, ios::in | ios::binary);
+  if (!fp.good()) return false;
+
+  fp.seekg(0, ios::end);
+  const streamoff file_size = fp.tellg();
+  fp.seekg(0, ios::beg);
+  if (file_size < (streamoff)(sizeof(CHECKPOINT_MAGIC) + 2 * sizeof(unsigned int))) return false;
+
+  m_buffer.resize(file_size);
+  fp.read(&m_buffer[0], file_size);
+  if (fp.fail()) return false;
+
+  m_pos = 0;
+  m_section_end = m_buffer.size();
+  m_error = false;
+
+  char magic[sizeof(CHECKPOINT_MAGIC)];
+  readRaw(magic, sizeof(magic));
+  if (memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) return false;
+  if (ReadUInt() != CHECKPOINT_FORMAT_VERSION) return false;
+  if (ReadUInt() != CHECKPOINT_BYTE_ORDER) return false;
+
+  // No section is active until the first call to NextSection
+  m_section_end = m_pos;
+
+  return Good();
+}
+
+bool cCheckpointReader::NextSection(unsigned int& tag)
+{
+  if (m_error) return false;
+
+  // Skip any unread remainder of the current section
+  m_pos = m_section_end;
+
+  unsigned long long len = 0;
+  if (m_pos + sizeof(tag) + sizeof(len) > m_buffer.size()) return false;
+
+  memcpy(&tag, &m_buffer[m_pos], sizeof(tag));
+  m_pos += sizeof(tag);
+  memcpy(&len, &m_buffer[m_pos], sizeof(len));
+  m_pos += sizeof(len);
+
+  if (m_pos + len > m_buffer.size()) {
+    m_error = true;
+    return false;
+  }
+  m_section_end = m_pos + len;
+
+  return true;
+}
+
+cString cCheckpointReader::ReadString()
+{
+  const int len = ReadInt();
+  if (len <= 0 || m_error || m_pos + len > m_section_end) {
+    if (len != 0) m_error = true;
+    return cString("");
+  }
+  cString str(&m_buffer[m_pos], len);
+  m_pos += len;
+  return str;
+}
+
+void cCheckpointReader::ReadIntArray(Apto::Array<int>& arr)
+{
+  const int size = ReadInt();
+  if (size < 0 || m_error) {
+    m_error = true;
+    return;
+  }
+  arr.ResizeClear(size);
+  for (int i = 0; i < size; i++) arr[i] = ReadInt();
+}
+
+void cCheckpointReader::ReadDoubleArray(Apto::Array<double>& arr)
+{
+  const int size = ReadInt();
+  if (size < 0 || m_error) {
+    m_error = true;
+    return;
+  }
+  arr.ResizeClear(size);
+  for (int i = 0; i < size; i++) arr[i] = ReadDouble();
+}
+
+
+
+void cCheckpointFlushThread::Run()
+{
+  m_success = m_writer->WriteToFile(m_filename);
+}
@@ -0,0 +1,159 @@
+/*
+ *  cCheckpoint.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cCheckpoint_h
+#define cCheckpoint_h
+
+#include "avida/core/Types.h"
+
+#include "apto/core/Thread.h"
+
+#include "cString.h"
+
+#include <cstring>
+#include <vector>
+
+
+/**
+ * Binary checkpoint container.
+ *
+ * A checkpoint file consists of a fixed header (magic, format version and a byte order marker) followed by a sequence
+ * of tagged sections.  Each section records its tag and payload length, allowing readers to skip sections they do not
+ * understand.  All values are written in native byte order; the byte order marker is used to reject foreign files.
+ **/
+
+const unsigned int CHECKPOINT_FORMAT_VERSION = 3;
+
+// Section tags, stored as four character codes
+#define CHECKPOINT_TAG(a, b, c, d) ((unsigned int)(a) << 24 | (unsigned int)(b) << 16 | (unsigned int)(c) << 8 | (unsigned int)(d))
+
+const unsigned int CHECKPOINT_SECTION_HEADER = CHECKPOINT_TAG('H', 'E', 'A', 'D');
+const unsigned int CHECKPOINT_SECTION_STATS = CHECKPOINT_TAG('S', 'T', 'A', 'T');
+const unsigned int CHECKPOINT_SECTION_RESOURCES = CHECKPOINT_TAG('R', 'S', 'R', 'C');
+const unsigned int CHECKPOINT_SECTION_CELLS = CHECKPOINT_TAG('C', 'E', 'L', 'L');
+const unsigned int CHECKPOINT_SECTION_GENOTYPES = CHECKPOINT_TAG('G', 'E', 'N', 'O');
+const unsigned int CHECKPOINT_SECTION_ORGANISMS = CHECKPOINT_TAG('O', 'R', 'G', 'S');
+const unsigned int CHECKPOINT_SECTION_EVENTS = CHECKPOINT_TAG('E', 'V', 'N', 'T');
+
+
+class cCheckpointWriter
+{
+private:
+  std::vector<char> m_buffer;
+  size_t m_section_start;
+
+  inline void writeRaw(const void* data, size_t len);
+
+  cCheckpointWriter(const cCheckpointWriter&); // @not_implemented
+  cCheckpointWriter& operator=(const cCheckpointWriter&); // @not_implemented
+
+public:
+  cCheckpointWriter();
+
+  void BeginSection(unsigned int tag);
+  void EndSection();
+
+  inline void WriteInt(int value) { writeRaw(&value, sizeof(value)); }
+  inline void WriteUInt(unsigned int value) { writeRaw(&value, sizeof(value)); }
+  inline void WriteDouble(double value) { writeRaw(&value, sizeof(value)); }
+  inline void WriteBool(bool value) { unsigned char b = value; writeRaw(&b, sizeof(b)); }
+  inline void WriteByte(unsigned char value) { writeRaw(&value, sizeof(value)); }
+  void WriteString(const char* str);
+  void WriteIntArray(const Apto::Array<int>& arr);
+  void WriteDoubleArray(const Apto::Array<double>& arr);
+
+  inline size_t GetSize() const { return m_buffer.size(); }
+
+  bool WriteToFile(const cString& filename) const;
+};
+
+
+class cCheckpointReader
+{
+private:
+  std::vector<char> m_buffer;
+  size_t m_pos;
+  size_t m_section_end;
+  bool m_error;
+
+  inline bool readRaw(void* data, size_t len);
+
+  cCheckpointReader(const cCheckpointReader&); // @not_implemented
+  cCheckpointReader& operator=(const cCheckpointReader&); // @not_implemented
+
+public:
+  cCheckpointReader() : m_pos(0), m_section_end(0), m_error(false) { ; }
+
+  bool Open(const cString& filename);
+
+  // Advance to the next section, skipping any unread portion of the current one. Returns false at end of file.
+  bool NextSection(unsigned int& tag);
+
+  inline int ReadInt() { int v = 0; readRaw(&v, sizeof(v)); return v; }
+  inline unsigned int ReadUInt() { unsigned int v = 0; readRaw(&v, sizeof(v)); return v; }
+  inline double ReadDouble() { double v = 0.0; readRaw(&v, sizeof(v)); return v; }
+  inline bool ReadBool() { unsigned char b = 0; readRaw(&b, sizeof(b)); return b; }
+  inline unsigned char ReadByte() { unsigned char b = 0; readRaw(&b, sizeof(b)); return b; }
+  cString ReadString();
+  void ReadIntArray(Apto::Array<int>& arr);
+  void ReadDoubleArray(Apto::Array<double>& arr);
+
+  inline bool Good() const { return !m_error; }
+};
+
+
+// Writes a completed checkpoint buffer to disk on a background thread
+class cCheckpointFlushThread : public Apto::Thread
+{
+private:
+  cCheckpointWriter* m_writer;
+  cString m_filename;
+  volatile bool m_success;
+
+  void Run();
+
+public:
+  cCheckpointFlushThread(cCheckpointWriter* writer, const cString& filename)
+    : m_writer(writer), m_filename(filename), m_success(false) { ; }
+  ~cCheckpointFlushThread() { delete m_writer; }
+
+  bool WasSuccessful() const { return m_success; }
+  const cString& GetFilename() const { return m_filename; }
+};
+
+
+inline void cCheckpointWriter::writeRaw(const void* data, size_t len)
+{
+  const char* bytes = static_cast<const char*>(data);
+  m_buffer.insert(m_buffer.end(), bytes, bytes + len);
+}
+
+inline bool cCheckpointReader::readRaw(void* data, size_t len)
+{
+  if (m_error || m_pos + len > m_section_end) {
+    m_error = true;
+    return false;
+  }
+  memcpy(data, &m_buffer[m_pos], len);
+  m_pos += len;
+  return true;
+}
+
+#endif
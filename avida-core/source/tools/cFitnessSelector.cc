@@ -0,0 +1,169 @@
+/*
+ *  cFitnessSelector.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cFitnessSelector.h"
+
+#include "apto/rng.h"
+
+
+void cFitnessSelector::SetWeights(const double* weights, int num_weights)
+{
+  item_weight.Resize(num_weights);
+  cum_weight.Resize(num_weights);
+
+  double running_total = 0.0;
+  for (int i = 0; i < num_weights; i++) {
+    item_weight[i] = weights[i];
+    running_total += weights[i];
+    cum_weight[i] = running_total;
+  }
+
+  alias_valid = false;
+}
+
+
+int cFitnessSelector::FindPosition(double position) const
+{
+  // Binary search for the first running total strictly greater than position
+  int lo = 0;
+  int hi = cum_weight.GetSize();
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (position < cum_weight[mid]) hi = mid;
+    else lo = mid + 1;
+  }
+  return (lo < cum_weight.GetSize()) ? lo : -1;
+}
+
+
+int cFitnessSelector::FindPositionInclusive(double position) const
+{
+  // Binary search for the first running total greater than or equal to position
+  int lo = 0;
+  int hi = cum_weight.GetSize();
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (cum_weight[mid] >= position) hi = mid;
+    else lo = mid + 1;
+  }
+  return (lo < cum_weight.GetSize()) ? lo : -1;
+}
+
+
+void cFitnessSelector::BuildAliasTable()
+{
+  // Vose's alias method: split every index's share of the total into a column of height one, topping up the short
+  // columns from the tall ones
+  const int num_items = item_weight.GetSize();
+  alias_prob.Resize(num_items);
+  alias_index.Resize(num_items);
+
+  const double total = GetTotalWeight();
+  Apto::Array<double> scaled(num_items);
+  Apto::Array<int> small_items(num_items);
+  Apto::Array<int> large_items(num_items);
+  int num_small = 0;
+  int num_large = 0;
+  for (int i = 0; i < num_items; i++) {
+    scaled[i] = (total > 0.0) ? item_weight[i] * num_items / total : 0.0;
+    if (scaled[i] < 1.0) small_items[num_small++] = i;
+    else large_items[num_large++] = i;
+  }
+
+  while (num_small && num_large) {
+    const int small_id = small_items[--num_small];
+    const int large_id = large_items[num_large - 1];
+    alias_prob[small_id] = scaled[small_id];
+    alias_index[small_id] = large_id;
+
+    scaled[large_id] = (scaled[large_id] + scaled[small_id]) - 1.0;
+    if (scaled[large_id] < 1.0) {
+      num_large--;
+      small_items[num_small++] = large_id;
+    }
+  }
+
+  // Whatever remains is a full column, up to rounding
+  while (num_large) {
+    const int id = large_items[--num_large];
+    alias_prob[id] = 1.0;
+    alias_index[id] = id;
+  }
+  while (num_small) {
+    const int id = small_items[--num_small];
+    alias_prob[id] = 1.0;
+    alias_index[id] = id;
+  }
+
+  alias_valid = true;
+}
+
+
+int cFitnessSelector::SelectAlias(Apto::Random& rng)
+{
+  const int num_items = item_weight.GetSize();
+  if (num_items == 0) return -1;
+  if (!alias_valid) BuildAliasTable();
+
+  // One draw picks both the column (integer part) and the height within it (fractional part)
+  const double draw = rng.GetDouble(num_items);
+  int column = (int)draw;
+  if (column >= num_items) column = num_items - 1;
+  return ((draw - column) < alias_prob[column]) ? column : alias_index[column];
+}
+
+
+void cFitnessSelector::SelectUniversal(Apto::Random& rng, int num_picks, Apto::Array<int>& counts) const
+{
+  const int num_items = cum_weight.GetSize();
+  counts.Resize(num_items);
+  counts.SetAll(0);
+  if (num_items == 0 || num_picks <= 0) return;
+
+  const double total = GetTotalWeight();
+  const double spacing = total / num_picks;
+  const double offset = rng.GetDouble(spacing);
+
+  // Walk the running totals once, handing each pointer to the index whose span it falls in
+  int id = 0;
+  for (int pick = 0; pick < num_picks; pick++) {
+    const double pointer = offset + pick * spacing;
+    while (id < num_items - 1 && !(pointer < cum_weight[id])) id++;
+
+    // Rounding can push the last pointer off the end; give it to the last index that has any weight
+    int chosen = id;
+    if (!(pointer < cum_weight[chosen])) while (chosen > 0 && item_weight[chosen] <= 0.0) chosen--;
+    counts[chosen]++;
+  }
+}
+
+
+int cFitnessSelector::SelectTournamentWinner(const int* entrants, int num_entrants, int default_winner) const
+{
+  int winner = default_winner;
+  double winner_weight = 0.0;
+  for (int i = 0; i < num_entrants; i++) {
+    if (item_weight[entrants[i]] > winner_weight) {
+      winner = entrants[i];
+      winner_weight = item_weight[entrants[i]];
+    }
+  }
+  return winner;
+}
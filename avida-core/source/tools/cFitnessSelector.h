@@ -0,0 +1,77 @@
+/*
+ *  cFitnessSelector.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cFitnessSelector_h
+#define cFitnessSelector_h
+
+#include "apto/core.h"
+
+namespace Apto { class Random; };
+
+
+// cFitnessSelector - selection kernels over a fixed set of weights
+//
+//   The companion of cWeightedIndex for weights that are set once per competition rather than adjusted one at a time.
+//   Weights are kept as running totals, accumulated in index order exactly as the linear scans they replace did, so
+//   FindPosition picks the same index those scans would have for the same random draw, in O(log n) instead of O(n).
+//
+//   Also provides an alias table (O(1) per draw after an O(n) build, but consuming random numbers differently from the
+//   running total search), stochastic universal sampling, and the tournament winner rule used by deme competition.
+
+class cFitnessSelector
+{
+protected:
+  Apto::Array<double> item_weight;
+  Apto::Array<double> cum_weight;
+
+  // Alias table, built on demand
+  bool alias_valid;
+  Apto::Array<double> alias_prob;
+  Apto::Array<int> alias_index;
+
+  void BuildAliasTable();
+
+public:
+  cFitnessSelector() : alias_valid(false) { ; }
+  ~cFitnessSelector() { ; }
+
+  void SetWeights(const double* weights, int num_weights);
+
+  double GetWeight(int id) const { return item_weight[id]; }
+  double GetTotalWeight() const { return (cum_weight.GetSize()) ? cum_weight[cum_weight.GetSize() - 1] : 0.0; }
+  int GetSize() const { return item_weight.GetSize(); }
+
+  // First index whose running total exceeds position (the scan `if (position < running_total)`), or -1 if none does
+  int FindPosition(double position) const;
+  // First index whose running total reaches position (the scan `if (running_total >= position)`), or -1 if none does
+  int FindPositionInclusive(double position) const;
+
+  // Fitness proportional draw from the alias table (one random number per draw)
+  int SelectAlias(Apto::Random& rng);
+
+  // Stochastic universal sampling: num_picks evenly spaced pointers from a single random offset; counts[i] receives
+  // the number of pointers landing on index i
+  void SelectUniversal(Apto::Random& rng, int num_picks, Apto::Array<int>& counts) const;
+
+  // Tournament winner: the entrant with the highest positive weight, or the given default when none is positive
+  int SelectTournamentWinner(const int* entrants, int num_entrants, int default_winner) const;
+};
+
+#endif
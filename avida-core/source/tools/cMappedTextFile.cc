@@ -0,0 +1,379 @@
+/*
+ *  cMappedTextFile.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cMappedTextFile.h"
+
+#include "avida/util/ThreadPool.h"
+
+#include "apto/core/FileSystem.h"
+#include "apto/platform.h"
+
+#include "cInitFile.h"
+
+#include <cstring>
+#include <fstream>
+
+#if !APTO_PLATFORM(WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+using namespace std;
+
+
+namespace {
+  // Files smaller than this are indexed in a single chunk
+  const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+  inline bool isWhitespace(char c) { return (c == ' ' || c == '\t' || c == '\r' || c == '\n'); }
+};
+
+
+// One byte range of the file, always starting at the beginning of a line, indexed independently of the others
+class cMappedTextFile::cIndexChunk
+{
+public:
+  size_t begin;
+  size_t end;
+
+  Apto::Array<size_t> line_begin;
+  Apto::Array<int> line_size;
+
+  Apto::Array<size_t> directive_begin;
+  Apto::Array<int> directive_size;
+  Apto::Array<int> directive_line;   // line number within the chunk
+
+  int num_raw_lines;
+  bool continued;                    // some line uses a continuation mark
+
+  cIndexChunk(size_t in_begin, size_t in_end) : begin(in_begin), end(in_end), num_raw_lines(0), continued(false) { ; }
+
+  void Index(const char* data);
+};
+
+
+void cMappedTextFile::cIndexChunk::Index(const char* data)
+{
+  size_t pos = begin;
+  while (pos < end) {
+    const char* nl = (const char*)memchr(data + pos, '\n', end - pos);
+    const size_t line_end = (nl) ? (size_t)(nl - data) : end;
+    num_raw_lines++;
+
+    if (data[pos] == '#') {
+      // Directive, handled once all chunks are done so that they are seen in file order
+      directive_begin.Push(pos);
+      directive_size.Push((int)(line_end - pos));
+      directive_line.Push(num_raw_lines);
+    } else {
+      // Clip comments, then trim whitespace from both ends
+      const char* comment = (const char*)memchr(data + pos, '#', line_end - pos);
+      size_t content_begin = pos;
+      size_t content_end = (comment) ? (size_t)(comment - data) : line_end;
+      while (content_begin < content_end && isWhitespace(data[content_begin])) content_begin++;
+      while (content_end > content_begin && isWhitespace(data[content_end - 1])) content_end--;
+
+      if (content_end > content_begin) {
+        if (data[content_end - 1] == '\\') continued = true;
+        line_begin.Push(content_begin);
+        line_size.Push((int)(content_end - content_begin));
+      }
+    }
+
+    pos = line_end + 1;
+  }
+}
+
+
+class cMappedTextFile::cIndexJob : public Avida::Util::ThreadPool::Job
+{
+private:
+  const char* m_data;
+  Apto::Array<cIndexChunk*>& m_chunks;
+
+public:
+  cIndexJob(const char* data, Apto::Array<cIndexChunk*>& chunks) : m_data(data), m_chunks(chunks) { ; }
+
+  void Execute(int idx) { m_chunks[idx]->Index(m_data); }
+};
+
+
+cMappedTextFile::cMappedTextFile(const cString& filename, const cString& working_dir, int num_threads)
+  : m_filename(filename), m_opened(false), m_data(NULL), m_size(0), m_mapping(NULL), m_ftype("unknown")
+{
+  cString path = cString(Apto::FileSystem::GetAbsolutePath(Apto::String(filename), Apto::String(working_dir)));
+  if (!mapFile(path)) {
+    m_feedback.Error("unable to open file '%s'.", (const char*)filename);
+    return;
+  }
+
+  m_opened = true;
+  if (!indexLines(num_threads)) {
+    // The file needs cInitFile's line rewriting; drop the mapping and take the lines it produces
+    unmapFile();
+    m_line_begin.Resize(0);
+    m_line_size.Resize(0);
+    m_ftype = "unknown";
+    m_format.Clear();
+    loadThroughInitFile(filename, working_dir);
+  }
+}
+
+
+cMappedTextFile::~cMappedTextFile()
+{
+  unmapFile();
+}
+
+
+bool cMappedTextFile::mapFile(const cString& path)
+{
+#if !APTO_PLATFORM(WINDOWS)
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+
+  m_size = (size_t)st.st_size;
+  if (m_size > 0) {
+    void* mapping = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      m_mapping = mapping;
+      m_data = (const char*)mapping;
+#ifdef MADV_SEQUENTIAL
+      madvise(mapping, m_size, MADV_SEQUENTIAL);
+#endif
+    }
+  }
+  close(fd);
+
+  if (m_mapping || m_size == 0) return true;
+#endif
+
+  // No mapping available, read the whole file instead
+  ifstream fp(path, ios::in | ios::binary);
+  if (!fp.good()) return false;
+  fp.seekg(0, ios::end);
+  m_size = (size_t)fp.tellg();
+  fp.seekg(0, ios::beg);
+  m_buffer.Resize((int)m_size + 1);
+  if (m_size && !fp.read(&m_buffer[0], m_size)) return false;
+  m_data = &m_buffer[0];
+  return true;
+}
+
+
+void cMappedTextFile::unmapFile()
+{
+#if !APTO_PLATFORM(WINDOWS)
+  if (m_mapping) munmap(m_mapping, m_size);
+#endif
+  m_mapping = NULL;
+  m_data = NULL;
+  m_size = 0;
+  m_buffer.Resize(0);
+}
+
+
+bool cMappedTextFile::indexLines(int num_threads)
+{
+  if (m_size == 0) return true;
+
+  Avida::Util::ThreadPool pool(num_threads);
+
+  // Split the file into roughly even byte ranges, each pushed forward to start a line
+  int num_chunks = (int)Apto::Min<size_t>(m_size / MIN_CHUNK_SIZE + 1, (size_t)pool.NumThreads() * 4);
+  Apto::Array<cIndexChunk*> chunks;
+  size_t chunk_begin = 0;
+  for (int i = 1; i <= num_chunks && chunk_begin < m_size; i++) {
+    size_t chunk_end = (i == num_chunks) ? m_size : (m_size / num_chunks) * i;
+    if (chunk_end < chunk_begin) chunk_end = chunk_begin;
+    if (chunk_end < m_size) {
+      const char* nl = (const char*)memchr(m_data + chunk_end, '\n', m_size - chunk_end);
+      chunk_end = (nl) ? (size_t)(nl - m_data) + 1 : m_size;
+    }
+    if (chunk_end > chunk_begin) chunks.Push(new cIndexChunk(chunk_begin, chunk_end));
+    chunk_begin = chunk_end;
+  }
+
+  cIndexJob job(m_data, chunks);
+  pool.Execute(job, chunks.GetSize());
+
+  // Stitch the chunks together in file order, handling directives as they come
+  bool fallback = false;
+  int num_lines = 0;
+  for (int i = 0; i < chunks.GetSize(); i++) num_lines += chunks[i]->line_begin.GetSize();
+  m_line_begin.Resize(num_lines);
+  m_line_size.Resize(num_lines);
+
+  int line_id = 0;
+  int raw_line_base = 0;
+  bool ok = true;
+  for (int i = 0; i < chunks.GetSize() && ok && !fallback; i++) {
+    cIndexChunk& chunk = *chunks[i];
+    if (chunk.continued) fallback = true;
+
+    for (int d = 0; d < chunk.directive_begin.GetSize() && ok && !fallback; d++) {
+      cString directive(m_data + chunk.directive_begin[d], chunk.directive_size[d]);
+      ok = processDirective(directive, raw_line_base + chunk.directive_line[d], fallback);
+    }
+
+    for (int l = 0; l < chunk.line_begin.GetSize(); l++, line_id++) {
+      m_line_begin[line_id] = chunk.line_begin[l];
+      m_line_size[line_id] = chunk.line_size[l];
+    }
+    raw_line_base += chunk.num_raw_lines;
+  }
+
+  for (int i = 0; i < chunks.GetSize(); i++) delete chunks[i];
+
+  if (!ok) {
+    m_opened = false;
+    m_line_begin.Resize(0);
+    m_line_size.Resize(0);
+  }
+
+  return !fallback;
+}
+
+
+// Mirrors cInitFile::processCommand for the directives that do not change the file's content
+bool cMappedTextFile::processDirective(const cString& line, int line_num, bool& fallback)
+{
+  cString cmdstr(line);
+  cString cmd = cmdstr.PopWord();
+
+  if (cmd == "#include" || cmd == "#import" || cmd == "#define") {
+    fallback = true;
+  } else if (cmd == "#filetype") {
+    cString ft = cmdstr.PopWord();
+    if (m_ftype != "unknown" && m_ftype != ft) {
+      m_feedback.Error("%s:%d: duplicate filetype directive", (const char*)m_filename, line_num);
+      return false;
+    }
+    m_ftype = ft;
+  } else if (cmd == "#format") {
+    if (m_format.GetSize() != 0) {
+      m_feedback.Error("%s:%d: duplicate format directive", (const char*)m_filename, line_num);
+      return false;
+    }
+    m_format.Load(cmdstr);
+  }
+
+  return true;
+}
+
+
+void cMappedTextFile::loadThroughInitFile(const cString& filename, const cString& working_dir)
+{
+  cInitFile input_file(filename, working_dir);
+
+  const cUserFeedback& feedback = input_file.GetFeedback();
+  for (int i = 0; i < feedback.GetNumMessages(); i++) {
+    switch (feedback.GetMessageType(i)) {
+      case cUserFeedback::UF_ERROR:    m_feedback.Error("%s", (const char*)feedback.GetMessage(i)); break;
+      case cUserFeedback::UF_WARNING:  m_feedback.Warning("%s", (const char*)feedback.GetMessage(i)); break;
+      default:                         m_feedback.Notify("%s", (const char*)feedback.GetMessage(i)); break;
+    }
+  }
+
+  m_opened = input_file.WasOpened();
+  m_ftype = input_file.GetFiletype();
+  m_format = input_file.GetFormat();
+
+  // Pack the processed lines into the private buffer, one after the other
+  const int num_lines = input_file.GetNumLines();
+  size_t total_size = 0;
+  for (int i = 0; i < num_lines; i++) total_size += input_file.GetLine(i).GetSize() + 1;
+
+  m_buffer.Resize((int)total_size + 1);
+  m_line_begin.Resize(num_lines);
+  m_line_size.Resize(num_lines);
+  size_t pos = 0;
+  for (int i = 0; i < num_lines; i++) {
+    cString line = input_file.GetLine(i);
+    memcpy(&m_buffer[pos], (const char*)line, line.GetSize());
+    m_line_begin[i] = pos;
+    m_line_size[i] = line.GetSize();
+    pos += line.GetSize();
+    m_buffer[pos++] = '\n';
+  }
+  m_data = &m_buffer[0];
+  m_size = total_size;
+}
+
+
+cString cMappedTextFile::GetLine(int line_num) const
+{
+  if (line_num < 0 || line_num >= m_line_begin.GetSize()) return "";
+
+  // Same text cInitFile would hold for the line
+  cString line(m_data + m_line_begin[line_num], m_line_size[line_num]);
+  line.CompressWhitespace();
+  return line;
+}
+
+
+int cMappedTextFile::GetFields(int line_num, sField* fields, int max_fields) const
+{
+  if (line_num < 0 || line_num >= m_line_begin.GetSize()) return 0;
+
+  const char* pos = m_data + m_line_begin[line_num];
+  const char* end = pos + m_line_size[line_num];
+  int num_fields = 0;
+  while (pos < end && num_fields < max_fields) {
+    while (pos < end && isWhitespace(*pos)) pos++;
+    if (pos == end) break;
+
+    const char* field_begin = pos;
+    while (pos < end && !isWhitespace(*pos)) pos++;
+    fields[num_fields].begin = field_begin;
+    fields[num_fields].size = (int)(pos - field_begin);
+    num_fields++;
+  }
+
+  return num_fields;
+}
+
+
+Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > cMappedTextFile::GetLineAsDict(int line_num) const
+{
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > dict(new Apto::Map<Apto::String, Apto::String>);
+
+  const int num_columns = m_format.GetSize();
+  if (num_columns == 0) return dict;
+
+  Apto::Array<sField> fields(num_columns);
+  const int num_fields = GetFields(line_num, &fields[0], num_columns);
+
+  tConstListIterator<cString> fmt_it(m_format.GetList());
+  for (int i = 0; i < num_fields; i++) {
+    const cString* column = fmt_it.Next();
+    dict->Set((const char*)*column, (const char*)cString(fields[i].begin, fields[i].size));
+  }
+
+  return dict;
+}
@@ -0,0 +1,99 @@
+/*
+ *  cMappedTextFile.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cMappedTextFile_h
+#define cMappedTextFile_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+#include "cStringList.h"
+#include "cUserFeedback.h"
+
+
+// cMappedTextFile - read-only, zero-copy view of a data file (detail dumps, population saves)
+//
+//   The file is memory mapped and indexed in parallel chunks.  Each line is kept as a range into the mapping, already
+//   stripped of comments and surrounding whitespace, and split into fields on demand without copying.  Lines read back
+//   the same as through cInitFile (#filetype and #format are honored, blank and comment lines skipped).  Files that use
+//   the directives that rewrite their content (#include, #import, #define) or line continuations are handed to
+//   cInitFile instead, and its lines are served from a private buffer.
+
+class cMappedTextFile
+{
+public:
+  struct sField
+  {
+    const char* begin;    // not null terminated
+    int size;
+  };
+
+private:
+  class cIndexChunk;
+  class cIndexJob;
+
+  cString m_filename;
+  bool m_opened;
+  cUserFeedback m_feedback;
+
+  const char* m_data;
+  size_t m_size;
+  void* m_mapping;              // non-null if m_data is a memory mapping
+  Apto::Array<char> m_buffer;   // file contents when they could not be mapped (or came through cInitFile)
+
+  Apto::Array<size_t> m_line_begin;
+  Apto::Array<int> m_line_size;
+
+  cString m_ftype;
+  cStringList m_format;
+
+
+  bool mapFile(const cString& path);
+  void unmapFile();
+  bool indexLines(int num_threads);
+  bool processDirective(const cString& line, int line_num, bool& fallback);
+  void loadThroughInitFile(const cString& filename, const cString& working_dir);
+
+  cMappedTextFile(const cMappedTextFile&); // @not_implemented
+  cMappedTextFile& operator=(const cMappedTextFile&); // @not_implemented
+
+public:
+  // num_threads includes the calling thread; zero or less uses all available CPUs
+  cMappedTextFile(const cString& filename, const cString& working_dir, int num_threads = 1);
+  ~cMappedTextFile();
+
+  bool WasOpened() const { return m_opened; }
+  const cUserFeedback& GetFeedback() const { return m_feedback; }
+
+  const cString& GetFiletype() const { return m_ftype; }
+  const cStringList& GetFormat() const { return m_format; }
+
+  int GetNumLines() const { return m_line_begin.GetSize(); }
+  cString GetLine(int line_num) const;
+
+  // Split a line on whitespace into at most max_fields fields, returning the number found.  Safe to call from any
+  // number of threads at once.
+  int GetFields(int line_num, sField* fields, int max_fields) const;
+
+  // Pair the #format column names with the line's fields, as cInitFile::GetLineAsDict does
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > GetLineAsDict(int line_num) const;
+};
+
+#endif
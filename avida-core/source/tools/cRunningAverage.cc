@@ -22,6 +22,8 @@
 
 #include "cRunningAverage.h"
 
+#include "cCheckpoint.h"
+
 #include <cassert>
 
 
@@ -61,3 +63,30 @@ void cRunningAverage::Clear() {
   m_pointer = 0;
   m_n = 0;
 }
+
+
+void cRunningAverage::SaveState(cCheckpointWriter& ckp) const
+{
+  ckp.WriteInt(m_window_size);
+  ckp.WriteInt(m_pointer);
+  ckp.WriteInt(m_n);
+  ckp.WriteDouble(m_s1);
+  ckp.WriteDouble(m_s2);
+  for (int i = 0; i < m_n; i++) ckp.WriteDouble(m_values[i]);
+}
+
+
+bool cRunningAverage::LoadState(cCheckpointReader& ckp)
+{
+  if (ckp.ReadInt() != m_window_size) return false;
+  const int pointer = ckp.ReadInt();
+  const int n = ckp.ReadInt();
+  if (n < 0 || n > m_window_size || pointer < 0 || pointer >= m_window_size) return false;
+  
+  m_pointer = pointer;
+  m_n = n;
+  m_s1 = ckp.ReadDouble();
+  m_s2 = ckp.ReadDouble();
+  for (int i = 0; i < m_n; i++) m_values[i] = ckp.ReadDouble();
+  return ckp.Good();
+}
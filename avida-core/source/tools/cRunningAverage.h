@@ -25,6 +25,9 @@
 
 #include <cmath>
 
+class cCheckpointReader;
+class cCheckpointWriter;
+
 class cRunningAverage
 {
 private:
@@ -49,6 +52,10 @@ public:
   void Add(double value);
   void Clear();
   
+  // Checkpointing; the window size is fixed at construction and must match
+  void SaveState(cCheckpointWriter& ckp) const;
+  bool LoadState(cCheckpointReader& ckp);
+  
   
   //accessors
   double Sum()          const { return m_s1; }
@@ -25,6 +25,8 @@
 #include "cString.h"
 #include "cStringList.h"
 
+#include <cstring>
+
 
 const cString cStringIterator::null_str("");
 
@@ -33,3 +35,29 @@ cStringIterator::cStringIterator(const cStringList & in_list)
 {
   Reset();
 }
+
+
+cString cStringTokenizer::Next()
+{
+  const int size = m_str.GetSize();
+  if (m_pos >= size) return "";
+  
+  const char* data = m_str;
+  if (m_delim == '\0') {
+    // Skip to the word, take it, then step over the whitespace that follows it
+    int start = m_pos;
+    while (start < size && m_str.IsWhitespace(start)) start++;
+    int end = start;
+    while (end < size && !m_str.IsWhitespace(end)) end++;
+    m_pos = end;
+    while (m_pos < size && m_str.IsWhitespace(m_pos)) m_pos++;
+    return cString(data + start, end - start);
+  }
+  
+  // Up to the next delimiter, or everything that is left if there is none
+  const char* found = (const char*)memchr(data + m_pos, m_delim, size - m_pos);
+  const int end = (found) ? (int)(found - data) : size;
+  cString token(data + m_pos, end - m_pos);
+  m_pos = (found) ? end + 1 : size;
+  return token;
+}
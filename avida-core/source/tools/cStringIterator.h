@@ -58,4 +58,36 @@ public:
   bool AtEnd() const { return list_it.AtEnd(); }
 };
 
+
+// cStringTokenizer - steps through the tokens of a string without modifying it
+//
+//   Next() returns the same sequence of tokens that repeated PopWord() calls (or Pop(delim) calls, when a delimiter is
+//   given) would remove from the string, stopping when the string would be empty.  Each token costs time in its own
+//   length, rather than the copy of the whole remaining string that every Pop makes.
+
+class cStringTokenizer
+{
+private:
+  cString m_str;
+  char m_delim;     // '\0' splits on whitespace, as PopWord
+  int m_pos;
+  
+  
+  cStringTokenizer(); // @not_implemented
+  cStringTokenizer(const cStringTokenizer&); // @not_implemented
+  cStringTokenizer& operator=(const cStringTokenizer&); // @not_implemented
+  
+public:
+  explicit cStringTokenizer(const cString& str, char delim = '\0') : m_str(str), m_delim(delim), m_pos(0) { ; }
+
+  void Reset() { m_pos = 0; }
+  bool AtEnd() const { return m_pos >= m_str.GetSize(); }
+  
+  // Returns an empty string once AtEnd(), as popping an empty string does
+  cString Next();
+  
+  // What the popped string would still hold at this point
+  cString GetRemainder() const { return (AtEnd()) ? cString("") : m_str.Substring(m_pos, m_str.GetSize() - m_pos); }
+};
+
 #endif
@@ -59,6 +59,13 @@ cStringList & cStringList::operator=(const cStringList & _list)
   return *this;
 }
 
+
+void cStringList::Load(const cString& _list, char seperator)
+{
+  cStringTokenizer tokens(_list, seperator);
+  while (!tokens.AtEnd()) PushRear(tokens.Next());
+}
+
 bool cStringList::HasString(const cString & test_string) const
 {
   tConstListIterator<cString> string_it(string_list);
@@ -65,7 +65,7 @@ public:
   cString Pop() { return ReturnString(string_list.Pop()); }
   cString PopRear() { return ReturnString(string_list.PopRear()); }
 
-  void Load(cString _list, char seperator=' ') { while (_list.GetSize() > 0) PushRear(_list.Pop(seperator)); }
+  void Load(const cString& _list, char seperator=' ');
   void Clear() { while (string_list.GetSize() > 0) delete string_list.Pop(); }
 };
 
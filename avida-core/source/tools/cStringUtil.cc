@@ -22,6 +22,8 @@
 
 #include "cStringUtil.h"
 
+#include "cStringIterator.h"
+
 #include "tMatrix.h"
 
 #include "AvidaTools.h"
@@ -325,8 +327,9 @@ cString cStringUtil::Convert(double in_double)
 Apto::Array<int> cStringUtil::ReturnArray(cString& in_string)
 {
   Apto::Array<int> out_list;
-  while (in_string.GetSize() != 0) {
-    cString chunk = in_string.Pop(',');
+  cStringTokenizer chunks(in_string, ',');
+  while (!chunks.AtEnd()) {
+    cString chunk = chunks.Next();
 
     /* if the string has a .. in it find the two numbers on either side of it */
 
@@ -341,6 +344,7 @@ Apto::Array<int> cStringUtil::ReturnArray(cString& in_string)
       out_list.Push(chunk.AsInt());
     }
   }
+  in_string = "";
   return(out_list);
 }
 
@@ -77,6 +77,18 @@ public:
     return data[index];
   }
 
+  // Raw state access, used when checkpointing hardware and organism buffers
+  const Apto::Array<T>& GetRawData() const { return data; }
+  int GetOffset() const { return offset; }
+  int GetLastTotal() const { return last_total; }
+  void SetRawState(const Apto::Array<T>& in_data, int in_offset, int in_total, int in_last_total)
+  {
+    data = in_data;
+    offset = in_offset;
+    total = in_total;
+    last_total = in_last_total;
+  }
+
   int GetCapacity() const { return data.GetSize(); }
   int GetTotal() const { return total; }
   int GetNumStored() const { return (total <= data.GetSize()) ? total : data.GetSize(); }
@@ -0,0 +1,129 @@
+/*
+ *  util/ThreadPool.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/util/ThreadPool.h"
+
+
+class Avida::Util::ThreadPool::Worker : public Apto::Thread
+{
+private:
+  ThreadPool* m_pool;
+  
+  void Run() { m_pool->workerLoop(); }
+  
+public:
+  Worker(ThreadPool* pool) : m_pool(pool) { ; }
+};
+
+
+Avida::Util::ThreadPool::ThreadPool(int num_threads)
+  : m_job(NULL), m_count(0), m_next(0), m_completed(0), m_shutdown(false)
+{
+  if (num_threads <= 0) num_threads = Apto::Platform::AvailableCPUs();
+  
+  // The calling thread always participates, so only num_threads - 1 workers are needed
+  if (num_threads > 1) {
+    m_workers.Resize(num_threads - 1);
+    for (int i = 0; i < m_workers.GetSize(); i++) {
+      m_workers[i] = new Worker(this);
+      m_workers[i]->Start();
+    }
+  }
+}
+
+Avida::Util::ThreadPool::~ThreadPool()
+{
+  m_mutex.Lock();
+  m_shutdown = true;
+  m_mutex.Unlock();
+  m_work_cond.Broadcast();
+  
+  for (int i = 0; i < m_workers.GetSize(); i++) {
+    m_workers[i]->Join();
+    delete m_workers[i];
+  }
+}
+
+
+void Avida::Util::ThreadPool::Execute(Job& job, int count)
+{
+  if (count <= 0) return;
+  
+  if (m_workers.GetSize() == 0 || count == 1) {
+    for (int i = 0; i < count; i++) job.Execute(i);
+    return;
+  }
+  
+  // Index 0 is reserved for the calling thread, the rest are claimed by whichever thread is free
+  m_mutex.Lock();
+  m_job = &job;
+  m_count = count;
+  m_next = 1;
+  m_completed = 0;
+  m_mutex.Unlock();
+  m_work_cond.Broadcast();
+  
+  job.Execute(0);
+  m_mutex.Lock();
+  m_completed++;
+  m_mutex.Unlock();
+  
+  while (executeNext()) ;
+  
+  m_mutex.Lock();
+  while (m_completed < m_count) m_done_cond.Wait(m_mutex);
+  m_job = NULL;
+  m_mutex.Unlock();
+}
+
+
+void Avida::Util::ThreadPool::workerLoop()
+{
+  while (true) {
+    m_mutex.Lock();
+    while (!m_shutdown && (!m_job || m_next >= m_count)) m_work_cond.Wait(m_mutex);
+    const bool shutdown = m_shutdown;
+    m_mutex.Unlock();
+    
+    if (shutdown) break;
+    while (executeNext()) ;
+  }
+}
+
+
+bool Avida::Util::ThreadPool::executeNext()
+{
+  m_mutex.Lock();
+  if (!m_job || m_next >= m_count) {
+    m_mutex.Unlock();
+    return false;
+  }
+  Job* job = m_job;
+  const int idx = m_next++;
+  m_mutex.Unlock();
+  
+  job->Execute(idx);
+  
+  m_mutex.Lock();
+  if (++m_completed == m_count) m_done_cond.Broadcast();
+  m_mutex.Unlock();
+  return true;
+}
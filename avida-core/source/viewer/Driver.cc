@@ -27,6 +27,7 @@
 #include "avida/data/Manager.h"
 #include "avida/environment/ActionTrigger.h"
 #include "avida/environment/Manager.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Manager.h"
 #include "avida/viewer/Map.h"
 #include "avida/viewer/Listener.h"
@@ -464,6 +465,7 @@ void Avida::Viewer::Driver::Run()
   } catch (Avida::AbortCondition condition) {
     cerr << "abort: " << condition << endl;
   }
+  Output::Manager::Of(m_new_world)->FlushAll();
   m_callback(THREAD_END);
 }
 